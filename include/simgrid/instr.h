@@ -65,6 +65,8 @@ XBT_PUBLIC const std::set<std::string, std::less<>>& get_tracing_categories();
 XBT_PUBLIC void platform_graph_export_graphviz(const std::string& output_filename);
 /* Function used by graphicator (transform a SimGrid platform file in a CSV file with the network topology) */
 XBT_PUBLIC void platform_graph_export_csv(const std::string& output_filename);
+/* Function used by trace_to_paje (convert a trace written with --cfg=tracing/format:Binary into the Paje format) */
+XBT_PUBLIC void convert_binary_trace(const std::string& binary_trace, const std::string& paje_trace);
 } // namespace simgrid::instr
 
 #endif
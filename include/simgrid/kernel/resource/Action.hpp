@@ -246,6 +246,7 @@ public:
    * @param factor Multiplicative factor for this action (e.g. 0.97)
    */
   void set_rate_factor(double factor) { factor_ = factor; }
+  double get_rate_factor() const { return factor_; }
   /**
    * @brief Get the effective consumption rate of the resource
    *
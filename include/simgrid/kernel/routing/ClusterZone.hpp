@@ -234,6 +234,12 @@ public:
 
   /** @brief Set the characteristics of links inside a Cluster zone */
   virtual void set_link_characteristics(double bw, double lat, s4u::Link::SharingPolicy sharing_policy);
+  /** @brief Position of a leaf in the internal hierarchy of the cluster, from the outermost level to the innermost one
+   *
+   * The leaves sharing a prefix of their coordinates are closer to each other (e.g., same group of a Dragonfly). This
+   * is empty for the clusters without internal hierarchy.
+   */
+  virtual std::vector<unsigned long> get_hierarchical_coords(unsigned long /*id*/) const { return {}; }
   unsigned long node_pos_with_loopback_limiter(unsigned long id) const
   {
     return node_pos_with_loopback(id) + (has_limiter_ ? 1 : 0);
@@ -84,6 +84,7 @@ public:
   /** @brief Set the characteristics of links inside the Dragonfly zone */
   void set_link_characteristics(double bw, double lat, s4u::Link::SharingPolicy sharing_policy) override;
   Coords rankId_to_coords(unsigned long rank_id) const;
+  std::vector<unsigned long> get_hierarchical_coords(unsigned long id) const override;
 
 private:
   void generate_routers();
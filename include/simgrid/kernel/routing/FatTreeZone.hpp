@@ -135,6 +135,8 @@ public:
   FatTreeZone(const FatTreeZone&) = delete;
   FatTreeZone& operator=(const FatTreeZone&) = delete;
   void get_local_route(const NetPoint* src, const NetPoint* dst, Route* into, double* latency) override;
+  /** @brief The subtrees containing that leaf, from the children of the top switches to the leaf switch */
+  std::vector<unsigned long> get_hierarchical_coords(unsigned long id) const override;
 
     /** @brief Checks topology parameters */
   static void check_topology(unsigned int n_levels, const std::vector<unsigned int>& down_links,
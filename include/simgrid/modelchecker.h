@@ -19,6 +19,13 @@ XBT_PUBLIC int MC_random(int min, int max);
 /** Assertion for the model-checker: Defines a safety property to verify */
 XBT_PUBLIC void MC_assert(int);
 
+/** Declare a memory area holding a part of the state of the application.
+ *
+ * With --cfg=model-check/visited, the model-checker does not explore again the states where the declared memory areas
+ * and the pending actions of all actors are identical to a previously visited state. The whole state of the application
+ * must be declared for this to be sound. This does nothing when the model-checker is not active. */
+XBT_PUBLIC void MC_declare_state(const void* addr, size_t size);
+
 /** Check whether the model-checker is currently active, ie if this process was started with simgrid-mc.
  *  It is off in simulation or when replaying MC traces (see MC_record_replay_is_active()) */
 XBT_PUBLIC int MC_is_active();
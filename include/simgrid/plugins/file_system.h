@@ -91,6 +91,8 @@ public:
 
   /** Retrieves the path to the file */
   const char* get_path() const { return fullpath_.c_str(); }
+  /** Retrieves the disk storing the file, which may be attached to another host than the one that opened it */
+  const Disk* get_disk() const { return local_disk_; }
 
   /** Simulates a local read action. Returns the size of data actually read */
   sg_size_t read(sg_size_t size);
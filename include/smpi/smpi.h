@@ -766,6 +766,28 @@ MPI_CALL(XBT_PUBLIC int, MPI_Ialltoallv,
 MPI_CALL(XBT_PUBLIC int, MPI_Ialltoallw,
          (const void* sendbuf, const int* sendcounts, const int* senddisps, const MPI_Datatype* sendtypes, void* recvbuf, const int* recvcounts,
           const int* recvdisps, const MPI_Datatype* recvtypes, MPI_Comm comm, MPI_Request *request));
+/* Persistent collectives (MPI-4) */
+MPI_CALL(XBT_PUBLIC int, MPI_Barrier_init, (MPI_Comm comm, MPI_Info info, MPI_Request* request));
+MPI_CALL(XBT_PUBLIC int, MPI_Bcast_init,
+         (void* buf, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Info info, MPI_Request* request));
+MPI_CALL(XBT_PUBLIC int, MPI_Gather_init,
+         (const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount, MPI_Datatype recvtype,
+          int root, MPI_Comm comm, MPI_Info info, MPI_Request* request));
+MPI_CALL(XBT_PUBLIC int, MPI_Scatter_init,
+         (const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount, MPI_Datatype recvtype,
+          int root, MPI_Comm comm, MPI_Info info, MPI_Request* request));
+MPI_CALL(XBT_PUBLIC int, MPI_Allgather_init,
+         (const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount, MPI_Datatype recvtype,
+          MPI_Comm comm, MPI_Info info, MPI_Request* request));
+MPI_CALL(XBT_PUBLIC int, MPI_Alltoall_init,
+         (const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount, MPI_Datatype recvtype,
+          MPI_Comm comm, MPI_Info info, MPI_Request* request));
+MPI_CALL(XBT_PUBLIC int, MPI_Reduce_init,
+         (const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root, MPI_Comm comm,
+          MPI_Info info, MPI_Request* request));
+MPI_CALL(XBT_PUBLIC int, MPI_Allreduce_init,
+         (const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm, MPI_Info info,
+          MPI_Request* request));
 MPI_CALL(XBT_PUBLIC int, MPI_Gather, (const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
                                       MPI_Datatype recvtype, int root, MPI_Comm comm));
 MPI_CALL(XBT_PUBLIC int, MPI_Gatherv, (const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf,
@@ -170,6 +170,14 @@
 #define MPI_Ialltoall(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Ialltoall"), MPI_Ialltoall(__VA_ARGS__))
 #define MPI_Ialltoallv(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Ialltoallv"), MPI_Ialltoallv(__VA_ARGS__))
 #define MPI_Ialltoallw(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Ialltoallw"), MPI_Ialltoallw(__VA_ARGS__))
+#define MPI_Barrier_init(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Barrier_init"), MPI_Barrier_init(__VA_ARGS__))
+#define MPI_Bcast_init(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Bcast_init"), MPI_Bcast_init(__VA_ARGS__))
+#define MPI_Gather_init(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Gather_init"), MPI_Gather_init(__VA_ARGS__))
+#define MPI_Scatter_init(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Scatter_init"), MPI_Scatter_init(__VA_ARGS__))
+#define MPI_Allgather_init(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Allgather_init"), MPI_Allgather_init(__VA_ARGS__))
+#define MPI_Alltoall_init(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Alltoall_init"), MPI_Alltoall_init(__VA_ARGS__))
+#define MPI_Reduce_init(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Reduce_init"), MPI_Reduce_init(__VA_ARGS__))
+#define MPI_Allreduce_init(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Allreduce_init"), MPI_Allreduce_init(__VA_ARGS__))
 #define MPI_Gather(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Gather"), MPI_Gather(__VA_ARGS__))
 #define MPI_Gatherv(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Gatherv"), MPI_Gatherv(__VA_ARGS__))
 #define MPI_Allgather(...) (smpi_trace_set_call_location(__FILE__, __LINE__, "MPI_Allgather"), MPI_Allgather(__VA_ARGS__))
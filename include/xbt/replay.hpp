@@ -14,6 +14,7 @@
 #include <functional>
 #include <queue>
 #include <unordered_map>
+#include <vector>
 
 namespace simgrid::xbt {
 /* To split the file if a unique one is given (specific variable for the other case live in runner()) */
@@ -31,5 +32,6 @@ using action_fun = std::function<void(simgrid::xbt::ReplayAction&)>;
 XBT_PUBLIC void xbt_replay_action_register(const char* action_name, const action_fun& function);
 XBT_PUBLIC action_fun xbt_replay_action_get(const char* action_name);
 XBT_PUBLIC void xbt_replay_set_tracefile(const std::string& filename);
+XBT_PUBLIC void xbt_replay_convert_to_binary(const std::string& text_trace, const std::string& binary_trace);
 
 #endif
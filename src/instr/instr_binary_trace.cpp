@@ -0,0 +1,264 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/instr/instr_binary_trace.hpp"
+#include "src/instr/instr_private.hpp"
+#include <simgrid/Exception.hpp>
+
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(instr_binary_trace, instr, "Binary encoding of the Paje events");
+
+namespace simgrid::instr::binary {
+
+static std::unordered_map<std::string, uint64_t> interned_strings;
+static int64_t last_ticks       = 0;
+static double ticks_per_second = 1e6;
+
+void dump_header(std::ostream& out, int precision, unsigned flags, const std::string& comments)
+{
+  if (precision < 0 || precision > max_precision)
+    throw TracingError(XBT_THROW_POINT, xbt::string_printf("The binary trace format supports a tracing/precision "
+                                                           "between 0 and %d, not %d.",
+                                                           max_precision, precision));
+  interned_strings.clear();
+  last_ticks       = 0;
+  ticks_per_second = std::pow(10.0, precision);
+
+  out.write(magic, sizeof magic);
+  put_unsigned(out, precision);
+  put_unsigned(out, flags);
+  put_unsigned(out, comments.size());
+  out << comments;
+}
+
+void put_unsigned(std::ostream& out, uint64_t value)
+{
+  while (value >= 0x80) {
+    out.put(static_cast<char>(value | 0x80));
+    value >>= 7;
+  }
+  out.put(static_cast<char>(value));
+}
+
+void put_signed(std::ostream& out, int64_t value)
+{
+  put_unsigned(out, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+void put_double(std::ostream& out, double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof bits);
+  for (int i = 0; i < 8; i++)
+    out.put(static_cast<char>(bits >> (8 * i)));
+}
+
+void put_string(std::ostream& out, const std::string& str)
+{
+  if (auto known = interned_strings.find(str); known != interned_strings.end()) {
+    put_unsigned(out, known->second << 1);
+    return;
+  }
+  put_unsigned(out, (static_cast<uint64_t>(str.size()) << 1) | 1);
+  out << str;
+  if (str.size() <= max_intern_size)
+    interned_strings.try_emplace(str, interned_strings.size());
+}
+
+/* Rounds the timestamp to the configured precision, as the decimal printing of the Paje format would do */
+static int64_t to_ticks(double timestamp)
+{
+  auto ticks = std::llround(timestamp * ticks_per_second);
+  // timestamp * ticks_per_second was rounded to a double, so check on the exact product which way it must go
+  double remainder = std::fma(timestamp, ticks_per_second, -static_cast<double>(ticks));
+  if (remainder > 0.5 || (remainder == 0.5 && ticks % 2 != 0))
+    ticks++;
+  else if (remainder < -0.5 || (remainder == -0.5 && ticks % 2 != 0))
+    ticks--;
+  return ticks;
+}
+
+void put_timestamp(std::ostream& out, double timestamp)
+{
+  int64_t ticks = to_ticks(timestamp);
+  put_signed(out, ticks - last_ticks);
+  last_ticks = ticks;
+}
+
+/** Decoder of the binary traces, producing the same text as the Paje callbacks of instr_config.cpp */
+class BinaryTraceReader {
+  std::string filename_;
+  std::ifstream in_;
+  std::vector<std::string> strings_;
+  int precision_            = 0;
+  int64_t ticks_per_second_ = 1;
+  int64_t ticks_            = 0;
+  unsigned flags_           = 0;
+
+  int get_byte()
+  {
+    int c = in_.get();
+    xbt_assert(c != EOF, "Binary trace %s is truncated", filename_.c_str());
+    return c;
+  }
+
+public:
+  explicit BinaryTraceReader(const std::string& filename) : filename_(filename), in_(filename, std::ios::binary)
+  {
+    xbt_assert(in_.good(), "Cannot open binary trace %s", filename.c_str());
+    char header[sizeof magic];
+    in_.read(header, sizeof header);
+    xbt_assert(in_.good() && memcmp(header, magic, sizeof magic) == 0, "%s is not a binary trace", filename.c_str());
+    precision_ = static_cast<int>(get_unsigned());
+    xbt_assert(precision_ <= max_precision, "Binary trace %s is corrupted (precision: %d)", filename.c_str(),
+               precision_);
+    for (int i = 0; i < precision_; i++)
+      ticks_per_second_ *= 10;
+    flags_ = static_cast<unsigned>(get_unsigned());
+  }
+
+  bool has_flag(unsigned flag) const { return (flags_ & flag) != 0; }
+  bool at_end() { return in_.peek() == EOF; }
+
+  uint64_t get_unsigned()
+  {
+    uint64_t value = 0;
+    for (int shift = 0;; shift += 7) {
+      xbt_assert(shift < 64, "Binary trace %s is corrupted (overlong integer)", filename_.c_str());
+      int c = get_byte();
+      value |= static_cast<uint64_t>(c & 0x7f) << shift;
+      if ((c & 0x80) == 0)
+        return value;
+    }
+  }
+
+  int64_t get_signed()
+  {
+    uint64_t value = get_unsigned();
+    return static_cast<int64_t>((value >> 1) ^ (~(value & 1) + 1));
+  }
+
+  std::string get_id() { return std::to_string(static_cast<long long>(get_unsigned())); }
+
+  std::string get_double()
+  {
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; i++)
+      bits |= static_cast<uint64_t>(get_byte()) << (8 * i);
+    double value;
+    memcpy(&value, &bits, sizeof value);
+    return xbt::string_printf("%.*f", precision_, value);
+  }
+
+  std::string get_raw_string(size_t size)
+  {
+    std::string str(size, '\0');
+    in_.read(str.data(), static_cast<std::streamsize>(size));
+    xbt_assert(in_.good(), "Binary trace %s is truncated", filename_.c_str());
+    return str;
+  }
+
+  std::string get_string()
+  {
+    uint64_t code = get_unsigned();
+    if ((code & 1) == 0) {
+      xbt_assert((code >> 1) < strings_.size(), "Binary trace %s is corrupted (unknown string #%llu)",
+                 filename_.c_str(), static_cast<unsigned long long>(code >> 1));
+      return strings_[code >> 1];
+    }
+    std::string str = get_raw_string(code >> 1);
+    if (str.size() <= max_intern_size)
+      strings_.push_back(str);
+    return str;
+  }
+
+  std::string get_timestamp()
+  {
+    ticks_ += get_signed();
+    uint64_t abs_ticks = ticks_ < 0 ? -static_cast<uint64_t>(ticks_) : static_cast<uint64_t>(ticks_);
+    std::string res    = (ticks_ < 0 ? "-" : "") + std::to_string(abs_ticks / ticks_per_second_);
+    if (precision_ > 0) {
+      std::string decimals = std::to_string(abs_ticks % ticks_per_second_);
+      res += '.' + std::string(precision_ - decimals.size(), '0') + decimals;
+    }
+    return res;
+  }
+};
+} // namespace simgrid::instr::binary
+
+namespace simgrid::instr {
+void convert_binary_trace(const std::string& binary_trace, const std::string& paje_trace)
+{
+  binary::BinaryTraceReader in(binary_trace);
+  TraceWriter out;
+  xbt_assert(out.open(paje_trace), "Cannot open %s for writing", paje_trace.c_str());
+
+  out << in.get_raw_string(in.get_unsigned());
+  std::ostringstream header;
+  paje::dump_header(header, in.has_flag(binary::flag_basic), in.has_flag(binary::flag_sizes),
+                    in.has_flag(binary::flag_call_location));
+  out << header.str();
+
+  while (not in.at_end()) {
+    auto type = static_cast<PajeEventType>(in.get_unsigned());
+    out << std::to_string(static_cast<unsigned>(type));
+    switch (type) {
+      case PajeEventType::DefineContainerType:
+      case PajeEventType::DefineVariableType:
+      case PajeEventType::DefineStateType:
+      case PajeEventType::DefineEventType:
+      case PajeEventType::DefineEntityValue: {
+        out << ' ' << in.get_id() << ' ' << in.get_id() << ' ' << in.get_string();
+        if (auto color = in.get_string(); not color.empty())
+          out << " \"" << color << '"';
+        break;
+      }
+      case PajeEventType::DefineLinkType:
+        out << ' ' << in.get_id() << ' ' << in.get_id() << ' ' << in.get_id() << ' ' << in.get_id() << ' '
+            << in.get_string();
+        break;
+      case PajeEventType::CreateContainer:
+        out << ' ' << in.get_timestamp() << ' ' << in.get_id() << ' ' << in.get_id() << ' ' << in.get_id() << " \""
+            << in.get_string() << '"';
+        break;
+      case PajeEventType::DestroyContainer:
+        out << ' ' << in.get_timestamp() << ' ' << in.get_id() << ' ' << in.get_id();
+        break;
+      default:
+        xbt_assert(type <= PajeEventType::NewEvent, "Binary trace %s is corrupted (unknown event type %u)",
+                   binary_trace.c_str(), static_cast<unsigned>(type));
+        out << ' ' << in.get_timestamp() << ' ' << in.get_id() << ' ' << in.get_id();
+        if (type == PajeEventType::SetVariable || type == PajeEventType::AddVariable ||
+            type == PajeEventType::SubVariable) {
+          out << ' ' << in.get_double();
+        } else if (type == PajeEventType::StartLink || type == PajeEventType::EndLink) {
+          out << ' ' << in.get_string() << ' ' << in.get_id() << ' ' << in.get_string();
+          if (in.has_flag(binary::flag_sizes))
+            if (uint64_t size = in.get_unsigned(); size != 0)
+              out << ' ' << std::to_string(size - 1);
+        } else if (type == PajeEventType::NewEvent) {
+          out << ' ' << in.get_id();
+        } else { // States
+          if (uint64_t value = in.get_unsigned(); value != 0)
+            out << ' ' << std::to_string(static_cast<long long>(value - 1));
+          if (in.has_flag(binary::flag_sizes))
+            out << ' ' << in.get_string();
+          if (in.has_flag(binary::flag_call_location)) {
+            out << " \"" << in.get_string() << "\" ";
+            out << std::to_string(in.get_signed());
+          }
+        }
+    }
+    out << '\n';
+  }
+  out.close();
+  TraceWriter::sync();
+  XBT_DEBUG("Converted %s into %s", binary_trace.c_str(), paje_trace.c_str());
+}
+} // namespace simgrid::instr
@@ -0,0 +1,42 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef INSTR_BINARY_TRACE_HPP
+#define INSTR_BINARY_TRACE_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/* Compact encoding of the Paje events (--cfg=tracing/format:Binary).
+ *
+ * The file starts with the 8 bytes "SGTRBIN1", the precision of the timestamps, the flags selecting the optional
+ * fields of the events (1: tracing/basic, 2: sizes displayed, 4: call locations), and the comment lines of the trace.
+ * Each record then starts with its PajeEventType, followed by the same fields as in the Paje format:
+ *  - integers are LEB128 varints (signed ones are zigzag-encoded first),
+ *  - timestamps are the difference with the previous timestamp of the file, in units of 10^-precision seconds,
+ *  - the values of the variables are IEEE doubles (8 bytes, little-endian),
+ *  - strings are interned: a varint (index << 1) refers to a previously seen string, while (length << 1 | 1) is
+ *    followed by the bytes of a new string. Only the strings of at most max_intern_size bytes get an index.
+ */
+namespace simgrid::instr::binary {
+constexpr char magic[8]               = {'S', 'G', 'T', 'R', 'B', 'I', 'N', '1'};
+constexpr size_t max_intern_size      = 64;
+constexpr int max_precision           = 9;
+constexpr unsigned flag_basic         = 1;
+constexpr unsigned flag_sizes         = 2;
+constexpr unsigned flag_call_location = 4;
+
+/** Writes the header of the file, and resets the encoding state */
+void dump_header(std::ostream& out, int precision, unsigned flags, const std::string& comments);
+
+void put_unsigned(std::ostream& out, uint64_t value);
+void put_signed(std::ostream& out, int64_t value);
+void put_double(std::ostream& out, double value);
+void put_string(std::ostream& out, const std::string& str);
+void put_timestamp(std::ostream& out, double timestamp);
+} // namespace simgrid::instr::binary
+
+#endif
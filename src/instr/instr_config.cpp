@@ -6,7 +6,9 @@
 #include <simgrid/Exception.hpp>
 #include <simgrid/s4u/Engine.hpp>
 
+#include "src/instr/instr_binary_trace.hpp"
 #include "src/instr/instr_private.hpp"
+#include "src/internal_config.h"
 #include "xbt/config.hpp"
 #include "xbt/xbt_os_time.h"
 
@@ -19,8 +21,8 @@
 XBT_LOG_NEW_CATEGORY(instr, "Logging the behavior of the tracing system (used for Visualization/Analysis of simulations)");
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY (instr_config, instr, "Configuration");
 
-std::ofstream tracing_file;
-static std::map<const simgrid::instr::Container*, std::ofstream*> tracing_files; // TI specific
+simgrid::instr::TraceWriter tracing_file;
+static std::map<const simgrid::instr::Container*, simgrid::instr::TraceWriter*> tracing_files; // TI specific
 
 constexpr char OPT_TRACING_BASIC[]             = "tracing/basic";
 constexpr char OPT_TRACING_COMMENT_FILE[]      = "tracing/comment-file";
@@ -129,6 +131,15 @@ bool TRACE_smpi_view_internals()
   return trace_view_internals;
 }
 
+bool TRACE_smpi_call_location()
+{
+#if HAVE_SMPI
+  return simgrid::config::get_value<bool>("smpi/trace-call-location");
+#else
+  return false;
+#endif
+}
+
 bool TRACE_categorized ()
 {
   return trace_categorized;
@@ -220,6 +231,15 @@ xbt::signal<void(PajeEvent const&)> PajeEvent::on_destruction;
 xbt::signal<void(StateEvent const&)> StateEvent::on_destruction;
 xbt::signal<void(EntityValue const&)> EntityValue::on_creation;
 
+static std::string get_trace_name(const Container& c)
+{
+  if (c.get_name().find("rank-") != 0)
+    return c.get_name();
+  /* Subtract -1 because this is the process id and we transform it to the rank id */
+  return "rank-" + std::to_string(stoi(c.get_name().substr(5)) - 1);
+}
+
+
 static void on_container_creation_paje(const Container& c)
 {
   double timestamp = simgrid_get_clock();
@@ -230,11 +250,7 @@ static void on_container_creation_paje(const Container& c)
 
   stream << std::fixed << std::setprecision(trace_precision) << PajeEventType::CreateContainer << " ";
   stream << timestamp << " " << c.get_id() << " " << c.get_type()->get_id() << " " << c.get_parent()->get_id() << " \"";
-  if (c.get_name().find("rank-") != 0)
-    stream << c.get_name() << "\"";
-  else
-    /* Subtract -1 because this is the process id and we transform it to the rank id */
-    stream << "rank-" << stoi(c.get_name().substr(5)) - 1 << "\"";
+  stream << get_trace_name(c) << "\"";
 
   XBT_DEBUG("Dump %s", stream.str().c_str());
   tracing_file << stream.str() << '\n';
@@ -257,12 +273,36 @@ static void on_container_destruction_paje(const Container& c)
   }
 }
 
+static void on_container_creation_binary(const Container& c)
+{
+  std::stringstream stream;
+  binary::put_unsigned(stream, static_cast<unsigned>(PajeEventType::CreateContainer));
+  binary::put_timestamp(stream, simgrid_get_clock());
+  binary::put_unsigned(stream, c.get_id());
+  binary::put_unsigned(stream, c.get_type()->get_id());
+  binary::put_unsigned(stream, c.get_parent()->get_id());
+  binary::put_string(stream, get_trace_name(c));
+  tracing_file << stream.str();
+}
+
+static void on_container_destruction_binary(const Container& c)
+{
+  if (not trace_disable_destroy && &c != Container::get_root()) {
+    std::stringstream stream;
+    binary::put_unsigned(stream, static_cast<unsigned>(PajeEventType::DestroyContainer));
+    binary::put_timestamp(stream, simgrid_get_clock());
+    binary::put_unsigned(stream, c.get_type()->get_id());
+    binary::put_unsigned(stream, c.get_id());
+    tracing_file << stream.str();
+  }
+}
+
 static void on_container_creation_ti(const Container& c)
 {
   XBT_DEBUG("%s: event_type=%u, timestamp=%f", __func__, static_cast<unsigned>(PajeEventType::CreateContainer),
             simgrid_get_clock());
   // if we are in the mode with only one file
-  static std::ofstream* ti_unique_file = nullptr;
+  static simgrid::instr::TraceWriter* ti_unique_file = nullptr;
   static double prefix                 = 0.0;
 
   if (tracing_files.empty()) {
@@ -274,8 +314,8 @@ static void on_container_creation_ti(const Container& c)
     std::string folder_name = simgrid::config::get_value<std::string>("tracing/filename") + "_files";
     std::string filename    = folder_name + "/" + std::to_string(prefix) + "_" + c.get_name() + ".txt";
     mkdir(folder_name.c_str(), S_IRWXU | S_IRWXG | S_IROTH | S_IXOTH);
-    ti_unique_file = new std::ofstream(filename.c_str(), std::ofstream::out);
-    xbt_assert(not ti_unique_file->fail(), "Tracefile %s could not be opened for writing", filename.c_str());
+    ti_unique_file = new simgrid::instr::TraceWriter();
+    xbt_assert(ti_unique_file->open(filename), "Tracefile %s could not be opened for writing", filename.c_str());
     tracing_file << filename << '\n';
   }
   tracing_files.insert({&c, ti_unique_file});
@@ -304,6 +344,17 @@ static void on_entity_value_creation(const EntityValue& value)
   tracing_file << stream.str() << '\n';
 }
 
+static void on_entity_value_creation_binary(const EntityValue& value)
+{
+  std::stringstream stream;
+  binary::put_unsigned(stream, static_cast<unsigned>(PajeEventType::DefineEntityValue));
+  binary::put_unsigned(stream, value.get_id());
+  binary::put_unsigned(stream, value.get_parent()->get_id());
+  binary::put_string(stream, value.get_name());
+  binary::put_string(stream, value.get_color());
+  tracing_file << stream.str();
+}
+
 static void on_event_creation(PajeEvent& event)
 {
   XBT_DEBUG("%s: event_type=%u, timestamp=%.*f", __func__, static_cast<unsigned>(event.eventType_), trace_precision,
@@ -319,6 +370,16 @@ static void on_event_destruction(const PajeEvent& event)
   tracing_file << event.stream_.str() << '\n';
 }
 
+static void on_event_destruction_binary(const PajeEvent& event)
+{
+  std::stringstream stream;
+  binary::put_unsigned(stream, static_cast<unsigned>(event.eventType_));
+  binary::put_timestamp(stream, event.timestamp_);
+  binary::put_unsigned(stream, event.get_type()->get_id());
+  binary::put_unsigned(stream, event.get_container()->get_id());
+  tracing_file << stream.str() << event.stream_.str();
+}
+
 static void on_state_event_destruction(const StateEvent& event)
 {
   if (event.has_extra())
@@ -351,6 +412,32 @@ static void on_link_type_creation(const Type& type, const Type& source, const Ty
   tracing_file << stream.str() << '\n';
 }
 
+static void on_type_creation_binary(const Type& type, PajeEventType event_type)
+{
+  if (event_type == PajeEventType::DefineLinkType)
+    return; // this kind of type has to be handled differently
+
+  std::stringstream stream;
+  binary::put_unsigned(stream, static_cast<unsigned>(event_type));
+  binary::put_unsigned(stream, type.get_id());
+  binary::put_unsigned(stream, type.get_parent()->get_id());
+  binary::put_string(stream, type.get_name());
+  binary::put_string(stream, type.get_color());
+  tracing_file << stream.str();
+}
+
+static void on_link_type_creation_binary(const Type& type, const Type& source, const Type& dest)
+{
+  std::stringstream stream;
+  binary::put_unsigned(stream, static_cast<unsigned>(PajeEventType::DefineLinkType));
+  binary::put_unsigned(stream, type.get_id());
+  binary::put_unsigned(stream, type.get_parent()->get_id());
+  binary::put_unsigned(stream, source.get_id());
+  binary::put_unsigned(stream, dest.get_id());
+  binary::put_string(stream, type.get_name());
+  tracing_file << stream.str();
+}
+
 static void on_simulation_start()
 {
   if (trace_active || not TRACE_is_enabled())
@@ -367,32 +454,59 @@ static void on_simulation_start()
 
   /* open the trace file(s) */
   std::string filename = simgrid::config::get_value<std::string>("tracing/filename");
-  tracing_file.open(filename.c_str(), std::ofstream::out);
-  if (tracing_file.fail()) {
+  TraceWriter::configure(config::get_value<int>("tracing/buffer-size"), config::get_value<bool>("tracing/async-io"));
+  if (not tracing_file.open(filename)) {
     throw TracingError(XBT_THROW_POINT,
                        xbt::string_printf("Tracefile %s could not be opened for writing.", filename.c_str()));
   }
 
   XBT_DEBUG("Filename %s is open for writing", filename.c_str());
 
-  if (format == "Paje") {
-    Container::on_creation_cb(on_container_creation_paje);
-    Container::on_destruction_cb(on_container_destruction_paje);
-    EntityValue::on_creation_cb(on_entity_value_creation);
-    Type::on_creation_cb(on_type_creation);
-    LinkType::on_creation_cb(on_link_type_creation);
-    PajeEvent::on_creation_cb(on_event_creation);
-    PajeEvent::on_destruction_cb(on_event_destruction);
-
-    paje::dump_generator_version();
+  auto output_format = config::get_value<std::string>("tracing/format");
+  if (output_format != "Paje" && output_format != "Binary")
+    throw TracingError(XBT_THROW_POINT, xbt::string_printf("Unknown tracing/format '%s'. Valid values: Paje, Binary",
+                                                           output_format.c_str()));
+  if (format != "Paje" && output_format == "Binary")
+    throw TracingError(XBT_THROW_POINT,
+                       xbt::string_printf("tracing/format:Binary cannot encode the '%s' format of tracing/smpi/format",
+                                          format.c_str()));
 
-    /* output one line comment */
+  if (format == "Paje") {
+    /* comments at the top of the trace */
+    std::stringstream comments;
+    paje::dump_generator_version(comments);
     if (auto comment = simgrid::config::get_value<std::string>("tracing/comment"); not comment.empty())
-      tracing_file << "# " << comment << '\n';
-
-    /* output comment file */
-    paje::dump_comment_file(config::get_value<std::string>(OPT_TRACING_COMMENT_FILE));
-    paje::dump_header(trace_basic, TRACE_display_sizes());
+      comments << "# " << comment << '\n';
+    paje::dump_comment_file(comments, config::get_value<std::string>(OPT_TRACING_COMMENT_FILE));
+
+    if (output_format == "Binary") {
+      trace_format = TraceFormat::Binary;
+      Container::on_creation_cb(on_container_creation_binary);
+      Container::on_destruction_cb(on_container_destruction_binary);
+      EntityValue::on_creation_cb(on_entity_value_creation_binary);
+      Type::on_creation_cb(on_type_creation_binary);
+      LinkType::on_creation_cb(on_link_type_creation_binary);
+      PajeEvent::on_destruction_cb(on_event_destruction_binary);
+
+      unsigned flags = (trace_basic ? binary::flag_basic : 0) | (TRACE_display_sizes() ? binary::flag_sizes : 0) |
+                       (TRACE_smpi_call_location() ? binary::flag_call_location : 0);
+      std::stringstream header;
+      binary::dump_header(header, trace_precision, flags, comments.str());
+      tracing_file << header.str();
+    } else {
+      trace_format = TraceFormat::Paje;
+      Container::on_creation_cb(on_container_creation_paje);
+      Container::on_destruction_cb(on_container_destruction_paje);
+      EntityValue::on_creation_cb(on_entity_value_creation);
+      Type::on_creation_cb(on_type_creation);
+      LinkType::on_creation_cb(on_link_type_creation);
+      PajeEvent::on_creation_cb(on_event_creation);
+      PajeEvent::on_destruction_cb(on_event_destruction);
+
+      std::stringstream header;
+      paje::dump_header(header, trace_basic, TRACE_display_sizes(), TRACE_smpi_call_location());
+      tracing_file << comments.str() << header.str();
+    }
   } else {
     trace_format = TraceFormat::Ti;
     Container::on_creation_cb(on_container_creation_ti);
@@ -418,8 +532,9 @@ static void on_simulation_end()
   delete Container::get_root();
   delete root_type;
 
-  /* close the trace files */
+  /* close the trace files, and wait for them to reach the disk */
   tracing_file.close();
+  TraceWriter::sync();
   XBT_DEBUG("Filename %s is closed", config::get_value<std::string>("tracing/filename").c_str());
 
   /* de-activate trace */
@@ -444,11 +559,22 @@ void init()
                                     "The 'TI' (Time-Independent) format allows for trace replay.",
                                     "Paje");
 
+  config::declare_flag<std::string>("tracing/format",
+                                    "Select the encoding of the trace. The default is the textual 'Paje' format. The "
+                                    "'Binary' format is much more compact, and can be converted to Paje afterward.",
+                                    "Paje");
+
   config::declare_flag<bool>(OPT_TRACING_FORMAT_TI_ONEFILE,
                              "(smpi only) For replay format only : output to one file only", false);
   config::declare_flag<std::string>("tracing/comment", "Add a comment line to the top of the trace file.", "");
   config::declare_flag<std::string>(OPT_TRACING_COMMENT_FILE,
                                     "Add the contents of a file as comments to the top of the trace.", "");
+  config::declare_flag<int>("tracing/buffer-size",
+                            "Size (in bytes) of the memory buffer of each trace file, written to disk once full.",
+                            1 << 20, [](int value) { xbt_assert(value > 0, "tracing/buffer-size must be positive"); });
+  config::declare_flag<bool>("tracing/async-io",
+                             "Write the trace files from a background thread instead of blocking the simulation.",
+                             true);
   config::declare_flag<int>("tracing/precision",
                             "Numerical precision used when timestamping events "
                             "(expressed in number of digits after decimal point)",
@@ -3,6 +3,7 @@
 /* This program is free software; you can redistribute it and/or modify it
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
+#include "src/instr/instr_binary_trace.hpp"
 #include "src/instr/instr_private.hpp"
 #include "src/instr/instr_smpi.hpp"
 #include "src/smpi/include/private.hpp"
@@ -36,13 +37,33 @@ StateEvent::StateEvent(Container* container, Type* type, PajeEventType event_typ
 #endif
 }
 
+void VariableEvent::print()
+{
+  if (trace_format == TraceFormat::Binary)
+    binary::put_double(stream_, value_);
+  else
+    stream_ << " " << value_;
+}
+
 void NewEvent::print()
 {
-  stream_ << " " << value->get_id();
+  if (trace_format == TraceFormat::Binary)
+    binary::put_unsigned(stream_, value->get_id());
+  else
+    stream_ << " " << value->get_id();
 }
 
 void LinkEvent::print()
 {
+  if (trace_format == TraceFormat::Binary) {
+    binary::put_string(stream_, value_);
+    binary::put_unsigned(stream_, endpoint_->get_id());
+    binary::put_string(stream_, key_);
+    if (TRACE_display_sizes()) // size_t(-1) (no size) wraps to 0
+      binary::put_unsigned(stream_, static_cast<uint64_t>(size_) + 1);
+    return;
+  }
+
   stream_ << " " << value_ << " " << endpoint_->get_id() << " " << key_;
 
   if (TRACE_display_sizes() && size_ != static_cast<size_t>(-1))
@@ -61,6 +82,18 @@ void StateEvent::print()
 #if HAVE_SMPI
     if (smpi_cfg_trace_call_location())
       stream_ << " \"" << filename << "\" " << linenumber;
+#endif
+  } else if (trace_format == TraceFormat::Binary) {
+    binary::put_unsigned(stream_, value != nullptr ? value->get_id() + 1 : 0);
+
+    if (TRACE_display_sizes())
+      binary::put_string(stream_, (extra_ != nullptr) ? extra_->display_size() : "");
+
+#if HAVE_SMPI
+    if (smpi_cfg_trace_call_location()) {
+      binary::put_string(stream_, filename);
+      binary::put_signed(stream_, linenumber);
+    }
 #endif
   } else if (trace_format == TraceFormat::Ti) {
     if (extra_ == nullptr)
@@ -74,7 +74,7 @@ public:
       : PajeEvent::PajeEvent(container, type, timestamp, event_type), value_(value)
   {
   }
-  void print() override { stream_ << " " << value_; }
+  void print() override;
 };
 
 class StateEvent : public PajeEvent {
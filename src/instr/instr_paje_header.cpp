@@ -5,25 +5,23 @@
 
 #include "simgrid/version.h"
 #include "src/instr/instr_private.hpp"
-#include "src/smpi/include/private.hpp"
 #include <simgrid/Exception.hpp>
 #include <simgrid/s4u/Engine.hpp>
 
-extern std::ofstream tracing_file;
 namespace simgrid::instr::paje {
 
-void dump_generator_version()
+void dump_generator_version(std::ostream& out)
 {
-  tracing_file << "#This file was generated using SimGrid-" << SIMGRID_VERSION_MAJOR << "." << SIMGRID_VERSION_MINOR
-               << "." << SIMGRID_VERSION_PATCH << '\n';
-  tracing_file << "#[";
+  out << "#This file was generated using SimGrid-" << SIMGRID_VERSION_MAJOR << "." << SIMGRID_VERSION_MINOR
+      << "." << SIMGRID_VERSION_PATCH << '\n';
+  out << "#[";
   for (auto const& str : simgrid::s4u::Engine::get_instance()->get_cmdline()) {
-    tracing_file << str << " ";
+    out << str << " ";
   }
-  tracing_file << "]\n";
+  out << "]\n";
 }
 
-void dump_comment_file(const std::string& filename)
+void dump_comment_file(std::ostream& out, const std::string& filename)
 {
   if (filename.empty())
     return;
@@ -35,160 +33,158 @@ void dump_comment_file(const std::string& filename)
 
   std::string line;
   while (std::getline(fs, line))
-    tracing_file << "# " << line;
+    out << "# " << line;
   fs.close();
 }
 
-void dump_header(bool basic, bool display_sizes)
+void dump_header(std::ostream& out, bool basic, bool display_sizes, bool call_location)
 {
   // Types
-  tracing_file << "%EventDef PajeDefineContainerType " << PajeEventType::DefineContainerType << '\n';
-  tracing_file << "%       Alias string\n";
+  out << "%EventDef PajeDefineContainerType " << PajeEventType::DefineContainerType << '\n';
+  out << "%       Alias string\n";
   if (basic)
-    tracing_file << "%       ContainerType string\n";
+    out << "%       ContainerType string\n";
   else
-    tracing_file << "%       Type string\n";
-
-  tracing_file << "%       Name string\n";
-  tracing_file << "%EndEventDef\n";
-
-  tracing_file << "%EventDef PajeDefineVariableType " << PajeEventType::DefineVariableType << '\n';
-  tracing_file << "%       Alias string\n";
-  tracing_file << "%       " << (basic ? "Container" : "") << "Type string\n";
-  tracing_file << "%       Name string\n";
-  tracing_file << "%       Color color\n";
-  tracing_file << "%EndEventDef\n";
-
-  tracing_file << "%EventDef PajeDefineStateType " << PajeEventType::DefineStateType << '\n';
-  tracing_file << "%       Alias string\n";
-  tracing_file << "%       " << (basic ? "Container" : "") << "Type string\n";
-  tracing_file << "%       Name string\n";
-  tracing_file << "%EndEventDef\n";
-
-  tracing_file << "%EventDef PajeDefineEventType " << PajeEventType::DefineEventType << '\n';
-  tracing_file << "%       Alias string\n";
-  tracing_file << "%       " << (basic ? "Container" : "") << "Type string\n";
-  tracing_file << "%       Name string\n";
-  tracing_file << "%EndEventDef\n";
-
-  tracing_file << "%EventDef PajeDefineLinkType " << PajeEventType::DefineLinkType << '\n';
-  tracing_file << "%       Alias string\n";
-  tracing_file << "%       " << (basic ? "Container" : "") << "Type string\n";
-  tracing_file << "%       " << (basic ? "Source" : "Start") << "ContainerType string\n";
-  tracing_file << "%       " << (basic ? "Dest" : "End") << "ContainerType string\n";
-  tracing_file << "%       Name string\n";
-  tracing_file << "%EndEventDef\n";
+    out << "%       Type string\n";
+
+  out << "%       Name string\n";
+  out << "%EndEventDef\n";
+
+  out << "%EventDef PajeDefineVariableType " << PajeEventType::DefineVariableType << '\n';
+  out << "%       Alias string\n";
+  out << "%       " << (basic ? "Container" : "") << "Type string\n";
+  out << "%       Name string\n";
+  out << "%       Color color\n";
+  out << "%EndEventDef\n";
+
+  out << "%EventDef PajeDefineStateType " << PajeEventType::DefineStateType << '\n';
+  out << "%       Alias string\n";
+  out << "%       " << (basic ? "Container" : "") << "Type string\n";
+  out << "%       Name string\n";
+  out << "%EndEventDef\n";
+
+  out << "%EventDef PajeDefineEventType " << PajeEventType::DefineEventType << '\n';
+  out << "%       Alias string\n";
+  out << "%       " << (basic ? "Container" : "") << "Type string\n";
+  out << "%       Name string\n";
+  out << "%EndEventDef\n";
+
+  out << "%EventDef PajeDefineLinkType " << PajeEventType::DefineLinkType << '\n';
+  out << "%       Alias string\n";
+  out << "%       " << (basic ? "Container" : "") << "Type string\n";
+  out << "%       " << (basic ? "Source" : "Start") << "ContainerType string\n";
+  out << "%       " << (basic ? "Dest" : "End") << "ContainerType string\n";
+  out << "%       Name string\n";
+  out << "%EndEventDef\n";
 
   // EntityValue
-  tracing_file << "%EventDef PajeDefineEntityValue " << PajeEventType::DefineEntityValue << '\n';
-  tracing_file << "%       Alias string\n";
-  tracing_file << "%       " << (basic ? "Entity" : "") << "Type string\n";
-  tracing_file << "%       Name string\n";
-  tracing_file << "%       Color color\n";
-  tracing_file << "%EndEventDef\n";
+  out << "%EventDef PajeDefineEntityValue " << PajeEventType::DefineEntityValue << '\n';
+  out << "%       Alias string\n";
+  out << "%       " << (basic ? "Entity" : "") << "Type string\n";
+  out << "%       Name string\n";
+  out << "%       Color color\n";
+  out << "%EndEventDef\n";
 
   // Container
-  tracing_file << "%EventDef PajeCreateContainer " << PajeEventType::CreateContainer << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Alias string\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%       Name string\n";
-  tracing_file << "%EndEventDef\n";
-
-  tracing_file << "%EventDef PajeDestroyContainer " << PajeEventType::DestroyContainer << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Name string\n";
-  tracing_file << "%EndEventDef\n";
+  out << "%EventDef PajeCreateContainer " << PajeEventType::CreateContainer << '\n';
+  out << "%       Time date\n";
+  out << "%       Alias string\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%       Name string\n";
+  out << "%EndEventDef\n";
+
+  out << "%EventDef PajeDestroyContainer " << PajeEventType::DestroyContainer << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Name string\n";
+  out << "%EndEventDef\n";
 
   // Variable
-  tracing_file << "%EventDef PajeSetVariable " << PajeEventType::SetVariable << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%       Value double\n";
-  tracing_file << "%EndEventDef\n";
-
-  tracing_file << "%EventDef PajeAddVariable " << PajeEventType::AddVariable << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%       Value double\n";
-  tracing_file << "%EndEventDef\n";
-
-  tracing_file << "%EventDef PajeSubVariable " << PajeEventType::SubVariable << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%       Value double\n";
-  tracing_file << "%EndEventDef\n";
+  out << "%EventDef PajeSetVariable " << PajeEventType::SetVariable << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%       Value double\n";
+  out << "%EndEventDef\n";
+
+  out << "%EventDef PajeAddVariable " << PajeEventType::AddVariable << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%       Value double\n";
+  out << "%EndEventDef\n";
+
+  out << "%EventDef PajeSubVariable " << PajeEventType::SubVariable << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%       Value double\n";
+  out << "%EndEventDef\n";
 
   // State
-  tracing_file << "%EventDef PajeSetState " << PajeEventType::SetState << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%       Value string\n";
-  tracing_file << "%EndEventDef\n";
-
-  tracing_file << "%EventDef PajePushState " << PajeEventType::PushState << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%       Value string\n";
+  out << "%EventDef PajeSetState " << PajeEventType::SetState << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%       Value string\n";
+  out << "%EndEventDef\n";
+
+  out << "%EventDef PajePushState " << PajeEventType::PushState << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%       Value string\n";
   if (display_sizes)
-    tracing_file << "%       Size int\n";
-#if HAVE_SMPI
-  if (smpi_cfg_trace_call_location()) {
+    out << "%       Size int\n";
+  if (call_location) {
     /* paje currently (May 2016) uses "Filename" and "Linenumber" as reserved words. We cannot use them... */
-    tracing_file << "%       Fname string\n";
-    tracing_file << "%       Lnumber int\n";
+    out << "%       Fname string\n";
+    out << "%       Lnumber int\n";
   }
-#endif
-  tracing_file << "%EndEventDef\n";
+  out << "%EndEventDef\n";
 
-  tracing_file << "%EventDef PajePopState " << PajeEventType::PopState << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%EndEventDef\n";
+  out << "%EventDef PajePopState " << PajeEventType::PopState << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%EndEventDef\n";
 
   if (not basic) {
-    tracing_file << "%EventDef PajeResetState " << PajeEventType::ResetState << '\n';
-    tracing_file << "%       Time date\n";
-    tracing_file << "%       Type string\n";
-    tracing_file << "%       Container string\n";
-    tracing_file << "%EndEventDef\n";
+    out << "%EventDef PajeResetState " << PajeEventType::ResetState << '\n';
+    out << "%       Time date\n";
+    out << "%       Type string\n";
+    out << "%       Container string\n";
+    out << "%EndEventDef\n";
   }
 
   // Link
-  tracing_file << "%EventDef PajeStartLink " << PajeEventType::StartLink << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%       Value string\n";
-  tracing_file << "%       " << (basic ? "Source" : "Start") << "Container string\n";
-  tracing_file << "%       Key string\n";
+  out << "%EventDef PajeStartLink " << PajeEventType::StartLink << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%       Value string\n";
+  out << "%       " << (basic ? "Source" : "Start") << "Container string\n";
+  out << "%       Key string\n";
   if (display_sizes)
-    tracing_file << "%       Size int\n";
-  tracing_file << "%EndEventDef\n";
-
-  tracing_file << "%EventDef PajeEndLink " << PajeEventType::EndLink << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%       Value string\n";
-  tracing_file << "%       " << (basic ? "Dest" : "End") << "Container string\n";
-  tracing_file << "%       Key string\n";
-  tracing_file << "%EndEventDef\n";
+    out << "%       Size int\n";
+  out << "%EndEventDef\n";
+
+  out << "%EventDef PajeEndLink " << PajeEventType::EndLink << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%       Value string\n";
+  out << "%       " << (basic ? "Dest" : "End") << "Container string\n";
+  out << "%       Key string\n";
+  out << "%EndEventDef\n";
 
   // Event
-  tracing_file << "%EventDef PajeNewEvent " << PajeEventType::NewEvent << '\n';
-  tracing_file << "%       Time date\n";
-  tracing_file << "%       Type string\n";
-  tracing_file << "%       Container string\n";
-  tracing_file << "%       Value string\n";
-  tracing_file << "%EndEventDef\n";
+  out << "%EventDef PajeNewEvent " << PajeEventType::NewEvent << '\n';
+  out << "%       Time date\n";
+  out << "%       Type string\n";
+  out << "%       Container string\n";
+  out << "%       Value string\n";
+  out << "%EndEventDef\n";
 }
 } // namespace simgrid::instr::paje
@@ -311,6 +311,10 @@ static void on_link_creation(s4u::Link const& link)
   if (currentContainer.empty() ||
       link.get_name() == "__loopback__") // No ongoing parsing. Are you creating the loopback?
     return;
+  // The links declared in a cluster (such as its backbone) are sealed when parsed, and once more with their netzone.
+  // Creating their container again would throw a TracingError.
+  if (Container::by_name_or_null(link.get_name()) != nullptr)
+    return;
 
   auto* container = new Container(link.get_name(), "LINK", currentContainer.back());
 
@@ -369,6 +373,8 @@ static void on_host_creation(s4u::Host const& host)
 static void on_action_state_change(kernel::resource::Action const& action,
                                    kernel::resource::Action::State /* previous */)
 {
+  if (action.get_variable() == nullptr) // Latency-only communications do not use the maxmin system
+    return;
   auto n = static_cast<unsigned>(action.get_variable()->get_number_of_constraint());
 
   for (unsigned i = 0; i < n; i++) {
@@ -14,6 +14,7 @@
 #include "src/instr/instr_paje_events.hpp"
 #include "src/instr/instr_paje_types.hpp"
 #include "src/instr/instr_paje_values.hpp"
+#include "src/instr/instr_trace_writer.hpp"
 
 #include <fstream>
 #include <iomanip> /** std::setprecision **/
@@ -27,18 +28,19 @@
 namespace simgrid::instr {
 namespace paje {
 
-void dump_generator_version();
-void dump_comment_file(const std::string& filename);
-void dump_header(bool basic, bool display_sizes);
+void dump_generator_version(std::ostream& out);
+void dump_comment_file(std::ostream& out, const std::string& filename);
+void dump_header(std::ostream& out, bool basic, bool display_sizes, bool call_location);
 } // namespace paje
 
 /* Format of TRACING output.
  *   - paje is the regular format, that we all know
+ *   - binary encodes the same events as paje in a compact form, to be converted back to paje with trace_to_paje
  *   - TI is a trick to reuse the tracing functions to generate a time independent trace during the execution. Such
  *     trace can easily be replayed with smpi_replay afterward. This trick should be removed and replaced by some code
  *     using the signal that we will create to cleanup the TRACING
  */
-enum class TraceFormat { Paje, /*TimeIndependent*/ Ti };
+enum class TraceFormat { Paje, Binary, /*TimeIndependent*/ Ti };
 extern TraceFormat trace_format;
 extern double last_timestamp_to_dump;
 
@@ -244,6 +246,7 @@ XBT_PRIVATE bool TRACE_vm_is_enabled();
 XBT_PRIVATE bool TRACE_disable_link();
 XBT_PRIVATE bool TRACE_disable_speed();
 XBT_PRIVATE bool TRACE_display_sizes();
+XBT_PRIVATE bool TRACE_smpi_call_location();
 
 /* Public functions used in SMPI */
 XBT_PUBLIC bool TRACE_smpi_is_enabled();
@@ -0,0 +1,273 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/instr/instr_trace_writer.hpp"
+#include <simgrid/Exception.hpp>
+#include <xbt/log.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(instr_trace_writer, instr, "Buffered writing of the trace files");
+
+namespace simgrid::instr {
+
+static size_t buffer_size = 1 << 20;
+static bool async_io      = true;
+/* Bytes held in the buffers of all the writers. Past a limit, the writers hand their buffer over before it is full. */
+static std::atomic<size_t> buffered_bytes{0};
+
+static size_t max_buffered_bytes()
+{
+  return std::max<size_t>(64 * buffer_size, 16 << 20);
+}
+
+/* Writes the whole data, and returns 0 or the errno of the failure */
+static int write_fully(int fd, const std::string& data)
+{
+  const char* pos = data.data();
+  size_t left     = data.size();
+  while (left > 0) {
+    ssize_t written = ::write(fd, pos, left);
+    if (written < 0 && errno == EINTR)
+      continue;
+    if (written < 0)
+      return errno;
+    pos += written;
+    left -= static_cast<size_t>(written);
+  }
+  return 0;
+}
+
+/* Synchronizes the file on disk and closes it, and returns 0 or the errno of the failure */
+static int sync_and_close(int fd)
+{
+  int error = 0;
+  if (fsync(fd) != 0 && errno != EINVAL) // EINVAL: this file does not support synchronization (e.g., a pipe)
+    error = errno;
+  if (::close(fd) != 0 && error == 0)
+    error = errno;
+  return error;
+}
+
+/** The thread writing the buffers to the disk, in the order in which they were submitted */
+class TraceIOThread {
+  struct Job {
+    int fd;
+    std::string data;
+    std::string filename; // Only set when the file must be closed after this job
+  };
+  std::mutex mutex_;
+  std::condition_variable work_cv_;
+  std::condition_variable done_cv_;
+  std::deque<Job> jobs_;
+  size_t queued_bytes_ = 0;
+  bool busy_           = false;
+  std::vector<int> failed_fds_;
+  std::vector<std::string> failures_;
+  std::thread thread_;
+
+  void run();
+  void record_failure(int fd, const std::string& filename, int error);
+
+public:
+  TraceIOThread() : thread_([this] { run(); }) {}
+
+  static TraceIOThread& get()
+  {
+    /* Never destroyed, so that the files still open at exit can be flushed from the static destructors */
+    static auto* instance = [] {
+      auto* thread = new TraceIOThread();
+      std::atexit([] { get().wait_idle(); }); // Do not lose the data of the files closed right before exit
+      return thread;
+    }();
+    return *instance;
+  }
+
+  void submit(int fd, std::string&& data, const std::string& filename_to_close);
+  std::vector<std::string> wait_idle();
+};
+
+void TraceIOThread::record_failure(int fd, const std::string& filename, int error)
+{
+  if (std::find(failed_fds_.begin(), failed_fds_.end(), fd) != failed_fds_.end())
+    return; // Only report the first failure of each file
+  failed_fds_.push_back(fd);
+  failures_.push_back(xbt::string_printf("Error while writing trace file %s: %s", filename.c_str(), strerror(error)));
+}
+
+void TraceIOThread::run()
+{
+  std::unique_lock lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [this] { return not jobs_.empty(); });
+    Job job = std::move(jobs_.front());
+    jobs_.pop_front();
+    busy_ = true;
+    lock.unlock();
+
+    int error       = write_fully(job.fd, job.data);
+    int close_error = job.filename.empty() ? 0 : sync_and_close(job.fd);
+
+    lock.lock();
+    if (error != 0 || close_error != 0)
+      record_failure(job.fd, job.filename, error != 0 ? error : close_error);
+    if (not job.filename.empty()) // This fd number may be reused by another file from now on
+      failed_fds_.erase(std::remove(failed_fds_.begin(), failed_fds_.end(), job.fd), failed_fds_.end());
+    queued_bytes_ -= job.data.size();
+    busy_ = false;
+    done_cv_.notify_all();
+  }
+}
+
+void TraceIOThread::submit(int fd, std::string&& data, const std::string& filename_to_close)
+{
+  std::unique_lock lock(mutex_);
+  // Bound the memory: wait for the disk if the thread lags too far behind
+  done_cv_.wait(lock, [this] { return queued_bytes_ < max_buffered_bytes(); });
+  queued_bytes_ += data.size();
+  jobs_.push_back({fd, std::move(data), filename_to_close});
+  work_cv_.notify_one();
+}
+
+std::vector<std::string> TraceIOThread::wait_idle()
+{
+  std::unique_lock lock(mutex_);
+  done_cv_.wait(lock, [this] { return jobs_.empty() && not busy_; });
+  return std::move(failures_);
+}
+
+void TraceWriter::configure(size_t size, bool async)
+{
+  buffer_size = size;
+  async_io    = async;
+}
+
+void TraceWriter::sync()
+{
+  if (not async_io)
+    return;
+  auto failures = TraceIOThread::get().wait_idle();
+  if (not failures.empty())
+    throw TracingError(XBT_THROW_POINT, failures.front());
+}
+
+TraceWriter::~TraceWriter()
+{
+  if (is_open()) {
+    try {
+      close();
+      sync();
+    } catch (const TracingError& e) {
+      XBT_ERROR("%s", e.what());
+    }
+  }
+}
+
+bool TraceWriter::open(const std::string& filename)
+{
+  xbt_assert(not is_open(), "Trace file %s is already open", filename_.c_str());
+  filename_ = filename;
+  fd_       = ::open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+  return fd_ != -1;
+}
+
+void TraceWriter::submit()
+{
+  buffered_bytes -= buffer_.size();
+  if (not async_io) {
+    if (int error = write_fully(fd_, buffer_); error != 0)
+      throw TracingError(XBT_THROW_POINT, xbt::string_printf("Error while writing trace file %s: %s",
+                                                             filename_.c_str(), strerror(error)));
+    buffer_.clear();
+    return;
+  }
+  std::string data;
+  data.swap(buffer_);
+  buffer_.reserve(data.size());
+  TraceIOThread::get().submit(fd_, std::move(data), "");
+}
+
+void TraceWriter::flush()
+{
+  if (not buffer_.empty())
+    submit();
+}
+
+void TraceWriter::close()
+{
+  if (not is_open())
+    return;
+  int fd = fd_;
+  fd_    = -1;
+  buffered_bytes -= buffer_.size();
+  if (async_io) {
+    TraceIOThread::get().submit(fd, std::move(buffer_), filename_);
+    buffer_.clear();
+    XBT_DEBUG("Trace file %s will be closed in background", filename_.c_str());
+    return;
+  }
+  int error = write_fully(fd, buffer_);
+  buffer_.clear();
+  if (int close_error = sync_and_close(fd); error == 0)
+    error = close_error;
+  XBT_DEBUG("Trace file %s is closed", filename_.c_str());
+  if (error != 0)
+    throw TracingError(XBT_THROW_POINT,
+                       xbt::string_printf("Error while writing trace file %s: %s", filename_.c_str(), strerror(error)));
+}
+
+void TraceWriter::appended(size_t count)
+{
+  buffered_bytes += count;
+  if (buffer_.size() >= buffer_size || buffered_bytes > max_buffered_bytes())
+    submit();
+}
+
+TraceWriter& TraceWriter::operator<<(std::string_view str)
+{
+  buffer_.append(str);
+  appended(str.size());
+  return *this;
+}
+
+/* Prints the number at the end of the buffer, without any temporary string. Returns the amount of printed bytes. */
+template <typename T, typename... Format> static size_t append_to_chars(std::string& buffer, T value, Format... format)
+{
+  constexpr size_t max_length = 32;
+  const size_t start          = buffer.size();
+  buffer.resize(start + max_length);
+  const auto res = std::to_chars(buffer.data() + start, buffer.data() + buffer.size(), value, format...);
+  buffer.resize(res.ptr - buffer.data());
+  return buffer.size() - start;
+}
+
+void TraceWriter::append_number(long long value)
+{
+  appended(append_to_chars(buffer_, value));
+}
+
+void TraceWriter::append_number(unsigned long long value)
+{
+  appended(append_to_chars(buffer_, value));
+}
+
+void TraceWriter::append_number(double value)
+{
+  // Same as the default formatting of the streams
+  appended(append_to_chars(buffer_, value, std::chars_format::general, 6));
+}
+} // namespace simgrid::instr
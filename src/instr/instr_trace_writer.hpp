@@ -0,0 +1,74 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef INSTR_TRACE_WRITER_HPP
+#define INSTR_TRACE_WRITER_HPP
+
+#include <xbt/base.h>
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace simgrid::instr {
+
+/** @brief Output file of the tracing system
+ *
+ * The records are appended to an in-memory buffer, which is written once it reaches tracing/buffer-size bytes. Unless
+ * tracing/async-io is disabled, the full buffers (and the final fsync of each file) are handed over to a background
+ * I/O thread so that the simulation does not wait for the disk. The memory used by all the buffers is bounded: the
+ * simulation stalls if the I/O thread lags too far behind. Call sync() to wait until everything reached the disk.
+ */
+class TraceWriter {
+  std::string filename_;
+  int fd_ = -1;
+  std::string buffer_;
+
+  void submit();
+  /** Accounts for the bytes just appended to the buffer, and hands it over if it is full */
+  void appended(size_t count);
+  void append_number(long long value);
+  void append_number(unsigned long long value);
+  void append_number(double value);
+
+public:
+  TraceWriter() = default;
+  TraceWriter(const TraceWriter&)            = delete;
+  TraceWriter& operator=(const TraceWriter&) = delete;
+  ~TraceWriter();
+
+  /** Sets the size of the buffers of all trace files (in bytes), and whether they are written in background */
+  static void configure(size_t buffer_size, bool async_io);
+  /** Waits until all the closed files are on disk. Throws a TracingError if any write failed. */
+  static void sync();
+
+  /** Opens (and truncates) the given file. Returns false on failure, with errno set */
+  bool open(const std::string& filename);
+  bool is_open() const { return fd_ != -1; }
+  const std::string& get_filename() const { return filename_; }
+  /** Writes the buffered records (in background if possible) */
+  void flush();
+  /** Flushes and closes the file. The file is synchronized on disk, but sync() must be called to wait for it. */
+  void close();
+
+  TraceWriter& operator<<(std::string_view str);
+  TraceWriter& operator<<(const std::string& str) { return *this << std::string_view(str); }
+  TraceWriter& operator<<(const char* str) { return *this << std::string_view(str); }
+  TraceWriter& operator<<(char c) { return *this << std::string_view(&c, 1); }
+  /** Formats the number right into the buffer, as a stream with its default settings would */
+  template <typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>> TraceWriter& operator<<(T value)
+  {
+    if constexpr (std::is_floating_point_v<T>)
+      append_number(static_cast<double>(value));
+    else if constexpr (std::is_signed_v<T>)
+      append_number(static_cast<long long>(value));
+    else
+      append_number(static_cast<unsigned long long>(value));
+    return *this;
+  }
+};
+} // namespace simgrid::instr
+
+#endif
@@ -68,6 +68,7 @@ public:
   void* get_match_data() const { return match_data_; }
   bool is_detached() const { return detached_; }
   void set_comm(activity::CommImpl* comm) { comm_ = comm; }
+  activity::CommImpl* get_comm() const { return comm_; }
   void set_tag(int tag) { tag_ = tag; }
 
   auto const& get_match_fun() const { return match_fun_; }
@@ -36,6 +36,13 @@ config::Flag<double> NetworkModel::cfg_weight_S_parameter(
     "network/weight-S",
     "Correction factor to apply to the weight of competing streams (default value set by network model)", 0.0);
 
+/** @brief Command-line option 'network/latency-only-thresh' -- see @ref cfg=network/latency-only-thresh */
+config::Flag<double> NetworkModel::cfg_latency_only_thresh(
+    "network/latency-only-thresh",
+    "Messages smaller than this size (in bytes) do not enter the maxmin system: they pay the latency, then use the "
+    "bandwidth share available when they started (0: disabled)",
+    0.0, [](double value) { xbt_assert(value >= 0, "network/latency-only-thresh cannot be negative"); });
+
 NetworkModel::~NetworkModel() = default;
 
 double NetworkModel::next_occurring_event_full(double now)
@@ -70,6 +77,8 @@ void NetworkAction::set_state(Action::State state)
 std::list<StandardLinkImpl*> NetworkAction::get_links() const
 {
   std::list<StandardLinkImpl*> retlist;
+  if (get_variable() == nullptr) // Latency-only communications do not use the maxmin system
+    return retlist;
   int llen = get_variable()->get_number_of_constraint();
 
   for (int i = 0; i < llen; i++) {
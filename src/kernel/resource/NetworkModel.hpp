@@ -27,6 +27,7 @@ public:
   static config::Flag<double> cfg_tcp_gamma;
   static config::Flag<bool> cfg_crosstraffic;
   static config::Flag<double> cfg_weight_S_parameter;
+  static config::Flag<double> cfg_latency_only_thresh;
 
   using Model::Model;
   NetworkModel(const NetworkModel&) = delete;
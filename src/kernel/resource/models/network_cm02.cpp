@@ -17,6 +17,7 @@
 #include "xbt/config.hpp"
 
 #include <algorithm>
+#include <limits>
 #include <numeric>
 
 XBT_LOG_EXTERNAL_DEFAULT_CATEGORY(res_network);
@@ -456,6 +457,15 @@ Action* NetworkCm02Model::communicate(s4u::Host* src, s4u::Host* dst, double siz
 
   bool failed = comm_get_route_info(src, dst, latency, route, back_route, netzones);
 
+  if (size < cfg_latency_only_thresh && is_update_lazy() && not streamed && not failed &&
+      std::none_of(route.begin(), route.end(), [](const StandardLinkImpl* link) {
+        return link->get_sharing_policy() == s4u::Link::SharingPolicy::WIFI;
+      })) {
+    NetworkCm02Action* action = comm_latency_only_create(src, dst, size, rate, latency, route, netzones);
+    XBT_OUT();
+    return action;
+  }
+
   NetworkCm02Action* action = comm_action_create(src, dst, size, route, failed);
   action->sharing_penalty_  = latency;
   action->latency_          = latency;
@@ -480,6 +490,34 @@ Action* NetworkCm02Model::communicate(s4u::Host* src, s4u::Host* dst, double siz
   return action;
 }
 
+NetworkCm02Action* NetworkCm02Model::comm_latency_only_create(
+    s4u::Host* src, s4u::Host* dst, double size, double rate, double latency,
+    const std::vector<StandardLinkImpl*>& route, const std::unordered_set<kernel::routing::NetZoneImpl*>& netzones)
+{
+  auto* action = new NetworkCm02LatencyOnlyAction(this, *src, *dst, size);
+  action->set_last_update();
+  action->sharing_penalty_ = latency;
+  action->latency_         = latency;
+  comm_action_set_bounds(src, dst, size, action, route, netzones, rate);
+
+  /* Share that the message would get if all the flows currently crossing each link got the same, without solving the
+   * maxmin system. It is not updated afterward: the message is short enough to end before the sharing changes much. */
+  double bandwidth = std::numeric_limits<double>::infinity();
+  for (auto const* link : route) {
+    double share = link->get_bandwidth();
+    if (link->get_sharing_policy() != s4u::Link::SharingPolicy::FATPIPE)
+      share /= static_cast<double>(link->get_constraint()->enabled_element_set_.size() + 1);
+    bandwidth = std::min(bandwidth, share);
+  }
+  if (action->get_user_bound() >= 0)
+    bandwidth = std::min(bandwidth, action->get_user_bound());
+  if (action->lat_current_ > 0 && cfg_tcp_gamma > 0)
+    bandwidth = std::min(bandwidth, cfg_tcp_gamma / (2.0 * action->lat_current_));
+
+  action->start(action->latency_, bandwidth * action->get_rate_factor());
+  return action;
+}
+
 /************
  * Resource *
  ************/
@@ -608,4 +646,63 @@ void NetworkCm02Action::update_remains_lazy(double now)
   set_last_value(get_rate());
 }
 
+void NetworkCm02LatencyOnlyAction::start(double latency, double rate)
+{
+  rate_        = rate;
+  latency_end_ = get_last_update() + latency;
+  reschedule();
+}
+
+/* Puts the completion date in the heap, from the remaining amount updated at the last update */
+void NetworkCm02LatencyOnlyAction::reschedule()
+{
+  double date           = std::max(get_last_update(), latency_end_) + get_remains_no_update() / rate_;
+  ActionHeap::Type type = ActionHeap::Type::normal;
+  if (get_max_duration() != NO_MAX_DURATION && get_start_time() + get_max_duration() < date) {
+    date = get_start_time() + get_max_duration();
+    type = ActionHeap::Type::max_duration;
+  }
+  XBT_DEBUG("Latency-only action %p (rate: %g) ends at %f", this, rate_, date);
+  get_model()->get_action_heap().update(this, date, type);
+}
+
+void NetworkCm02LatencyOnlyAction::update_remains_lazy(double now)
+{
+  if (not is_running())
+    return;
+
+  if (double begin = std::max(get_last_update(), latency_end_); now > begin && get_remains_no_update() > 0)
+    update_remains(rate_ * (now - begin));
+  update_max_duration(now - get_last_update());
+  set_last_update();
+}
+
+void NetworkCm02LatencyOnlyAction::suspend()
+{
+  if (not is_running())
+    return;
+  update_remains_lazy(EngineImpl::get_clock());
+  latency_left_ = std::max(0.0, latency_end_ - get_last_update());
+  get_model()->get_action_heap().remove(this);
+  set_suspend_state(SuspendStates::SUSPENDED);
+}
+
+void NetworkCm02LatencyOnlyAction::resume()
+{
+  if (not is_suspended())
+    return;
+  set_suspend_state(SuspendStates::RUNNING);
+  set_last_update();
+  latency_end_ = get_last_update() + latency_left_;
+  reschedule();
+}
+
+void NetworkCm02LatencyOnlyAction::set_max_duration(double duration)
+{
+  update_remains_lazy(EngineImpl::get_clock());
+  Action::set_max_duration(duration);
+  if (is_running())
+    reschedule();
+}
+
 } // namespace simgrid::kernel::resource
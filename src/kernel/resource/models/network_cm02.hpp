@@ -18,6 +18,7 @@ namespace simgrid::kernel::resource {
 
 class XBT_PRIVATE NetworkCm02Model;
 class XBT_PRIVATE NetworkCm02Action;
+class XBT_PRIVATE NetworkCm02LatencyOnlyAction;
 class XBT_PRIVATE NetworkSmpiModel;
 
 /*********
@@ -43,6 +44,10 @@ class NetworkCm02Model : public NetworkModel {
   /** @brief Create maxmin variable in communication action */
   void comm_action_set_variable(NetworkCm02Action* action, const std::vector<StandardLinkImpl*>& route,
                                 const std::vector<StandardLinkImpl*>& back_route, bool streamed);
+  /** @brief Create a communication that does not enter the maxmin system (see network/latency-only-thresh) */
+  NetworkCm02Action* comm_latency_only_create(s4u::Host* src, s4u::Host* dst, double size, double rate,
+                                              double latency, const std::vector<StandardLinkImpl*>& route,
+                                              const std::unordered_set<kernel::routing::NetZoneImpl*>& netzones);
 
 public:
   explicit NetworkCm02Model(const std::string& name);
@@ -75,5 +80,29 @@ public:
   using NetworkAction::NetworkAction;
   void update_remains_lazy(double now) override;
 };
+
+/** @brief Small communication paying its latency, then progressing at the bandwidth share it got when starting.
+ *
+ * It has no maxmin variable: its completion date is computed once and only changes when it is suspended.
+ */
+class NetworkCm02LatencyOnlyAction : public NetworkCm02Action {
+  double rate_         = 0.0;
+  double latency_end_  = 0.0;
+  double latency_left_ = 0.0; // Latency still to pay when resumed
+
+  void reschedule();
+
+public:
+  NetworkCm02LatencyOnlyAction(Model* model, s4u::Host& src, s4u::Host& dst, double cost)
+      : NetworkCm02Action(model, src, dst, cost, false)
+  {
+  }
+  void start(double latency, double rate);
+  void update_remains_lazy(double now) override;
+  void suspend() override;
+  void resume() override;
+  void set_max_duration(double duration) override;
+  void set_sharing_penalty(double sharing_penalty) override { set_sharing_penalty_no_update(sharing_penalty); }
+};
 } // namespace simgrid::kernel::resource
 #endif /* SIMGRID_MODEL_NETWORK_CM02_HPP_ */
@@ -81,6 +81,10 @@ void NetworkIBModel::IB_comm_start_callback(const s4u::Comm& comm)
 
 NetworkIBModel::NetworkIBModel(const std::string& name) : NetworkCm02Model(name)
 {
+  xbt_assert(cfg_latency_only_thresh == 0.0,
+             "network/latency-only-thresh is not supported by the IB network model, which updates the rate of the "
+             "communications in flight");
+
   std::string IB_factors_string = config::get_value<std::string>("smpi/IB-penalty-factors");
   std::vector<std::string> radical_elements;
   boost::split(radical_elements, IB_factors_string, boost::is_any_of(";"));
@@ -31,6 +31,12 @@ DragonflyZone::Coords DragonflyZone::rankId_to_coords(unsigned long rankId) cons
   return coords;
 }
 
+std::vector<unsigned long> DragonflyZone::get_hierarchical_coords(unsigned long id) const
+{
+  auto coords = rankId_to_coords(id);
+  return {coords.group, coords.chassis, coords.blade};
+}
+
 void DragonflyZone::set_link_characteristics(double bw, double lat, s4u::Link::SharingPolicy sharing_policy)
 {
   ClusterBase::set_link_characteristics(bw, lat, sharing_policy);
@@ -42,6 +42,18 @@ bool FatTreeZone::is_in_sub_tree(const FatTreeNode* root, const FatTreeNode* nod
   return true;
 }
 
+std::vector<unsigned long> FatTreeZone::get_hierarchical_coords(unsigned long id) const
+{
+  // The leaves below a switch of level l are contiguous, by groups of the product of the down links of the lower levels
+  std::vector<unsigned long> subtree_sizes{1};
+  for (unsigned long level = 0; level + 1 < levels_; level++)
+    subtree_sizes.push_back(subtree_sizes.back() * num_children_per_node_[level]);
+  std::vector<unsigned long> coords;
+  for (auto size = subtree_sizes.rbegin(); size != subtree_sizes.rend() - 1; ++size)
+    coords.push_back(id / *size);
+  return coords;
+}
+
 void FatTreeZone::get_local_route(const NetPoint* src, const NetPoint* dst, Route* into, double* latency)
 {
   if (dst->is_router() || src->is_router())
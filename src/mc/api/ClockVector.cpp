@@ -5,18 +5,65 @@
 
 #include "src/mc/api/ClockVector.hpp"
 
+#include <algorithm>
+
 namespace simgrid::mc {
 
-size_t ClockVector::max_size = 3;
+ClockVector::ClockVector(const std::vector<long>& init)
+{
+  for (size_t aid = 0; aid < init.size(); aid++)
+    (*this)[aid] = init[aid];
+}
+
+ClockVector::Chunk& ClockVector::own_chunk(size_t index)
+{
+  auto& chunk = chunks_[index];
+  if (chunk == nullptr) {
+    chunk = std::make_shared<Chunk>();
+    chunk->fill(-1);
+  } else if (chunk.use_count() > 1)
+    chunk = std::make_shared<Chunk>(*chunk);
+  return *chunk;
+}
 
 ClockVector ClockVector::max(const ClockVector& cv1, const ClockVector& cv2)
 {
   auto max_vector = ClockVector(cv1);
-
-  for (size_t aid = 0; aid < cv2.size(); aid++)
-    max_vector[aid] = std::max<signed long>(cv2.get(aid).value(), cv1.get(aid).value_or(-1));
-
+  max_emplace_left(max_vector, cv2);
   return max_vector;
 }
 
+void ClockVector::max_emplace_left(ClockVector& cv1, const ClockVector& cv2)
+{
+  if (cv1.size_ < cv2.size_) {
+    cv1.size_ = cv2.size_;
+    cv1.chunks_.resize(cv2.chunks_.size());
+  }
+  for (size_t i = 0; i < cv2.chunks_.size(); i++) {
+    const auto& theirs = cv2.chunks_[i];
+    auto& ours         = cv1.chunks_[i];
+    if (theirs == nullptr || theirs == ours)
+      continue;
+    if (ours == nullptr) {
+      ours = theirs;
+      continue;
+    }
+    bool larger  = false; // Whether some component of theirs is larger than ours
+    bool smaller = false; // Whether some component of theirs is smaller than ours
+    for (size_t j = 0; j < chunk_size; j++) {
+      larger  = larger || (*theirs)[j] > (*ours)[j];
+      smaller = smaller || (*theirs)[j] < (*ours)[j];
+    }
+    if (not larger)
+      continue;
+    if (not smaller) {
+      ours = theirs;
+      continue;
+    }
+    Chunk& mine = cv1.own_chunk(i);
+    std::transform(theirs->begin(), theirs->end(), mine.begin(), mine.begin(),
+                   [](long a, long b) { return std::max(a, b); });
+  }
+}
+
 } // namespace simgrid::mc
@@ -9,11 +9,10 @@
 #include "simgrid/forward.h"
 #include "xbt/asserts.h"
 
-#include <algorithm>
+#include <array>
 #include <cstdint>
-#include <initializer_list>
+#include <memory>
 #include <optional>
-#include <unordered_map>
 #include <vector>
 
 namespace simgrid::mc {
@@ -47,56 +46,86 @@ namespace simgrid::mc {
  */
 struct ClockVector final {
 private:
-  static size_t max_size;
-  std::vector<long> contents_ = std::vector<long>(max_size, -1);
-  long negative_value         = -1;
-  // std::unordered_map<aid_t, uint32_t> contents_;
+  /* The components are stored by chunks, that are shared between the copies of a clock vector until one of them gets
+   * modified (copy-on-write). A missing chunk maps all of its actors to -1.
+   *
+   * In an execution, the clock vector of an event is computed from the clock vectors of the previous events it depends
+   * on, and only differs from them in the components of the few actors it synchronized with. Most of its chunks are
+   * thus shared with these previous events. This saves memory and copies, and lets `max_emplace_left()` skip the
+   * chunks that both clock vectors share. */
+  static constexpr size_t chunk_size = 8;
+  using Chunk                        = std::array<long, chunk_size>;
+  std::vector<std::shared_ptr<Chunk>> chunks_;
+  size_t size_        = 0;
+  long negative_value = -1;
+
+  /** The chunk storing that component, copied first if it is shared with another clock vector */
+  Chunk& own_chunk(size_t index);
 
 public:
+  class const_iterator {
+    const ClockVector* cv_;
+    size_t aid_;
+
+  public:
+    const_iterator(const ClockVector* cv, size_t aid) : cv_(cv), aid_(aid) {}
+    long operator*() const { return cv_->get(aid_).value(); }
+    const_iterator& operator++()
+    {
+      aid_++;
+      return *this;
+    }
+    const_iterator operator++(int)
+    {
+      const_iterator previous = *this;
+      aid_++;
+      return previous;
+    }
+    bool operator==(const const_iterator& other) const { return aid_ == other.aid_; }
+    bool operator!=(const const_iterator& other) const { return aid_ != other.aid_; }
+  };
+
   ClockVector()                              = default;
   ClockVector(const ClockVector&)            = default;
   ClockVector& operator=(ClockVector const&) = default;
   ClockVector(ClockVector&&)                 = default;
-  // ClockVector(std::initializer_list<std::pair<const aid_t, uint32_t>> init) : contents_(std::move(init)) {}
-  ClockVector(std::vector<long> init) : contents_(std::move(init)) {}
+  ClockVector(const std::vector<long>& init);
 
-  bool empty() const { return this->contents_.empty(); }
-  auto begin() const { return this->contents_.begin(); }
-  auto end() const { return this->contents_.end(); }
+  bool empty() const { return size_ == 0; }
+  const_iterator begin() const { return const_iterator(this, 0); }
+  const_iterator end() const { return const_iterator(this, size_); }
 
   /**
    * @brief The number of components in this
    * clock vector
    *
    * A `ClockVector` implicitly maps the id of an actor
-   * it does not contain to a default value of `0`.
+   * it does not contain to a default value of `-1`.
    * Thus, a `ClockVector` is "lazy" in the sense
    * that new actors are "automatically" mapped
    * without needing to be explicitly added the clock
    * vector when the actor is created. This means that
-   * comparison between clockO vectors is possible
+   * comparison between clock vectors is possible
    * even as actors become enabled and disabled
    *
-   * @return uint32_t the number of elements in
-   * the clock vector
+   * @return the number of elements in the clock vector
    */
-  size_t size() const { return this->contents_.size(); }
+  size_t size() const { return size_; }
 
+  /**
+   * @brief Retrieves a modifiable reference to the value mapped to the given actor, mapping it to `-1` first if needed
+   *
+   * The reference is only valid until this clock vector gets copied or modified again
+   */
   long& operator[](aid_t aid)
   {
-    // NOTE: The `operator[]` overload of
-    // unordered_map will create a new key-value
-    // pair if `tid` does not exist and will use
-    // a _default_ value for the value (0 in this case)
-    // which is precisely what we want here
     if (aid < 0)
       return negative_value;
-    if ((unsigned)aid >= contents_.size()) {
-      this->contents_.resize(aid + 1, -1);
-      max_size = aid + 1;
-      return this->contents_[aid];
+    if ((unsigned)aid >= size_) {
+      size_ = aid + 1;
+      chunks_.resize((size_ + chunk_size - 1) / chunk_size);
     }
-    return this->contents_[aid];
+    return own_chunk(aid / chunk_size)[aid % chunk_size];
   }
 
   /**
@@ -107,9 +136,10 @@ public:
   {
     if (aid < 0)
       return std::nullopt;
-    if ((unsigned)aid >= contents_.size())
+    if ((unsigned)aid >= size_)
       return std::nullopt;
-    return contents_[aid];
+    const auto& chunk = chunks_[aid / chunk_size];
+    return chunk == nullptr ? -1 : (*chunk)[aid % chunk_size];
   }
 
   /**
@@ -144,12 +174,29 @@ public:
    */
   static ClockVector max(const ClockVector& cv1, const ClockVector& cv2);
 
-  inline void static max_emplace_left(ClockVector& cv1, const ClockVector& cv2)
+  /** @brief Sets each component of `cv1` to the maximum of its value in `cv1` and in `cv2`
+   *
+   * The chunks that `cv2` shares with `cv1` or that are missing in `cv2` are skipped, and the ones that are larger in
+   * `cv2` than in `cv1` get shared instead of copied.
+   */
+  static void max_emplace_left(ClockVector& cv1, const ClockVector& cv2);
+
+  /** @brief Calls `f(aid, value)` for each component whose value is larger in this clock vector than in `other`
+   *
+   * The chunks that both clock vectors share are skipped.
+   */
+  template <class F> void for_each_larger_than(const ClockVector& other, F f) const
   {
-    if (cv1.size() < cv2.size())
-      cv1.contents_.resize(cv2.size(), -1);
-    std::transform(cv2.begin(), cv2.end(), cv1.contents_.begin(), cv1.contents_.begin(),
-                   [](int a, int b) { return std::max(a, b); });
+    for (size_t i = 0; i < chunks_.size(); i++) {
+      const auto& chunk = chunks_[i];
+      if (chunk == nullptr || (i < other.chunks_.size() && chunk == other.chunks_[i]))
+        continue;
+      for (size_t j = 0; j < chunk_size; j++) {
+        const aid_t aid = i * chunk_size + j;
+        if ((*chunk)[j] > other.get(aid).value_or(-1))
+          f(aid, (*chunk)[j]);
+      }
+    }
   }
 };
 
@@ -84,16 +84,27 @@ RemoteApp::RemoteApp(const std::vector<char*>& args) : app_args_(args)
   }
 }
 
+RemoteApp::RemoteApp(RemoteApp& master, std::unique_ptr<CheckerSide> checker_side)
+    : checker_side_(std::move(checker_side))
+    , master_(&master)
+    , master_socket_(master.master_socket_)
+    , app_args_(master.app_args_)
+{
+  xbt_assert(not _sg_mc_nofork, "Cannot create a secondary RemoteApp in nofork mode");
+}
+
 void RemoteApp::restore_checker_side(CheckerSide* from, bool finalize_app)
 {
   XBT_DEBUG("Restore the checker side");
 
+  actors_status_.reset();
   if (checker_side_ and finalize_app)
     checker_side_->finalize(true);
   if (_sg_mc_nofork) {
     checker_side_ = std::make_unique<simgrid::mc::CheckerSide>(app_args_);
   } else if (from == nullptr) {
-    checker_side_ = application_factory_->clone(master_socket_, master_socket_name);
+    const auto& factory = master_ != nullptr ? master_->application_factory_ : application_factory_;
+    checker_side_       = factory->clone(master_socket_, master_socket_name);
   } else {
     checker_side_ = from->clone(master_socket_, master_socket_name);
   }
@@ -118,6 +129,16 @@ unsigned long RemoteApp::get_maxpid() const
   return answer->value;
 }
 
+std::pair<uint64_t, uint64_t> RemoteApp::get_state_fingerprint() const
+{
+  checker_side_->get_channel().send(MessageType::STATE_FINGERPRINT);
+
+  auto* answer = (s_mc_message_fingerprint_t*)checker_side_->get_channel().expect_message(
+      sizeof(s_mc_message_fingerprint_t), MessageType::STATE_FINGERPRINT_REPLY, "Could not receive message");
+
+  return {answer->hash, answer->check};
+}
+
 void RemoteApp::get_actors_status(std::map<aid_t, ActorState>& whereto) const
 {
   // The messaging happens as follows:
@@ -131,6 +152,11 @@ void RemoteApp::get_actors_status(std::map<aid_t, ActorState>& whereto) const
   // Note that we also receive disabled transitions, because the guiding strategies need them to decide what could
   // unlock actors.
 
+  if (actors_status_.has_value()) {
+    whereto = *actors_status_;
+    return;
+  }
+
   if (not checker_side_->get_one_way()) {
     s_mc_message_actors_status_t msg = {MessageType::ACTORS_STATUS,
                                         Exploration::get_instance()->need_actor_status_transitions()};
@@ -190,6 +216,13 @@ void RemoteApp::get_actors_status(std::map<aid_t, ActorState>& whereto) const
   }
 }
 
+void RemoteApp::prefetch_actors_status()
+{
+  std::map<aid_t, ActorState> status;
+  get_actors_status(status);
+  actors_status_ = std::move(status);
+}
+
 bool RemoteApp::check_deadlock(bool verbose) const
 {
 
@@ -231,18 +264,21 @@ Transition* RemoteApp::handle_simcall(aid_t aid, int times_considered, bool new_
 {
   XBT_DEBUG("Handle simcall of pid %d (time considered: %d; %s)", (int)aid, times_considered,
             (new_transition ? "newly considered -- not replay" : "replay"));
+  actors_status_.reset();
 
   return checker_side_->handle_simcall(aid, times_considered, new_transition);
 }
 
 void RemoteApp::replay_sequence(std::deque<std::pair<aid_t, int>> to_replay)
 {
+  actors_status_.reset();
   checker_side_->handle_replay(to_replay);
 }
 
 void RemoteApp::finalize_app(bool terminate_asap)
 {
   XBT_DEBUG("Finalize the application");
+  actors_status_.reset();
   checker_side_->finalize(terminate_asap);
 }
 
@@ -10,6 +10,8 @@
 #include "src/mc/api/ActorState.hpp"
 #include "src/mc/remote/CheckerSide.hpp"
 
+#include <optional>
+
 namespace simgrid::mc {
 
 /** High-level view of the verified application, from the model-checker POV
@@ -24,8 +26,12 @@ class XBT_PUBLIC RemoteApp {
 private:
   std::unique_ptr<CheckerSide> checker_side_;
   std::unique_ptr<CheckerSide> application_factory_; // create checker_side_ by cloning this one
+  RemoteApp* master_ = nullptr; // If not null, we are a secondary RemoteApp using the factory of that one
   int master_socket_ = -1;
 
+  // Status of the actors at the current point of the application, if it was prefetched
+  std::optional<std::map<aid_t, ActorState>> actors_status_;
+
   const std::vector<char*> app_args_;
 
   // No copy:
@@ -42,6 +48,12 @@ public:
    */
   explicit RemoteApp(const std::vector<char*>& args);
 
+  /** Create a secondary session, driving the given checker side (usually obtained with master.clone_checker_side()).
+   *
+   *  The resulting RemoteApp restores its application from the factory of the master, so that several parts of the
+   *  exploration graph can be explored in parallel. */
+  RemoteApp(RemoteApp& master, std::unique_ptr<CheckerSide> checker_side);
+
   /** Rollback the application to the state passed as argument or to the beginning of history if from == nullptr */
   void restore_checker_side(CheckerSide* from, bool finalize_app = true);
   /** Make a clone of the checker side. The application is forked. */
@@ -58,11 +70,18 @@ public:
   /** Ask the application to run post-mortem analysis, and maybe to stop ASAP */
   void finalize_app(bool terminate_asap = false);
 
+  /** Retrieve the fingerprint of the application state (see MC_declare_state()), as a hash and a second
+   *  independent hash to detect the collisions of the first one */
+  std::pair<uint64_t, uint64_t> get_state_fingerprint() const;
+
   /** Retrieve the max PID of the running actors */
   unsigned long get_maxpid() const;
 
   /* Get the list of actors that are ready to run at that step. Usually shorter than maxpid */
   void get_actors_status(std::map<aid_t, simgrid::mc::ActorState>& whereto) const;
+  /** Retrieve the status of the actors now, so that the next get_actors_status() does not talk to the application.
+   *  The prefetched status is forgotten as soon as the application moves. */
+  void prefetch_actors_status();
 
   /** Take a transition. A new Transition is created iff the last parameter is true */
   Transition* handle_simcall(aid_t aid, int times_considered, bool new_transition);
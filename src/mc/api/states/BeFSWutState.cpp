@@ -13,6 +13,7 @@
 #include "src/mc/explo/odpor/odpor_forward.hpp"
 #include "src/mc/mc_config.hpp"
 #include "src/mc/mc_forward.hpp"
+#include "src/mc/transition/DependencyOracle.hpp"
 #include "src/mc/transition/Transition.hpp"
 #include "xbt/asserts.h"
 #include "xbt/log.h"
@@ -36,7 +37,7 @@ BeFSWutState::BeFSWutState(RemoteApp& remote_app, StatePtr parent_state) : WutSt
 {
   auto parent = static_cast<BeFSWutState*>(parent_state.get());
   for (const auto& transition : parent->done_) {
-    if (not get_transition_in()->depends(transition.get()))
+    if (not DependencyOracle::depends(get_transition_in().get(), transition.get()))
       sleep_add_and_mark(transition);
   }
 
@@ -5,6 +5,7 @@
 
 #include "src/mc/api/states/SleepSetState.hpp"
 #include "src/mc/api/RemoteApp.hpp"
+#include "src/mc/transition/DependencyOracle.hpp"
 #include "xbt/log.h"
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(mc_sleepset, mc_state, "DFS exploration algorithm of the model-checker");
@@ -20,7 +21,7 @@ SleepSetState::SleepSetState(RemoteApp& remote_app, StatePtr parent_state) : Sta
    * And if we kept it and the actor is enabled in this state, mark the actor as already done, so that
    * it is not explored*/
   for (const auto& [aid, transition] : static_cast<SleepSetState*>(parent_state.get())->get_sleep_set()) {
-    if (not get_transition_in()->depends(transition.get()))
+    if (not DependencyOracle::depends(get_transition_in().get(), transition.get()))
       sleep_add_and_mark(transition);
   }
 
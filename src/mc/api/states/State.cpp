@@ -17,8 +17,8 @@ XBT_LOG_NEW_DEFAULT_SUBCATEGORY(mc_state, mc, "Logging specific to MC states");
 
 namespace simgrid::mc {
 
-long State::expended_states_  = 0;
-long State::in_memory_states_ = 0;
+std::atomic<long> State::expended_states_  = 0;
+std::atomic<long> State::in_memory_states_ = 0;
 
 State::~State()
 {
@@ -91,21 +91,38 @@ std::shared_ptr<Transition> State::execute_next(aid_t next, RemoteApp& app)
 
   // 1. Identify the appropriate ActorState to prepare for execution
   // when simcall_handle will be called on it
+  const unsigned times_considered = consider_next(next);
+
+  // 2. Execute the actor according to the preparation above
+  auto* just_executed = app.handle_simcall(next, times_considered, true);
+
+  // 3. Update the state with the newest information
+  auto executed_transition = record_execution(next, times_considered, just_executed);
+  app.wait_for_requests();
+
+  return executed_transition;
+}
+
+unsigned State::consider_next(aid_t next)
+{
   auto& actor_state               = actors_to_run_.at(next);
   const unsigned times_considered = actor_state.do_consider();
-  const Transition* expected_executed_transition = nullptr;
   if (_sg_mc_debug) {
-    expected_executed_transition = actor_state.get_transition(times_considered).get();
     xbt_assert(actor_state.is_enabled(), "Tried to execute a disabled actor");
-    xbt_assert(expected_executed_transition != nullptr,
+    xbt_assert(actor_state.get_transition(times_considered) != nullptr,
                "Expected a transition with %u times considered to be noted in actor %ld", times_considered, next);
   }
   XBT_DEBUG("Let's run actor %ld (times_considered = %u)", next, times_considered);
 
-  // 2. Execute the actor according to the preparation above
   Transition::executed_transitions_++;
-  auto* just_executed = app.handle_simcall(next, times_considered, true);
+  return times_considered;
+}
+
+std::shared_ptr<Transition> State::record_execution(aid_t next, unsigned times_considered, Transition* just_executed)
+{
+  auto& actor_state = actors_to_run_.at(next);
   if (_sg_mc_debug) {
+    const Transition* expected_executed_transition = actor_state.get_transition(times_considered).get();
     xbt_assert(
         just_executed->type_ == expected_executed_transition->type_,
         "The transition that was just executed by actor %ld, viz:\n"
@@ -119,8 +136,7 @@ std::shared_ptr<Transition> State::execute_next(aid_t next, RemoteApp& app)
         "If adding this parameter does not help, then it's probably a bug in Mc SimGrid itself. Please report it.\n",
         next, just_executed->to_string().c_str(), expected_executed_transition->to_string().c_str());
   }
-  // 3. Update the state with the newest information. This means recording
-  // both
+  // Record both
   //  1. what action was last taken from this state (viz. `executed_transition`)
   //  2. what action actor `next` was able to take given `times_considered`
   // The latter update is important as *more* information is potentially available
@@ -129,7 +145,6 @@ std::shared_ptr<Transition> State::execute_next(aid_t next, RemoteApp& app)
 
   if (Exploration::get_instance()->need_actor_status_transitions())
     actor_state.set_transition(outgoing_transition_, times_considered);
-  app.wait_for_requests();
 
   return outgoing_transition_;
 }
@@ -20,9 +20,9 @@ class XBT_PUBLIC State : public xbt::Extendable<State> {
   friend XBT_PUBLIC void intrusive_ptr_add_ref(State* activity);
   friend XBT_PUBLIC void intrusive_ptr_release(State* activity);
 
-  static long expended_states_; /* Count total amount of states, for stats */
+  static std::atomic<long> expended_states_; /* Count total amount of states, for stats */
 
-  static long in_memory_states_; // Count the number of states currently still in memory
+  static std::atomic<long> in_memory_states_; // Count the number of states currently still in memory
 
   /** A forked application stationned in this state, to quickly recreate child states w/o replaying from the beginning
    */
@@ -72,6 +72,14 @@ public:
    */
   std::shared_ptr<Transition> execute_next(aid_t next, RemoteApp& app);
 
+  /* The two halves of execute_next(), around the actual execution of the transition in the application. They are used
+   * separately by the parallel explorer, which must not talk to the application while holding the exploration tree. */
+
+  /** Mark the actor 'next' as considered once more, and return the times_considered to execute it with */
+  unsigned consider_next(aid_t next);
+  /** Record that the actor 'next' left this state by executing 'just_executed' */
+  std::shared_ptr<Transition> record_execution(aid_t next, unsigned times_considered, Transition* just_executed);
+
   long get_num() const { return num_; }
   unsigned long get_depth() const { return depth_; }
   std::size_t count_todo() const;
@@ -99,6 +107,13 @@ public:
     return count;
   }
 
+  /** Mark every actor as done, so that nothing gets explored from this state (because it was already visited) */
+  void mark_all_done()
+  {
+    for (auto& [_, actor] : actors_to_run_)
+      actor.mark_done();
+  }
+
   bool is_actor_done(aid_t actor) const { return actors_to_run_.at(actor).is_done(); }
   std::shared_ptr<Transition> get_transition_out() const { return outgoing_transition_; }
   std::shared_ptr<Transition> get_transition_in() const { return incoming_transition_; }
@@ -32,7 +32,6 @@
 #include <cstdio>
 
 #include <algorithm>
-#include <filesystem>
 #include <limits>
 #include <memory>
 #include <string>
@@ -97,6 +96,7 @@ void BeFSExplorer::run()
   on_exploration_start_signal(get_remote_app());
 
   auto initial_state = reduction_algo_->state_create(get_remote_app());
+  visited_states_.visit(*initial_state, get_remote_app());
 
   XBT_DEBUG("**************************************************");
 
@@ -209,20 +209,7 @@ void BeFSExplorer::run()
     /* Create the new expanded state (copy the state of MCed into our MCer data) */
     auto next_state = reduction_algo_->state_create(get_remote_app(), state);
 
-    if (_sg_mc_cached_states_interval > 0 && next_state->get_num() % _sg_mc_cached_states_interval == 0) {
-      static unsigned max_files = sysconf(_SC_OPEN_MAX);
-
-      // Save 100 FDs for when we want to restart an old fork: we need a new socket for it
-      if (CheckerSide::get_count() > max_files - 100) {
-        // For now, each CheckerSide takes 4 FDs, and we have about 12 FDs before creating the first CheckerSide
-        int cur_files =
-            std::distance(std::filesystem::directory_iterator("/proc/self/fd"), std::filesystem::directory_iterator{});
-        XBT_CRITICAL("Skipping a cached state because the amount of open files is too high: %d open files out of %u. "
-                     "Please increase the max with `ulimit -n <value>` to improve the performances.",
-                     (int)cur_files, max_files);
-      } else
-        next_state->set_state_factory(get_remote_app().clone_checker_side());
-    }
+    checkpoints_.on_state_creation(next_state, get_remote_app());
     on_state_creation_signal(next_state.get(), get_remote_app());
 
     visited_states_count_++;
@@ -240,6 +227,11 @@ void BeFSExplorer::run()
     if (dot_output_ != nullptr)
       dot_output("\"%ld\" -> \"%ld\" [%s];\n", state->get_num(), stack_.back()->get_num(),
                  state->get_transition_out()->dot_string().c_str());
+
+    if (visited_states_.visit(*stack_.back(), get_remote_app())) {
+      XBT_VERB("State %ld was already visited. Do not explore it again.", stack_.back()->get_num());
+      stack_.back()->mark_all_done();
+    }
   }
   log_state();
 }
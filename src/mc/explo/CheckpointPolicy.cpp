@@ -0,0 +1,170 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/mc/explo/CheckpointPolicy.hpp"
+#include "src/mc/api/states/State.hpp"
+#include "src/mc/mc_config.hpp"
+#include "src/mc/remote/CheckerSide.hpp"
+#include "xbt/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <unistd.h>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(mc_checkpoint, mc, "Placement of the state factories of the model-checker");
+
+namespace simgrid::mc {
+
+static simgrid::config::Flag<std::string> cfg_checkpoint_policy{
+    "model-check/checkpoint-policy",
+    "How to decide which states get a state factory, to restore them without replaying from the beginning",
+    "interval",
+    {{"interval", "Every model-check/cached-states-interval states."},
+     {"adaptive", "When forking the application is cheaper than replaying up to the state, given the measured costs "
+                  "of both operations."}}};
+
+/* Weight of the new measures in the running estimates of the costs */
+static constexpr double cost_smoothing = 1.0 / 8;
+
+static void update_estimate(double& estimate, double measure)
+{
+  if (estimate < 0)
+    estimate = measure;
+  else
+    estimate += (measure - estimate) * cost_smoothing;
+}
+
+/* Save 100 FDs for when we want to restart an old fork: we need a new socket for it */
+bool CheckpointPolicy::out_of_files()
+{
+  static const long max_files = sysconf(_SC_OPEN_MAX);
+  return CheckerSide::get_count() + 100 > static_cast<unsigned long>(max_files);
+}
+
+CheckpointPolicy::CheckpointPolicy() : adaptive_(cfg_checkpoint_policy.get() == "adaptive") {}
+
+/* A factory costs a fork now, and about as much later to get rid of the forked process */
+static constexpr double factory_cost_factor = 2;
+
+bool CheckpointPolicy::worth_it(unsigned long gap) const
+{
+  return fork_cost_ >= 0 && replay_cost_ >= 0 &&
+         static_cast<double>(gap) * replay_cost_ >= factory_cost_factor * fork_cost_;
+}
+
+void CheckpointPolicy::on_state_creation(const StatePtr& state, RemoteApp& remote_app)
+{
+  // The adaptive policy waits for the exploration to come back to a state before forking it: most states are never
+  // restored, so forking them on creation costs more than the replays it saves
+  if (adaptive_ || _sg_mc_cached_states_interval <= 0 || state->get_num() % _sg_mc_cached_states_interval != 0)
+    return;
+
+  if (out_of_files()) {
+    // For now, each CheckerSide takes 4 FDs, and we have about 12 FDs before creating the first CheckerSide
+    int cur_files =
+        std::distance(std::filesystem::directory_iterator("/proc/self/fd"), std::filesystem::directory_iterator{});
+    XBT_CRITICAL("Skipping a cached state because the amount of open files is too high: %d open files out of %ld. "
+                 "Please increase the max with `ulimit -n <value>` to improve the performances.",
+                 cur_files, sysconf(_SC_OPEN_MAX));
+  } else
+    state->set_state_factory(remote_app.clone_checker_side());
+}
+
+void CheckpointPolicy::on_restore(State* target, RemoteApp& remote_app, State* from, size_t replayed,
+                                  double restore_time, double replay_time)
+{
+  if (not adaptive_)
+    return;
+
+  in_use_ = from;
+  if (auto it = checkpoints_.find(from); it != checkpoints_.end())
+    it->second.hits++;
+
+  // Restoring is mainly about forking the factory, so it measures the cost of a fork
+  update_estimate(fork_cost_, restore_time);
+  if (replayed > 0) {
+    const auto x = static_cast<double>(replayed);
+    replays_ += 1;
+    sum_x_ += x;
+    sum_y_ += replay_time;
+    sum_xx_ += x * x;
+    sum_xy_ += x * replay_time;
+    // The slope of the least squares fit, or the mean cost while all replays had the same length
+    const double variance = replays_ * sum_xx_ - sum_x_ * sum_x_;
+    const double slope    = variance > 0 ? (replays_ * sum_xy_ - sum_x_ * sum_y_) / variance : -1;
+    replay_cost_          = slope > 0 ? slope : sum_y_ / sum_x_;
+  }
+
+  forget_dead_states();
+
+  // The exploration came back here, and will probably come back again for the other branches: save the replay next
+  // time if it was more expensive than a fork
+  if (not _sg_mc_nofork && not target->has_state_factory() && worth_it(replayed))
+    add(StatePtr(target), remote_app, replayed);
+}
+
+void CheckpointPolicy::forget_dead_states()
+{
+  bool changed = true;
+  while (changed) { // Freeing a state may free its parent, that may have a factory too
+    changed = false;
+    for (auto it = checkpoints_.begin(); it != checkpoints_.end();)
+      // The factory of the current application must survive, as it waits for its grandchild on our behalf
+      if (it->second.state->get_ref_count() == 1 && it->first != in_use_) {
+        it      = checkpoints_.erase(it);
+        changed = true;
+      } else
+        ++it;
+  }
+}
+
+bool CheckpointPolicy::make_room(double value)
+{
+  auto victim = checkpoints_.end();
+  for (auto it = checkpoints_.begin(); it != checkpoints_.end(); ++it)
+    if (it->first != in_use_ && (victim == checkpoints_.end() || it->second.value() < victim->second.value()))
+      victim = it;
+  if (victim == checkpoints_.end() || victim->second.value() >= value)
+    return false;
+
+  XBT_DEBUG("Evict the factory of state #%ld (gap: %lu, hits: %lu)", victim->first->get_num(), victim->second.gap,
+            victim->second.hits);
+  victim->first->set_state_factory(nullptr);
+  checkpoints_.erase(victim);
+  evicted_++;
+  return true;
+}
+
+void CheckpointPolicy::add(const StatePtr& state, RemoteApp& remote_app, unsigned long gap)
+{
+  forget_dead_states();
+  if (out_of_files() && not make_room(static_cast<double>(gap))) {
+    skipped_++;
+    return;
+  }
+
+  auto start   = std::chrono::steady_clock::now();
+  auto factory = remote_app.clone_checker_side();
+  if (factory == nullptr) // The application cannot fork anymore (it is going one way)
+    return;
+  update_estimate(fork_cost_, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+  XBT_DEBUG("Create a factory for state #%ld (gap: %lu)", state->get_num(), gap);
+  state->set_state_factory(std::move(factory));
+  checkpoints_.try_emplace(state.get(), Checkpoint{state, gap});
+  created_++;
+}
+
+void CheckpointPolicy::log_state()
+{
+  if (not adaptive_)
+    return;
+  XBT_INFO("%lu state factories created, %lu evicted, %lu skipped for lack of file descriptors (fork: %.3f ms, replay: "
+           "%.3f ms per transition)",
+           created_, evicted_, skipped_, std::max(fork_cost_, 0.0) * 1000, std::max(replay_cost_, 0.0) * 1000);
+}
+
+} // namespace simgrid::mc
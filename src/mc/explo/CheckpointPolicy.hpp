@@ -0,0 +1,77 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_MC_CHECKPOINT_POLICY_HPP
+#define SIMGRID_MC_CHECKPOINT_POLICY_HPP
+
+#include "src/mc/api/RemoteApp.hpp"
+#include "src/mc/mc_forward.hpp"
+
+#include <unordered_map>
+
+namespace simgrid::mc {
+
+/** Decides which states get a state factory (a forked application), to speed up the later restores.
+ *
+ * With model-check/checkpoint-policy:interval, a factory is created every model-check/cached-states-interval states.
+ *
+ * With model-check/checkpoint-policy:adaptive, the cost of forking the application and the cost of replaying one
+ * transition are measured during the exploration. When the exploration backtracks to a state, that state gets a factory
+ * if the replay needed to reach it cost more than forking. When the file descriptors run short, the factories that
+ * saved the least replays are evicted to make room for the new ones.
+ *
+ * This is only used by the explorers driving a single application, from a single thread.
+ */
+class CheckpointPolicy {
+  struct Checkpoint {
+    StatePtr state;
+    unsigned long gap;      // Amount of transitions replayed to reach that state before it got its factory
+    unsigned long hits = 0; // Amount of restores that used its factory
+    double value() const { return static_cast<double>(gap) * static_cast<double>(hits + 1); }
+  };
+  std::unordered_map<State*, Checkpoint> checkpoints_; // only used by the adaptive policy
+  State* in_use_ = nullptr; // The state whose factory the current application was forked from (nullptr: the root)
+
+  bool adaptive_;
+  // Running estimates of the costs, in seconds (negative until measured)
+  double fork_cost_   = -1;
+  double replay_cost_ = -1; // Per replayed transition, without the fixed cost of the round trip to the application
+  // Sums over the restores, to fit the replay time as a linear function of the amount of replayed transitions
+  double replays_ = 0;
+  double sum_x_   = 0;
+  double sum_y_   = 0;
+  double sum_xx_  = 0;
+  double sum_xy_  = 0;
+
+  unsigned long created_ = 0;
+  unsigned long evicted_ = 0;
+  unsigned long skipped_ = 0;
+
+  bool worth_it(unsigned long gap) const;
+  /** Drop the checkpoints of the states that nobody else references anymore */
+  void forget_dead_states();
+  /** Make room for a checkpoint saving that much replay, by evicting a less useful one. Returns false if none is. */
+  bool make_room(double value);
+  void add(const StatePtr& state, RemoteApp& remote_app, unsigned long gap);
+
+public:
+  CheckpointPolicy();
+
+  /** Called on each new state, while the application stands in that state */
+  void on_state_creation(const StatePtr& state, RemoteApp& remote_app);
+  /** Called after restoring the application to a state, by forking the factory of `from` (or of the initial state if
+   *  nullptr) in `restore_time` seconds, and then replaying `replayed` transitions in `replay_time` seconds */
+  void on_restore(State* target, RemoteApp& remote_app, State* from, size_t replayed, double restore_time,
+                  double replay_time);
+
+  void log_state();
+
+  /** Whether the file descriptors run too short to create another factory */
+  static bool out_of_files();
+};
+
+} // namespace simgrid::mc
+
+#endif
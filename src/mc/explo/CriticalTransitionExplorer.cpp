@@ -5,6 +5,7 @@
 
 #include "src/mc/explo/CriticalTransitionExplorer.hpp"
 #include "simgrid/forward.h"
+#include "src/mc/explo/CheckpointPolicy.hpp"
 #include "src/mc/explo/DFSExplorer.hpp"
 #include "src/mc/explo/odpor/Execution.hpp"
 #include "src/mc/explo/odpor/odpor_forward.hpp"
@@ -29,6 +30,7 @@
 #include <cstdio>
 
 #include <algorithm>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -68,6 +70,41 @@ void CriticalTransitionExplorer::log_stack()
   }
 }
 
+void CriticalTransitionExplorer::fork_checkpoints()
+{
+  if (_sg_mc_nofork)
+    return;
+
+  // The search stops at the deepest state already known to lead to a correct execution: only the states below are
+  // candidates
+  size_t first = stack_->size() - 1;
+  while (first > 0 && not(*stack_)[first]->has_correct_execution())
+    first--;
+
+  // Each candidate (and each of the backtracks while exploring its other branches) is restored from the factory above
+  // it. With one factory every sqrt(n) candidates, forking them costs one replay of the trace, and each restore replays
+  // at most sqrt(n) transitions instead of its whole prefix.
+  const size_t candidates = stack_->size() - 1 - first;
+  const auto stride       = std::max<size_t>(2, std::lround(std::sqrt(candidates)));
+  size_t forked           = 0;
+  for (size_t depth = first + stride; depth < stack_->size(); depth += stride) {
+    State* state = (*stack_)[depth].get();
+    if (state->has_state_factory())
+      continue;
+    if (CheckpointPolicy::out_of_files()) {
+      XBT_VERB("Not enough file descriptors left to fork more checkpoints");
+      break;
+    }
+    backtrack_to_state(state);
+    auto factory = get_remote_app().clone_checker_side();
+    if (factory == nullptr) // The application cannot fork anymore
+      break;
+    state->set_state_factory(std::move(factory));
+    forked++;
+  }
+  XBT_VERB("Forked %zu checkpoints over the %zu candidates (one every %zu states)", forked, candidates, stride);
+}
+
 void CriticalTransitionExplorer::run()
 {
   XBT_INFO("Start the critical transition detection phase.");
@@ -86,6 +123,8 @@ void CriticalTransitionExplorer::run()
     stack_->pop_back();
     execution_seq_.remove_last_event();
   }
+  fork_checkpoints();
+
   while (stack_->size() > 1 and not stack_->back()->has_correct_execution()) {
     auto current_candidate = stack_->back()->get_transition_out();
 
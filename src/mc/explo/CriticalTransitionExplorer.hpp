@@ -39,6 +39,10 @@ private:
   // Display information about the exploration after it ended
   void log_end_exploration();
 
+  // Fork state factories along the candidates of the stack, in one replay of the failing trace, so that restoring a
+  // candidate does not replay its whole prefix
+  void fork_checkpoints();
+
 public:
   explicit CriticalTransitionExplorer(std::unique_ptr<RemoteApp> remote_app, ReductionMode mode, stack_t* stack);
   void run() override;
@@ -98,9 +98,7 @@ void DFSExplorer::step_exploration(odpor::Execution& S, aid_t next_actor, stack_
 
     next_state = reduction_algo_->state_create(get_remote_app(), state);
 
-    if (_sg_mc_cached_states_interval > 0 && next_state->get_num() % _sg_mc_cached_states_interval == 0) {
-      next_state->set_state_factory(get_remote_app().clone_checker_side());
-    }
+    checkpoints_.on_state_creation(next_state, get_remote_app());
   } catch (McWarning& error) {
     // If an error is reached while executing the transition ...
     if (XBT_LOG_ISENABLED(mc_dfs, xbt_log_priority_debug)) {
@@ -164,6 +162,8 @@ void DFSExplorer::step_exploration(odpor::Execution& S, aid_t next_actor, stack_
     } else {
       XBT_WARN("/!\\ Max depth reached ! /!\\ ");
     }
+  } else if (visited_states_.visit(*state_stack.back(), get_remote_app())) {
+    XBT_VERB("State %ld was already visited. Do not explore it again.", state_stack.back()->get_num());
   } else {
     explore(S, state_stack);
   }
@@ -219,6 +219,7 @@ void DFSExplorer::run()
 
   auto initial_state = reduction_algo_->state_create(get_remote_app());
   on_state_creation_signal(initial_state.get(), get_remote_app());
+  visited_states_.visit(*initial_state, get_remote_app());
 
   XBT_DEBUG("**************************************************");
 
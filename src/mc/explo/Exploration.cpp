@@ -13,12 +13,14 @@
 #include "src/mc/mc_environ.h"
 #include "src/mc/mc_exit.hpp"
 #include "src/mc/mc_private.hpp"
+#include "src/mc/transition/DependencyOracle.hpp"
 #include "src/mc/transition/Transition.hpp"
 #include "xbt/log.h"
 #include "xbt/random.hpp"
 #include "xbt/string.hpp"
 
 #include <algorithm>
+#include <chrono>
 #include <memory>
 #include <sys/wait.h>
 #include <utility>
@@ -41,6 +43,7 @@ xbt::signal<void(RemoteApp&)> Exploration::on_exploration_start_signal;
 xbt::signal<void(State*, RemoteApp&)> Exploration::on_state_creation_signal;
 xbt::signal<void(Transition*, RemoteApp&)> Exploration::on_transition_execute_signal;
 xbt::signal<void(RemoteApp&)> Exploration::on_log_state_signal;
+xbt::signal<void(ExitStatus, Exploration&)> Exploration::on_error_signal;
 
 Exploration::Exploration(std::unique_ptr<RemoteApp> remote_app) : remote_app_(std::move(remote_app))
 {
@@ -100,6 +103,9 @@ void Exploration::log_state()
   }
   if (_sg_mc_debug_soundness)
     odpor::MazurkiewiczTraces::log_data();
+  checkpoints_.log_state();
+  visited_states_.log_state();
+  DependencyOracle::log_state();
 }
 // Make our tests fully reproducible despite the subtle differences of strsignal() across archs
 static const char* signal_name(int status)
@@ -146,6 +152,7 @@ void Exploration::run_critical_exploration_on_need(ExitStatus error)
 
 XBT_ATTRIB_NORETURN void Exploration::report_crash(int status)
 {
+  const std::scoped_lock lock(report_lock_);
   if (is_looking_for_critical)
     // already looking for critical
     throw McWarning(ExitStatus::PROGRAM_CRASH);
@@ -167,6 +174,7 @@ XBT_ATTRIB_NORETURN void Exploration::report_crash(int status)
              "--cfg=model-check/replay:'%s'",
              get_record_trace().to_string().c_str());
     log_state();
+    on_error_signal(ExitStatus::PROGRAM_CRASH, *this);
   }
 
   errors_++;
@@ -184,6 +192,7 @@ XBT_ATTRIB_NORETURN void Exploration::report_crash(int status)
 
 XBT_ATTRIB_NORETURN void Exploration::report_assertion_failure()
 {
+  const std::scoped_lock lock(report_lock_);
   if (is_looking_for_critical)
     // already looking for critical
     throw McWarning(ExitStatus::SAFETY);
@@ -198,6 +207,7 @@ XBT_ATTRIB_NORETURN void Exploration::report_assertion_failure()
              "--cfg=model-check/replay:'%s'",
              get_record_trace().to_string().c_str());
     log_state();
+    on_error_signal(ExitStatus::SAFETY, *this);
   }
 
   // FIXME: this shouldn't be called errors, but smthing like "errors_nb_"
@@ -223,6 +233,7 @@ void Exploration::check_deadlock()
       return;
 
     errors_++;
+    on_error_signal(ExitStatus::DEADLOCK, *this);
     run_critical_exploration_on_need(ExitStatus::DEADLOCK);
 
     if (_sg_mc_max_errors >= 0 && errors_ > _sg_mc_max_errors) {
@@ -263,7 +274,14 @@ bool Exploration::soft_timouted() const
 
 void Exploration::backtrack_to_state(State* target_state, bool finalize_app)
 {
-  on_backtracking_signal(get_remote_app());
+  visited_states_count_ += restore_app_to_state(target_state, get_remote_app(), finalize_app, &checkpoints_);
+  backtrack_count_++;
+}
+
+size_t Exploration::restore_app_to_state(State* target_state, RemoteApp& remote_app, bool finalize_app,
+                                         CheckpointPolicy* checkpoints)
+{
+  on_backtracking_signal(remote_app);
 
   std::deque<Transition*> replay_recipe;
   std::deque<std::pair<aid_t, int>> recipe;
@@ -277,12 +295,13 @@ void Exploration::backtrack_to_state(State* target_state, bool finalize_app)
       root_state = state;
   }
 
+  auto start = std::chrono::steady_clock::now();
   if (state == nullptr) { /* restart from the root */
-    get_remote_app().restore_checker_side(nullptr, finalize_app);
-    on_restore_state_signal(*root_state, get_remote_app());
+    remote_app.restore_checker_side(nullptr, finalize_app);
+    on_restore_state_signal(*root_state, remote_app);
   } else { /* Found an intermediate restart point */
-    get_remote_app().restore_checker_side(state->get_state_factory(), finalize_app);
-    on_restore_state_signal(*state, get_remote_app());
+    remote_app.restore_checker_side(state->get_state_factory(), finalize_app);
+    on_restore_state_signal(*state, remote_app);
   }
 
   XBT_DEBUG("Sending sequence for a replay: %s",
@@ -290,16 +309,20 @@ void Exploration::backtrack_to_state(State* target_state, bool finalize_app)
               return std::move(a) + ';' + '<' + std::to_string(b.first) + '/' + std::to_string(b.second) + '>';
             }).c_str());
 
-  get_remote_app().replay_sequence(recipe);
+  auto restored = std::chrono::steady_clock::now();
+  remote_app.replay_sequence(recipe);
 
-  visited_states_count_ += recipe.size();
-  backtrack_count_++;
   Transition::replayed_transitions_ += recipe.size();
 
+  if (checkpoints != nullptr)
+    checkpoints->on_restore(target_state, remote_app, state, recipe.size(),
+                            std::chrono::duration<double>(restored - start).count(),
+                            std::chrono::duration<double>(std::chrono::steady_clock::now() - restored).count());
+
   for (auto& transition : replay_recipe)
-    on_transition_replay_signal(transition, get_remote_app());
+    on_transition_replay_signal(transition, remote_app);
 
-  return;
+  return recipe.size();
 }
 
 }; // namespace simgrid::mc
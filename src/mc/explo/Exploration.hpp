@@ -9,6 +9,8 @@
 #include "simgrid/forward.h"
 #include "src/mc/api/RemoteApp.hpp"
 #include "src/mc/api/Strategy.hpp"
+#include "src/mc/explo/CheckpointPolicy.hpp"
+#include "src/mc/explo/VisitedStates.hpp"
 #include "src/mc/mc_config.hpp"
 #include "src/mc/mc_exit.hpp"
 #include "src/mc/mc_record.hpp"
@@ -17,6 +19,8 @@
 #include <xbt/Extendable.hpp>
 
 #include <memory>
+#include <mutex>
+#include <optional>
 
 namespace simgrid::mc {
 
@@ -37,12 +41,12 @@ class Exploration : public xbt::Extendable<Exploration> {
   static std::unique_ptr<ExplorationStrategy> strategy_;
   static Exploration* instance_;
 
-  int errors_       = 0; // Amount of errors seen so far; tested against model-check/max-errors
-
   /** @brief Wether the current exploration is a CriticalTransitionExplorer */
   bool is_looking_for_critical = false;
 
 protected:
+  int errors_ = 0; // Amount of errors seen so far; tested against model-check/max-errors
+
   unsigned long backtrack_count_      = 0; // for statistics
   unsigned long visited_states_count_ = 0; // for statistics
 
@@ -50,6 +54,11 @@ protected:
 
   FILE* dot_output_ = nullptr;
 
+  /** Decides which of the explored states get a state factory */
+  CheckpointPolicy checkpoints_;
+  /** The states already explored, when the exploration is stateful */
+  VisitedStates visited_states_;
+
 public:
   explicit Exploration(const std::vector<char*>& args);
   explicit Exploration(std::unique_ptr<RemoteApp> remote_app);
@@ -94,6 +103,20 @@ public:
    */
   void backtrack_to_state(State* target_state, bool finalize_app = true);
 
+protected:
+  /** @brief Same as backtrack_to_state(), but on the given application. Returns the amount of replayed transitions.
+   *
+   * Used by the explorers that drive several applications at once, each of them on its own. The restore is reported to
+   * the checkpoint policy, if any.
+   */
+  static size_t restore_app_to_state(State* target_state, RemoteApp& remote_app, bool finalize_app = true,
+                                     CheckpointPolicy* checkpoints = nullptr);
+
+  /** Serializes the error reports of the explorers that run several threads at once */
+  std::mutex report_lock_;
+
+public:
+
   /* These methods are callbacks called by the model-checking engine
    * to get and display information about the current state of the
    * model-checking algorithm: */
@@ -123,6 +146,7 @@ public:
   static xbt::signal<void(State*, RemoteApp&)> on_state_creation_signal;
   static xbt::signal<void(Transition*, RemoteApp&)> on_transition_execute_signal;
   static xbt::signal<void(RemoteApp&)> on_log_state_signal;
+  static xbt::signal<void(ExitStatus, Exploration&)> on_error_signal;
 
   /** Called once when the exploration starts */
   static void on_exploration_start(std::function<void(RemoteApp& remote_app)> const& f)
@@ -141,6 +165,8 @@ public:
   }
   /** Called when displaying the statistics at the end of the exploration */
   static void on_log_state(std::function<void(RemoteApp&)> const& f) { on_log_state_signal.connect(f); }
+  /** Called each time that an error is found, once it is reported. The exploration still stands at the faulty trace */
+  static void on_error(std::function<void(ExitStatus, Exploration&)> const& f) { on_error_signal.connect(f); }
 
   /** Called when the state to which we backtrack was not checkpointed state, forcing us to restore the initial state
    * before replaying some transitions */
@@ -181,6 +207,9 @@ public:
 XBT_PUBLIC Exploration* create_dfs_exploration(const std::vector<char*>& args, ReductionMode mode);
 XBT_PUBLIC Exploration* create_befs_exploration(const std::vector<char*>& args, ReductionMode mode);
 XBT_PUBLIC Exploration* create_parallelized_exploration(const std::vector<char*>& args, ReductionMode mode);
+/** Forks the workers of a swarm exploration. In the workers, this sets their configuration and returns nothing, so that
+ *  they go on with their own exploration. In the initial process, this waits for the workers and returns the verdict. */
+XBT_PUBLIC std::optional<ExitStatus> run_swarm_exploration(ReductionMode mode);
 
 XBT_PUBLIC Exploration* create_communication_determinism_checker(const std::vector<char*>& args, ReductionMode mode);
 XBT_PUBLIC Exploration* create_udpor_checker(const std::vector<char*>& args);
@@ -5,6 +5,7 @@
 
 #include "src/mc/explo/ParallelizedExplorer.hpp"
 #include "src/mc/explo/odpor/Execution.hpp"
+#include "src/mc/explo/odpor/WakeupTree.hpp"
 #include "src/mc/mc_config.hpp"
 #include "src/mc/mc_exit.hpp"
 #include "src/mc/mc_forward.hpp"
@@ -22,279 +23,404 @@
 #include "xbt/asserts.h"
 #include "xbt/log.h"
 
-#include <cassert>
-#include <cstdio>
+#include <sys/resource.h>
 
 #include <algorithm>
 #include <exception>
-#include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <thread>
-#include <unordered_set>
 #include <vector>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(mc_parallel, mc, "Parallel exploration algorithm of the model-checker");
 
 namespace simgrid::mc {
 
-RecordTrace ParallelizedExplorer::get_record_trace() // override
+thread_local ParallelizedExplorer::Worker* ParallelizedExplorer::current_worker_ = nullptr;
+
+RecordTrace ParallelizedExplorer::get_record_trace_of(const Worker& worker) const
 {
   RecordTrace res;
+  for (auto iter = std::next(worker.stack.begin()); iter != worker.stack.end(); ++iter)
+    res.push_back((*iter)->get_transition_in().get());
+  if (worker.executing != nullptr)
+    res.push_back(worker.executing.get());
+  return res;
+}
 
-  if (const auto trans = stack_.back()->get_transition_out(); trans != nullptr)
-    res.push_back(trans.get());
-  for (const auto* state = stack_.back().get(); state != nullptr; state = state->get_parent_state())
-    if (state->get_transition_in() != nullptr)
-      res.push_front(state->get_transition_in().get());
+RecordTrace ParallelizedExplorer::get_record_trace() // override
+{
+  // Errors are reported from the thread of the worker that found them, or from the main thread once it's over
+  if (current_worker_ != nullptr)
+    return get_record_trace_of(*current_worker_);
+  if (failed_worker_ != nullptr)
+    return get_record_trace_of(*failed_worker_);
+  return {};
+}
 
-  return res;
+stack_t ParallelizedExplorer::get_stack() // override
+{
+  if (current_worker_ != nullptr)
+    return current_worker_->stack;
+  if (failed_worker_ != nullptr)
+    return failed_worker_->stack;
+  return {};
 }
 
-void ParallelizedExplorer::restore_stack(StatePtr state)
+void ParallelizedExplorer::restore_stack(Worker& worker, const StatePtr& state) const
 {
-  XBT_DEBUG("Going to restore stack. Current depth is %lu; chosen state is #%ld", stack_.size(), state->get_num());
-  stack_.clear();
-  execution_seq_     = odpor::Execution();
-  auto current_state = state;
-  stack_.emplace_front(current_state);
-  // condition corresponds to reaching initial state
-  while (current_state->get_parent_state() != nullptr) {
-    current_state = current_state->get_parent_state();
-    stack_.emplace_front(current_state);
-  }
-  XBT_DEBUG("Replaced stack by %s", get_record_trace().to_string().c_str());
-  // NOTE: The outgoing transition for the top-most state of the  stack refers to that which was taken
-  // as part of the last trace explored by the algorithm. Thus, only the sequence of transitions leading up to,
-  // but not including, the last state must be included when reconstructing the Exploration for SDPOR.
-  for (auto iter = std::next(stack_.begin()); iter != stack_.end(); ++iter) {
-    execution_seq_.push_transition((*iter)->get_transition_in());
-  }
+  worker.stack.clear();
+  worker.execution_seq = odpor::Execution();
+  for (auto* current_state = state.get(); current_state != nullptr; current_state = current_state->get_parent_state())
+    worker.stack.emplace_front(current_state);
+  for (auto iter = std::next(worker.stack.begin()); iter != worker.stack.end(); ++iter)
+    worker.execution_seq.push_transition((*iter)->get_transition_in());
 }
 
 void ParallelizedExplorer::log_state() // override
 {
   on_log_state_signal(get_remote_app());
-  XBT_INFO("BeFS exploration ended. %ld unique states visited; %lu explored traces (%lu transition replays, "
-           "%lu states "
-           "visited overall)",
-           State::get_expanded_states(), explored_traces_, Transition::get_replayed_transitions(),
-           visited_states_count_);
+  unsigned long explored_traces = 0;
+  unsigned long visited_states  = visited_states_count_;
+  {
+    const std::scoped_lock lock(tree_lock_);
+    for (auto const& worker : workers_) {
+      explored_traces += worker->explored_traces;
+      visited_states += worker->visited_states;
+    }
+  }
+  XBT_INFO("Parallel exploration ended. %ld unique states visited; %lu explored traces (%lu transition replays, "
+           "%lu states visited overall)",
+           State::get_expanded_states(), explored_traces, Transition::get_replayed_transitions(), visited_states);
   Exploration::log_state();
 }
 
 void ParallelizedExplorer::run()
 {
   on_exploration_start_signal(get_remote_app());
-  /* This function runs the Best First Search algorithm the state space.
-   * We do so iteratively instead of recursively, dealing with the call stack manually.
-   * This allows one to explore the call stack at will. */
-  try {
-    Explorer();
-  } catch (McError& error) {
-    XBT_CRITICAL("Going to kill the reducer");
-    reducer.std::thread::~thread();
-    throw error;
+
+  reducer_ = std::thread([this] { run_reducer(); });
+  for (auto& worker : workers_)
+    worker->thread = std::thread([this, w = worker.get()] { run_worker(*w); });
+  for (auto const& worker : workers_)
+    worker->thread.join();
+  {
+    const std::scoped_lock lock(race_jobs_lock_);
+    reducer_done_ = true;
   }
+  race_jobs_cv_.notify_all();
+  reducer_.join();
+
+  if (error_)
+    std::rethrow_exception(error_);
+  if (timeouted_)
+    XBT_INFO("Soft timeout after %d seconds. Gracefully exiting.", _sg_mc_soft_timeout.get());
   log_state();
 }
 
-StatePtr ParallelizedExplorer::best_opened_state()
+void ParallelizedExplorer::stop_on_error(Worker& worker, std::exception_ptr error)
 {
-  int best_prio = 0; // cache the value for the best priority found so far (initialized to silence gcc)
-  auto best     = end(opened_states_);   // iterator to the state to explore having the best priority
-  auto valid    = begin(opened_states_); // iterator marking the limit between states still to explore, and already
-                                         // explored ones
-
-  // Keep only still non-explored states (aid != -1), and record the one with the best (greater) priority.
-  for (auto current = begin(opened_states_); current != end(opened_states_); ++current) {
-    aid_t aid;
-    int prio;
-    if (current->get() == nullptr) {
-      aid  = 0;
-      prio = std::numeric_limits<int>::max();
-    } else {
-      aid  = (*current)->next_transition_guided().first;
-      prio = (*current)->next_transition_guided().second;
-    }
-    if (aid == -1)
-      continue;
-    if (valid != current) {
-      *valid = std::move(*current);
+  const std::scoped_lock lock(tree_lock_);
+  if (error_ == nullptr) {
+    error_         = std::move(error);
+    failed_worker_ = &worker;
+  }
+  stop_ = true;
+  tree_cv_.notify_all();
+}
+
+void ParallelizedExplorer::run_worker(Worker& worker)
+{
+  current_worker_ = &worker;
+  try {
+    aid_t next;
+    unsigned times_considered;
+    if (worker.id == 0) {
+      // The first worker starts from the root, with the application that was used to create it
+      std::unique_lock lock(tree_lock_);
+      if (plan_from(worker, lock, initial_state_, next, times_considered)) {
+        lock.unlock();
+        explore_from(worker, next, times_considered);
+        lock.lock();
+      }
+      pending_work_--;
+      tree_cv_.notify_all();
     }
-    if (best == end(opened_states_) || prio <= best_prio) {
-      best_prio = prio;
-      best      = valid;
+    while (take_opened_state(worker, next, times_considered)) {
+      explore_from(worker, next, times_considered);
+
+      const std::scoped_lock lock(tree_lock_);
+      pending_work_--;
+      tree_cv_.notify_all();
     }
-    ++valid;
+  } catch (const McError&) {
+    stop_on_error(worker, std::current_exception());
+  } catch (const McWarning&) {
+    stop_on_error(worker, std::current_exception());
+  }
+  current_worker_ = nullptr;
+}
+
+void ParallelizedExplorer::run_reducer()
+{
+  while (true) {
+    std::unique_lock lock(race_jobs_lock_);
+    race_jobs_cv_.wait(lock, [this] { return reducer_done_ || not race_jobs_.empty(); });
+    if (race_jobs_.empty()) // reducer_done_ and nothing left: we're done
+      return;
+    RaceJob job = std::move(race_jobs_.front());
+    race_jobs_.pop_front();
+    lock.unlock();
+
+    // The job (and the states it may be the last one to reference) is destroyed after the tree lock is released
+    const std::scoped_lock tree_lock(tree_lock_);
+    std::vector<StatePtr> opened_states;
+    auto updates = reduction_algo_->races_computation(job.execution_seq, &job.stack, &opened_states);
+    reduction_algo_->apply_race_update(std::move(updates), &opened_states);
+    for (auto& state : opened_states)
+      job.worker->opened_states.emplace_back(std::move(state));
+    pending_work_--;
+    tree_cv_.notify_all();
   }
+}
 
-  StatePtr best_state;
-  if (best < valid) {
-    // There are non-explored states, and one of them has the best priority.  Remove it from opened_states_ before
-    // returning.
-    best_state = std::move(*best);
-    --valid;
-    if (best != valid)
-      *best = std::move(*valid);
+StatePtr ParallelizedExplorer::pop_opened_state(Worker& worker)
+{
+  // States that were pushed several times or whose subtree got fully explored meanwhile have nothing left to offer
+  auto usable = [](const StatePtr& state) { return state->next_transition_guided().first != -1; };
+
+  // Take our own latest state first, as it is the closest to where we are
+  while (not worker.opened_states.empty()) {
+    StatePtr state = std::move(worker.opened_states.back());
+    worker.opened_states.pop_back();
+    if (usable(state))
+      return state;
   }
-  opened_states_.erase(valid, end(opened_states_));
 
-  return best_state;
+  // Otherwise, steal the oldest state of the most loaded worker: it's high in the tree and probably has a lot below it
+  while (true) {
+    Worker* victim = nullptr;
+    for (auto const& other : workers_)
+      if (not other->opened_states.empty() &&
+          (victim == nullptr || other->opened_states.size() > victim->opened_states.size()))
+        victim = other.get();
+    if (victim == nullptr)
+      return nullptr;
+
+    StatePtr state = std::move(victim->opened_states.front());
+    victim->opened_states.pop_front();
+    if (usable(state)) {
+      XBT_DEBUG("Worker %u steals state #%ld from worker %u", worker.id, state->get_num(), victim->id);
+      return state;
+    }
+  }
 }
 
-void ParallelizedExplorer::backtrack()
+std::shared_ptr<Transition> ParallelizedExplorer::pending_transition(const State* state, aid_t aid,
+                                                                     unsigned times_considered)
 {
-  XBT_VERB("Backtracking from %s", get_record_trace().to_string().c_str());
-  XBT_DEBUG("%lu alternatives are yet to be explored:", opened_states_.size());
+  // The transitions of the actors are only known when the reduction asks for them, but this one may have been taken
+  // from that state before
+  if (need_actor_status_transitions())
+    return state->get_actors_list().at(aid).get_transition(times_considered);
+  if (auto const& previous = state->get_transition_out();
+      previous != nullptr && previous->aid_ == aid && previous->times_considered_ == (int)times_considered)
+    return previous;
+  return std::make_shared<Transition>(Transition::Type::UNKNOWN, aid, times_considered);
+}
 
-  Exploration::check_deadlock();
+bool ParallelizedExplorer::plan_from(Worker& worker, std::unique_lock<std::mutex>& lock, const StatePtr& state,
+                                     aid_t& next, unsigned& times_considered)
+{
+  lock.unlock();
+  restore_stack(worker, state);
+  lock.lock();
+
+  next = reduction_algo_->next_to_explore(worker.execution_seq, &worker.stack);
+  if (next < 0)
+    return false;
+  xbt_assert(state->is_actor_enabled(next));
+  times_considered = state->consider_next(next);
+  worker.executing = pending_transition(state.get(), next, times_considered);
+  return true;
+}
 
-  // Take the point with smallest distance
-  std::unique_lock<std::mutex> lock_oh(opened_heads_lock_);
-  opened_heads_cv_.wait(lock_oh, [&] { return opened_states_.size() > 1; });
-  auto backtracking_point = best_opened_state();
-  lock_oh.unlock();
+bool ParallelizedExplorer::take_opened_state(Worker& worker, aid_t& next, unsigned& times_considered)
+{
+  std::unique_lock lock(tree_lock_);
+  while (true) {
+    if (stop_)
+      return false;
+    if (soft_timouted()) {
+      stop_ = timeouted_ = true;
+      tree_cv_.notify_all();
+      return false;
+    }
 
-  // if no backtracking point, then set the stack_ to empty so we can end the exploration
-  if (not backtracking_point) {
-    XBT_DEBUG("No more opened point of exploration, the search will end");
-    stack_.clear();
-    return;
+    if (StatePtr state = pop_opened_state(worker)) {
+      // The state is ours from now on, so the exploration cannot be considered over until we're done with it
+      pending_work_++;
+      if (plan_from(worker, lock, state, next, times_considered))
+        return true;
+      // Someone else took the last transition of that state in the meanwhile
+      pending_work_--;
+      continue;
+    }
+
+    if (pending_work_ == 0) { // Nothing left to explore, and nobody can produce more work: the exploration is over
+      tree_cv_.notify_all();
+      return false;
+    }
+    tree_cv_.wait(lock);
   }
-  // We found a backtracking point, let's go to it
-  backtrack_to_state(backtracking_point.get());
-  this->restore_stack(backtracking_point);
 }
 
-void ParallelizedExplorer::Explorer()
+void ParallelizedExplorer::explore_from(Worker& worker, aid_t next, unsigned times_considered)
 {
-  while (not stack_.empty()) {
-    /* Get current state */
-    auto state = stack_.back();
+  auto& remote_app = *worker.remote_app;
 
-    XBT_DEBUG("**************************************************");
-    XBT_DEBUG("Exploration depth=%zu (state:#%ld; %zu interleaves todo; %lu currently opened states)", stack_.size(),
-              state->get_num(), state->count_todo(), opened_states_.size());
+  if (not worker.at_initial_state || worker.stack.size() > 1) {
+    const size_t replayed = restore_app_to_state(worker.stack.back().get(), remote_app, not worker.app_crashed);
+    const std::scoped_lock lock(tree_lock_);
+    worker.visited_states += replayed;
+  }
+  worker.at_initial_state = false;
+  worker.app_crashed      = false;
 
-    // Backtrack if we reached the maximum depth
-    if (stack_.size() > (std::size_t)_sg_mc_max_depth) {
-      XBT_WARN("/!\\ Max depth of %d reached! THIS WILL PROBABLY BREAK the reduction /!\\", _sg_mc_max_depth.get());
-      XBT_WARN("/!\\ Any bug you may find are real, but not finding bug doesn't mean anything /!\\");
-      XBT_WARN("/!\\ You should consider changing the depth limit with --cfg=model-check/max-depth /!\\");
-      XBT_WARN("/!\\ Asumming you know what you are doing, the programm will now backtrack /!\\");
-      this->backtrack();
-      continue;
+  while (true) {
+    auto state = worker.stack.back();
+
+    /* Actually answer the request: let's execute the selected request (MCed does one step), without the tree lock */
+    Transition* just_executed;
+    try {
+      just_executed = remote_app.handle_simcall(next, times_considered, true);
+      remote_app.wait_for_requests();
+      remote_app.prefetch_actors_status();
+    } catch (const McWarning&) {
+      // The error was reported already. Unless it ends the exploration, go on with another trace
+      if (_sg_mc_max_errors == 0)
+        throw;
+      worker.executing   = nullptr;
+      worker.app_crashed = true;
+      const std::scoped_lock lock(tree_lock_);
+      if (state->has_more_to_be_explored())
+        worker.opened_states.emplace_back(state);
+      return;
     }
 
-    // Search for the next transition
-    // next_transition returns a pair<aid_t, int>
-    // in case we want to consider multiple states (eg. during backtrack)
-    const aid_t next = reduction_algo_->next_to_explore(execution_seq_, &stack_);
-
-    if (next < 0) {
-
-      // If there is no more transition in the current state (or if ODPOR picked an actor that is not enabled --
-      // ReversibleRace is an overapproximation), backtrace
-      XBT_VERB("%lu actors remain, but none of them need to be interleaved (depth %zu).", state->get_actor_count(),
-               stack_.size() + 1);
-      Exploration::check_deadlock();
-
-      if (state->get_actor_count() == 0) {
-        // Compute the race when reaching a leaf, and pass them to the Reductor through the dedicated queue
-        std::unique_ptr<Reduction::RaceUpdate> todo_updates =
-            reduction_algo_->races_computation(execution_seq_, &stack_, &opened_states_);
-        std::unique_lock<std::mutex> lock_ru(race_updates_lock_);
-        race_updates_.push_back(std::move(todo_updates));
-        lock_ru.unlock();
-        race_updates_cv_.notify_one();
-
-        explored_traces_++;
-        get_remote_app().finalize_app();
-        XBT_VERB("Execution came to an end at %s", get_record_trace().to_string().c_str());
-        XBT_VERB("(state: %ld, depth: %zu, %lu explored traces)", state->get_num(), stack_.size(), explored_traces_);
-        report_correct_execution(state.get());
-      }
-
-      this->backtrack();
-      continue;
+    std::unique_ptr<CheckerSide> state_factory;
+    if (_sg_mc_cached_states_interval > 0 && (worker.visited_states + 1) % _sg_mc_cached_states_interval == 0) {
+      static const rlim_t max_files = [] {
+        struct rlimit limit;
+        getrlimit(RLIMIT_NOFILE, &limit);
+        return limit.rlim_cur;
+      }();
+      if (CheckerSide::get_count() + 100 < max_files)
+        state_factory = remote_app.clone_checker_side();
     }
 
-    xbt_assert(state->is_actor_enabled(next));
+    std::unique_lock lock(tree_lock_);
+    auto executed_transition = state->record_execution(next, times_considered, just_executed);
+    on_transition_execute_signal(executed_transition.get(), remote_app);
 
-    // If we use a state containing a sleep state, display it during debug
-    if (XBT_LOG_ISENABLED(mc_parallel, xbt_log_priority_verbose) && reduction_mode_ != ReductionMode::none) {
-      auto sleep_state = static_cast<SleepSetState*>(state.get());
-      if (not sleep_state->get_sleep_set().empty()) {
-        XBT_VERB("Sleep set actually containing:");
+    /* Create the new expanded state (copy the state of MCed into our MCer data) */
+    const long expanded_before = State::get_expanded_states();
+    auto next_state            = reduction_algo_->state_create(remote_app, state);
+    // The reduction may give us back an existing state, that does not need (nor should get) our factory
+    if (state_factory != nullptr && next_state->get_num() > expanded_before)
+      next_state->set_state_factory(std::move(state_factory));
+    on_state_creation_signal(next_state.get(), remote_app);
+    worker.visited_states++;
 
-        for (const auto& [aid, transition] : sleep_state->get_sleep_set())
-          XBT_VERB("  <%ld,%s>", aid, transition->to_string().c_str());
-      }
+    reduction_algo_->on_backtrack(state.get());
+
+    // Before leaving that state, if the transition we just took can be taken multiple times, we
+    // need to give it to the opened states
+    if (state->has_more_to_be_explored()) {
+      worker.opened_states.emplace_back(state);
+      tree_cv_.notify_one();
     }
 
-    auto todo = state->get_actors_list().at(next).get_transition();
-    XBT_DEBUG("wanna execute %ld: %.60s", next, todo->to_string().c_str());
+    XBT_VERB("[%u] Executed %ld: %.60s (stack depth: %zu, state: %ld, %zu interleaves, %zu opened states)", worker.id,
+             executed_transition->aid_, executed_transition->to_string().c_str(), worker.stack.size(),
+             state->get_num(), state->count_todo(), worker.opened_states.size());
 
-    /* Actually answer the request: let's execute the selected request (MCed does one step) */
-    auto executed_transition = state->execute_next(next, get_remote_app());
-    on_transition_execute_signal(state->get_transition_out().get(), get_remote_app());
+    worker.stack.emplace_back(std::move(next_state));
+    worker.execution_seq.push_transition(std::move(executed_transition));
+    worker.executing = nullptr;
+    state            = worker.stack.back();
 
-    // If there are processes to interleave and the maximum depth has not been
-    // reached then perform one step of the exploration algorithm.
-    XBT_VERB("Executed %ld: %.60s (stack depth: %zu, state: %ld, %zu interleaves, %lu opened states)",
-             state->get_transition_out()->aid_, state->get_transition_out()->to_string().c_str(), stack_.size(),
-             state->get_num(), state->count_todo(), opened_states_.size());
+    if (stop_)
+      return;
 
-    /* Create the new expanded state (copy the state of MCed into our MCer data) */
-    auto next_state = reduction_algo_->state_create(get_remote_app(), state);
-    if (_sg_mc_cached_states_interval > 0 && next_state->get_num() % _sg_mc_cached_states_interval == 0) {
-      next_state->set_state_factory(get_remote_app().clone_checker_side());
+    // Backtrack if we reached the maximum depth
+    if (worker.stack.size() > (std::size_t)_sg_mc_max_depth) {
+      XBT_WARN("/!\\ Max depth of %d reached! THIS WILL PROBABLY BREAK the reduction /!\\", _sg_mc_max_depth.get());
+      XBT_WARN("/!\\ Any bug you may find are real, but not finding bug doesn't mean anything /!\\");
+      XBT_WARN("/!\\ You should consider changing the depth limit with --cfg=model-check/max-depth /!\\");
+      XBT_WARN("/!\\ Asumming you know what you are doing, the programm will now backtrack /!\\");
+      return;
     }
-    on_state_creation_signal(next_state.get(), get_remote_app());
 
-    visited_states_count_++;
+    next = reduction_algo_->next_to_explore(worker.execution_seq, &worker.stack);
+    if (next >= 0) {
+      xbt_assert(state->is_actor_enabled(next));
 
-    reduction_algo_->on_backtrack(state.get());
+      // If we use a state containing a sleep state, display it during debug
+      if (XBT_LOG_ISENABLED(mc_parallel, xbt_log_priority_verbose) && reduction_mode_ != ReductionMode::none) {
+        auto sleep_state = static_cast<SleepSetState*>(state.get());
+        if (not sleep_state->get_sleep_set().empty()) {
+          XBT_VERB("Sleep set actually containing:");
 
-    // Before leaving that state, if the transition we just took can be taken multiple times, we
-    // need to give it to the opened states
-    if (stack_.back()->has_more_to_be_explored() > 0) {
-      std::unique_lock<std::mutex> lock_oh(opened_heads_lock_);
-      opened_states_.emplace_back(state);
-      lock_oh.unlock();
+          for (const auto& [aid, transition] : sleep_state->get_sleep_set())
+            XBT_VERB("  <%ld,%s>", aid, transition->to_string().c_str());
+        }
+      }
+
+      times_considered = state->consider_next(next);
+      worker.executing = pending_transition(state.get(), next, times_considered);
+      continue;
+    }
+    lock.unlock();
+
+    // If there is no more transition in the current state (or if ODPOR picked an actor that is not enabled --
+    // ReversibleRace is an overapproximation), this trace is over
+    XBT_VERB("%lu actors remain, but none of them need to be interleaved (depth %zu).", state->get_actor_count(),
+             worker.stack.size() + 1);
+
+    if (remote_app.check_deadlock(false)) {
+      const std::scoped_lock report_lock(report_lock_);
+      remote_app.check_deadlock(true); // Ask again, verbosely this time, to display the counter-example
+      errors_++;
+      if (_sg_mc_max_errors >= 0 && errors_ > _sg_mc_max_errors)
+        throw McError(ExitStatus::DEADLOCK);
     }
 
-    stack_.emplace_back(std::move(next_state));
-    execution_seq_.push_transition(std::move(executed_transition));
-  }
-}
+    if (state->get_actor_count() == 0) {
+      remote_app.finalize_app();
+      XBT_VERB("Execution came to an end at %s", get_record_trace_of(worker).to_string().c_str());
 
-void ParallelizedExplorer::Reducter()
-{
-  unsigned long possible_remaining_explo = 1;
-  while (true) {
-    std::unique_lock<std::mutex> lock_ru(race_updates_lock_);
-    race_updates_cv_.wait(lock_ru, [&] { return race_updates_.size() > 0; });
-    auto update = std::move(race_updates_.back());
-    race_updates_.pop_back();
-    lock_ru.unlock();
-
-    std::unique_lock<std::mutex> lock_oh(opened_heads_lock_);
-    possible_remaining_explo = reduction_algo_->apply_race_update(std::move(update), &opened_states_) - 1;
-    if (possible_remaining_explo == 0) {
-      opened_states_.emplace_back();
+      {
+        const std::scoped_lock tree_lock(tree_lock_);
+        worker.explored_traces++;
+        report_correct_execution(state.get());
+        pending_work_++; // Until the reducer is done with the races of that trace
+      }
+      {
+        // Hand the races over to the reducer, and go on with another trace in the meanwhile
+        const std::scoped_lock jobs_lock(race_jobs_lock_);
+        race_jobs_.push_back({&worker, std::move(worker.execution_seq), worker.stack});
+      }
+      race_jobs_cv_.notify_one();
     }
-    lock_oh.unlock();
-    opened_heads_cv_.notify_one();
+    return;
   }
 }
 
 ParallelizedExplorer::ParallelizedExplorer(const std::vector<char*>& args, ReductionMode mode)
     : Exploration(args), reduction_mode_(mode)
 {
-
   if (reduction_mode_ == ReductionMode::dpor)
     reduction_algo_ = std::make_unique<DPOR>();
   else if (reduction_mode_ == ReductionMode::sdpor)
@@ -302,25 +428,33 @@ ParallelizedExplorer::ParallelizedExplorer(const std::vector<char*>& args, Reduc
   else if (reduction_mode_ == ReductionMode::odpor)
     reduction_algo_ = std::make_unique<BeFSODPOR>();
   else {
-    xbt_assert(reduction_mode_ == ReductionMode::none, "Reduction mode %s not supported yet by BeFS explorer",
+    xbt_assert(reduction_mode_ == ReductionMode::none, "Reduction mode %s not supported yet by the parallel explorer",
                to_c_str(reduction_mode_));
     reduction_algo_ = std::make_unique<NoReduction>();
   }
+  xbt_assert(not _sg_mc_nofork, "The parallel exploration forks one application per worker, so it cannot run without "
+                                "forking. Please remove --cfg=model-check/no-fork.");
+
+  unsigned nb_workers = _sg_mc_parallel_workers;
+  if (nb_workers == 0)
+    nb_workers = std::max(1U, std::thread::hardware_concurrency());
+  XBT_INFO("Start a parallelized exploration with %u workers. Reduction is: %s.", nb_workers,
+           to_c_str(reduction_mode_));
+  odpor::WakeupTree::set_thread_safe(nb_workers > 1);
+
+  for (unsigned i = 0; i < nb_workers; i++) {
+    auto worker        = std::make_unique<Worker>();
+    worker->id         = i;
+    worker->remote_app = std::make_unique<RemoteApp>(get_remote_app(), get_remote_app().clone_checker_side());
+    workers_.emplace_back(std::move(worker));
+  }
 
-  reducer = std::thread([&] { this->Reducter(); });
-  XBT_INFO("Start a parallelized exploration. Reduction is: %s.", to_c_str(reduction_mode_));
-
-  auto initial_state = reduction_algo_->state_create(get_remote_app());
-
-  XBT_DEBUG("**************************************************");
-
-  stack_.emplace_back(std::move(initial_state));
+  // Create the initial state through the first worker, that explores from there first: ODPOR may ask its application
+  // to go one way, and that application must then follow the way it picked
+  initial_state_ = reduction_algo_->state_create(*workers_.front()->remote_app);
   visited_states_count_++;
-
-  /* Get an enabled actor and insert it in the interleave set of the initial state */
-  XBT_DEBUG("Initial state. %lu actors to consider", stack_.back()->get_actor_count());
-
-  opened_states_.emplace_back(stack_.back());
+  XBT_DEBUG("Initial state. %lu actors to consider", initial_state_->get_actor_count());
+  pending_work_ = 1; // Until the first worker is done with the root
 }
 
 Exploration* create_parallelized_exploration(const std::vector<char*>& args, ReductionMode mode)
@@ -15,6 +15,7 @@
 
 #include <condition_variable>
 #include <deque>
+#include <exception>
 #include <list>
 #include <memory>
 #include <mutex>
@@ -26,60 +27,105 @@
 
 namespace simgrid::mc {
 
+/** Explores the state space with several worker threads, each of them driving its own application process.
+ *
+ * The exploration tree (the states, their sleep sets, wakeup trees and todo marks) is shared between the workers, and
+ * protected by tree_lock_. The workers only hold that lock while updating the tree, and release it to talk to their
+ * application. Each worker keeps its own pool of opened states, and steals work from the other pools when its own is
+ * empty. The races found at the end of each explored trace are handed to a reducer thread, which applies them to the
+ * tree while the worker starts exploring its next trace.
+ */
 class XBT_PRIVATE ParallelizedExplorer : public Exploration {
 private:
   ReductionMode reduction_mode_;
   std::unique_ptr<Reduction> reduction_algo_;
 
-  // For statistics
-  unsigned long explored_traces_ = 0;
+  /** Everything that one exploration thread needs on its own */
+  struct Worker {
+    unsigned id;
+    std::unique_ptr<RemoteApp> remote_app;
+    std::thread thread;
+
+    /** Stack representing the position of that worker in the exploration graph */
+    stack_t stack;
+    /** Additional metadata about the position in the exploration graph, used by SDPOR and ODPOR */
+    odpor::Execution execution_seq;
+    /** The transition being executed, if any, so that it appears in the error reports */
+    std::shared_ptr<Transition> executing;
+
+    /** The opened states pushed by that worker (or by the reducer on its behalf). Protected by tree_lock_ */
+    std::deque<StatePtr> opened_states;
+    /** Whether the application of that worker still stands at the initial state */
+    bool at_initial_state = true;
+    /** Whether the application of that worker died on an error, and thus cannot be finalized */
+    bool app_crashed = false;
+
+    // For statistics. Protected by tree_lock_
+    unsigned long explored_traces = 0;
+    unsigned long visited_states  = 0;
+  };
+  std::vector<std::unique_ptr<Worker>> workers_;
+  /** The worker run by the current thread, if any */
+  static thread_local Worker* current_worker_;
+
+  /** Protects the exploration tree, the pools of opened states and the bookkeeping below */
+  std::mutex tree_lock_;
+  std::condition_variable tree_cv_;
+  /** Amount of traces being explored plus amount of race updates not applied yet. The exploration is over when this is
+   *  null and all pools of opened states are empty */
+  unsigned long pending_work_ = 0;
+  bool stop_                  = false;
+  bool timeouted_             = false;
+
+  /** A trace to compute the races of, once its worker moved on */
+  struct RaceJob {
+    Worker* worker;
+    odpor::Execution execution_seq;
+    stack_t stack;
+  };
+  std::deque<RaceJob> race_jobs_;
+  std::mutex race_jobs_lock_;
+  std::condition_variable race_jobs_cv_;
+  bool reducer_done_ = false;
+  std::thread reducer_;
+
+  /** The first error found by a worker, that ends the exploration */
+  std::exception_ptr error_;
+  Worker* failed_worker_ = nullptr;
+
+  /** The root of the exploration graph */
+  StatePtr initial_state_;
 
 public:
   explicit ParallelizedExplorer(const std::vector<char*>& args, ReductionMode mode);
   void run() override;
   RecordTrace get_record_trace() override;
   void log_state() override;
-  stack_t get_stack() override { return stack_; }
+  stack_t get_stack() override;
 
 private:
-  void backtrack();
-
-  std::mutex opened_heads_lock_;
-  std::condition_variable opened_heads_cv_;
-
-  std::vector<std::unique_ptr<Reduction::RaceUpdate>> race_updates_;
-  std::mutex race_updates_lock_;
-  std::condition_variable race_updates_cv_;
-
-  std::thread reducer;
-
-  void Reducter();
-
-  void Explorer();
-
-  /** Stack representing the position in the exploration graph */
-  stack_t stack_;
-
-  /**
-   * Provides additional metadata about the position in the exploration graph
-   * which is used by SDPOR and ODPOR
-   */
-  odpor::Execution execution_seq_;
-
-  /** Per-actor clock vectors used to compute the "happens-before" relation */
-  std::unordered_map<aid_t, ClockVector> per_actor_clocks_;
-
-  /** Opened states are states that still contains todo actors.
-   *  When backtracking, we pick a state from it*/
-  std::vector<StatePtr> opened_states_;
-  StatePtr best_opened_state();
-
-  /** Change current stack_ value to correspond to the one we would have
-   *  had if we executed transition to get to state. This is required when
-   *  backtracking, and achieved thanks to the fact states save their parent.*/
-  void restore_stack(StatePtr state);
-
-  RecordTrace get_record_trace_of_stack(stack_t stack);
+  void run_worker(Worker& worker);
+  void run_reducer();
+
+  /** Pick a state to explore from, in the pool of that worker or in the pools of others, and the transition to take
+   *  from it. The worker stack is set to lead to that state. Returns false when the exploration is over. */
+  bool take_opened_state(Worker& worker, aid_t& next, unsigned& times_considered);
+  StatePtr pop_opened_state(Worker& worker);
+  /** Set the stack of the worker to lead to that state, and pick the transition to take from there (with the tree lock
+   *  held, but released while rebuilding the stack). Returns false if nothing is left to explore from that state. */
+  bool plan_from(Worker& worker, std::unique_lock<std::mutex>& lock, const StatePtr& state, aid_t& next,
+                 unsigned& times_considered);
+  /** Bring the application of the worker to the top of its stack, and explore from there until the end of a trace */
+  void explore_from(Worker& worker, aid_t next, unsigned times_considered);
+  void stop_on_error(Worker& worker, std::exception_ptr error);
+  /** The transition that is about to be executed, for the error reports */
+  std::shared_ptr<Transition> pending_transition(const State* state, aid_t aid, unsigned times_considered);
+
+  /** Change worker.stack to correspond to the one it would have had if it had executed transitions to get to state.
+   *  This is achieved thanks to the fact states save their parent. */
+  void restore_stack(Worker& worker, const StatePtr& state) const;
+
+  RecordTrace get_record_trace_of(const Worker& worker) const;
 };
 
 } // namespace simgrid::mc
@@ -0,0 +1,269 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/mc/explo/SwarmExplorer.hpp"
+#include "src/mc/mc_record.hpp"
+
+#include "xbt/asserts.h"
+#include "xbt/log.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(mc_swarm, mc, "Swarm of independent explorations of the model-checker");
+
+namespace simgrid::mc {
+
+static const char* status_name(ExitStatus status)
+{
+  switch (status) {
+    case ExitStatus::SAFETY:
+      return "Property violation";
+    case ExitStatus::DEADLOCK:
+      return "Deadlock";
+    case ExitStatus::NON_DETERMINISM:
+      return "Non-determinism";
+    case ExitStatus::PROGRAM_CRASH:
+      return "Crash";
+    default:
+      return "Error";
+  }
+}
+
+SwarmExplorer::SwarmExplorer(ReductionMode mode) : reduction_mode_(mode)
+{
+  xbt_assert(reduction_mode_ != ReductionMode::udpor,
+             "The UDPOR exploration ignores the strategies, so its swarm would explore the same traces in each worker. "
+             "Please pick another reduction.");
+
+  unsigned nb_workers = _sg_mc_parallel_workers;
+  if (nb_workers == 0)
+    nb_workers = std::max(1U, std::thread::hardware_concurrency());
+
+  // The first worker does what simgrid-mc would do without the swarm, the others are randomized and vary their search
+  for (unsigned i = 0; i < nb_workers; i++) {
+    Worker worker;
+    worker.id       = i;
+    worker.algo     = (i % 2 == 0) ? "DFS" : "BeFS";
+    worker.strategy = (i == 0) ? _sg_mc_strategy.get() : "uniform";
+    worker.seed     = _sg_mc_random_seed + static_cast<int>(i);
+    workers_.push_back(std::move(worker));
+  }
+}
+
+SwarmExplorer::~SwarmExplorer()
+{
+  kill_workers();
+  for (auto const& worker : workers_)
+    if (worker.log != nullptr)
+      fclose(worker.log);
+}
+
+bool SwarmExplorer::fork_workers()
+{
+  XBT_INFO("Start a swarm exploration with %zu workers. Reduction is: %s.", workers_.size(), to_c_str(reduction_mode_));
+
+  for (auto& worker : workers_) {
+    XBT_VERB("Worker %u: %s exploration with the %s strategy and the seed %d", worker.id, worker.algo.c_str(),
+             worker.strategy.c_str(), worker.seed);
+    int fds[2];
+    xbt_assert(pipe(fds) == 0, "Could not create the report pipe of worker %u: %s", worker.id, strerror(errno));
+    // Do not leak the pipe into the applications, or the coordinator would never see it closed
+    xbt_assert(fcntl(fds[1], F_SETFD, FD_CLOEXEC) == 0, "Could not protect the report pipe: %s", strerror(errno));
+    worker.log = std::tmpfile();
+    xbt_assert(worker.log != nullptr, "Could not create the log file of worker %u: %s", worker.id, strerror(errno));
+
+    fflush(stdout);
+    fflush(stderr);
+    worker.pid = fork();
+    xbt_assert(worker.pid >= 0, "Could not fork worker %u: %s", worker.id, strerror(errno));
+    if (worker.pid == 0) {
+      close(fds[0]);
+      worker.report_fd = fds[1];
+      setup_worker(worker);
+      workers_.clear(); // The coordinator is the only one to care about them
+      return true;
+    }
+    close(fds[1]);
+    worker.report_fd = fds[0];
+  }
+  return false;
+}
+
+void SwarmExplorer::setup_worker(const Worker& worker)
+{
+  for (auto const& other : workers_) {
+    if (other.id == worker.id)
+      break;
+    close(other.report_fd);
+    fclose(other.log);
+  }
+  xbt_assert(dup2(fileno(worker.log), STDOUT_FILENO) >= 0 && dup2(fileno(worker.log), STDERR_FILENO) >= 0,
+             "Could not redirect the output of worker %u: %s", worker.id, strerror(errno));
+  fclose(worker.log);
+
+  _sg_mc_explore_algo = worker.algo;
+  _sg_mc_strategy     = worker.strategy;
+  _sg_mc_random_seed  = worker.seed;
+
+  Exploration::on_error([fd = worker.report_fd](ExitStatus status, Exploration& explo) {
+    std::string report = std::to_string(static_cast<int>(status)) + ' ' + explo.get_record_trace().to_string() + '\n';
+    for (size_t done = 0; done < report.size();) {
+      ssize_t res = write(fd, report.data() + done, report.size() - done);
+      if (res < 0 && errno == EINTR)
+        continue;
+      if (res < 0) // The coordinator is gone
+        return;
+      done += res;
+    }
+  });
+}
+
+bool SwarmExplorer::read_reports(Worker& worker)
+{
+  char buffer[4096];
+  ssize_t got;
+  do {
+    got = read(worker.report_fd, buffer, sizeof buffer);
+  } while (got < 0 && errno == EINTR);
+  if (got <= 0)
+    return false;
+
+  worker.report_buffer.append(buffer, got);
+  for (size_t end = worker.report_buffer.find('\n'); end != std::string::npos; end = worker.report_buffer.find('\n')) {
+    add_report(worker.id, worker.report_buffer.substr(0, end));
+    worker.report_buffer.erase(0, end + 1);
+  }
+  return true;
+}
+
+void SwarmExplorer::add_report(unsigned worker, const std::string& line)
+{
+  auto space = line.find(' ');
+  xbt_assert(space != std::string::npos, "Malformed report from worker %u: %s", worker, line.c_str());
+  auto status = static_cast<ExitStatus>(std::stoi(line.substr(0, space)));
+  auto trace  = line.substr(space + 1);
+
+  auto [pos, inserted] = known_traces_.try_emplace(trace, counter_examples_.size());
+  if (inserted) {
+    XBT_VERB("Worker %u found a new counter-example (%s): %s", worker, status_name(status), trace.c_str());
+    counter_examples_.push_back({status, std::move(trace), worker, 1});
+  } else {
+    counter_examples_[pos->second].reports++;
+  }
+}
+
+ExitStatus SwarmExplorer::run()
+{
+  const Worker* winner = nullptr;
+  ExitStatus verdict   = ExitStatus::ERROR;
+
+  std::vector<pollfd> fds;
+  std::vector<Worker*> polled;
+  while (winner == nullptr) {
+    fds.clear();
+    polled.clear();
+    for (auto& worker : workers_)
+      if (worker.report_fd >= 0) {
+        fds.push_back({worker.report_fd, POLLIN, 0});
+        polled.push_back(&worker);
+      }
+    if (fds.empty())
+      break;
+
+    if (poll(fds.data(), fds.size(), -1) < 0) {
+      xbt_assert(errno == EINTR, "Could not wait for the workers: %s", strerror(errno));
+      continue;
+    }
+
+    for (size_t i = 0; i < fds.size() && winner == nullptr; i++) {
+      Worker& worker = *polled[i];
+      if (fds[i].revents == 0 || read_reports(worker))
+        continue;
+
+      // The worker closed its pipe: it is over
+      close(worker.report_fd);
+      worker.report_fd = -1;
+      int status;
+      while (waitpid(worker.pid, &status, 0) < 0)
+        xbt_assert(errno == EINTR, "Could not wait for worker %u: %s", worker.id, strerror(errno));
+      worker.pid = -1;
+
+      if (WIFEXITED(status)) {
+        winner  = &worker;
+        verdict = static_cast<ExitStatus>(WEXITSTATUS(status));
+      } else {
+        XBT_WARN("Worker %u was killed by signal %s. The other workers go on.", worker.id,
+                 strsignal(WTERMSIG(status)));
+      }
+    }
+  }
+
+  kill_workers();
+  if (winner == nullptr) {
+    XBT_CRITICAL("All the workers of the swarm died before the end of their exploration.");
+    return ExitStatus::ERROR;
+  }
+  log_state(*winner);
+  return verdict;
+}
+
+void SwarmExplorer::kill_workers()
+{
+  for (auto const& worker : workers_)
+    if (worker.pid > 0)
+      kill(worker.pid, SIGTERM);
+
+  for (auto& worker : workers_) {
+    if (worker.pid > 0) {
+      while (waitpid(worker.pid, nullptr, 0) < 0 && errno == EINTR)
+        ;
+      worker.pid = -1;
+    }
+    if (worker.report_fd >= 0) {
+      // Keep the reports that the killed worker sent before dying
+      while (read_reports(worker))
+        ;
+      close(worker.report_fd);
+      worker.report_fd = -1;
+    }
+  }
+}
+
+void SwarmExplorer::log_state(const Worker& winner) const
+{
+  rewind(winner.log);
+  char buffer[4096];
+  size_t got;
+  while ((got = fread(buffer, 1, sizeof buffer, winner.log)) > 0)
+    fwrite(buffer, 1, got, stderr);
+  fflush(stderr);
+
+  XBT_INFO("Swarm exploration ended by worker %u (%s exploration with the %s strategy and the seed %d).", winner.id,
+           winner.algo.c_str(), winner.strategy.c_str(), winner.seed);
+  if (counter_examples_.empty())
+    return;
+  XBT_INFO("%zu distinct counter-examples were reported by the workers:", counter_examples_.size());
+  for (auto const& example : counter_examples_)
+    XBT_INFO("  %s (%lu reports, first by worker %u): --cfg=model-check/replay:'%s'", status_name(example.status),
+             example.reports, example.first_worker, example.trace.c_str());
+}
+
+std::optional<ExitStatus> run_swarm_exploration(ReductionMode mode)
+{
+  SwarmExplorer swarm(mode);
+  if (swarm.fork_workers())
+    return std::nullopt;
+  return swarm.run();
+}
+
+} // namespace simgrid::mc
@@ -0,0 +1,75 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_MC_SWARM_EXPLORER_HPP
+#define SIMGRID_MC_SWARM_EXPLORER_HPP
+
+#include "src/mc/explo/Exploration.hpp"
+#include "src/mc/mc_config.hpp"
+#include "src/mc/mc_exit.hpp"
+
+#include <cstdio>
+#include <string>
+#include <sys/types.h>
+#include <unordered_map>
+#include <vector>
+
+namespace simgrid::mc {
+
+/** Runs several independent explorations at once, each of them in its own process, to find the bugs quickly.
+ *
+ * The initial process only coordinates the workers. Each of them is forked with its own exploration algorithm, strategy
+ * and random seed, and then runs as a plain simgrid-mc on its own application. The workers report each counter-example
+ * they find through a pipe, and the coordinator merges these reports into a database where each trace appears once. The
+ * first worker that ends decides the verdict: its last counter-example is confirmed once it is done reporting it (and
+ * searching its critical transition if asked), and an exhaustive exploration without error proves the program correct.
+ * The other workers are then killed, along with their applications.
+ */
+class XBT_PRIVATE SwarmExplorer {
+  ReductionMode reduction_mode_;
+
+  struct Worker {
+    unsigned id;
+    std::string algo;
+    std::string strategy;
+    int seed;
+
+    pid_t pid      = -1;
+    int report_fd  = -1;      // Where the worker writes its counter-examples, one per line
+    FILE* log      = nullptr; // Everything printed by the worker and its application
+    std::string report_buffer; // The report lines that are not complete yet
+  };
+  std::vector<Worker> workers_;
+
+  struct CounterExample {
+    ExitStatus status;
+    std::string trace;
+    unsigned first_worker;
+    unsigned long reports;
+  };
+  std::vector<CounterExample> counter_examples_;
+  std::unordered_map<std::string, size_t> known_traces_;
+
+public:
+  explicit SwarmExplorer(ReductionMode mode);
+  ~SwarmExplorer();
+
+  /** Forks the workers. Returns true in the workers, once they are configured, and false in the coordinator */
+  bool fork_workers();
+  /** Waits for the first worker to end, kills the others and returns the verdict of the swarm */
+  ExitStatus run();
+
+private:
+  void setup_worker(const Worker& worker);
+  /** Reads the reports of that worker. Returns false when the worker closed its pipe */
+  bool read_reports(Worker& worker);
+  void add_report(unsigned worker, const std::string& line);
+  void kill_workers();
+  void log_state(const Worker& winner) const;
+};
+
+} // namespace simgrid::mc
+
+#endif
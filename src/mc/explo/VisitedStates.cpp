@@ -0,0 +1,73 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/mc/explo/VisitedStates.hpp"
+#include "src/mc/api/states/State.hpp"
+#include "src/mc/mc_config.hpp"
+#include "xbt/log.h"
+
+#include <cinttypes>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(mc_visited, mc, "Detection of the already visited states of the model-checker");
+
+namespace simgrid::mc {
+
+static simgrid::config::Flag<int> cfg_visited_states{
+    "model-check/visited",
+    "Amount of visited states to remember, so that they are not explored again (-1: all of them; 0: stateless "
+    "exploration). The state of the application must be declared with MC_declare_state().",
+    0, [](int value) { xbt_assert(value >= -1, "The value of model-check/visited must be -1, 0 or positive"); }};
+
+bool VisitedStates::is_enabled()
+{
+  return cfg_visited_states != 0;
+}
+
+VisitedStates::VisitedStates()
+{
+  // DPOR-like reductions assume that every explored trace goes to its end, and miss some races if we cut some of them
+  xbt_assert(not is_enabled() || get_model_checking_reduction() == ReductionMode::none,
+             "The detection of visited states (model-check/visited) is not sound with the %s reduction. Please use "
+             "--cfg=model-check/reduction:none",
+             to_c_str(get_model_checking_reduction()));
+}
+
+bool VisitedStates::visit(const State& state, const RemoteApp& remote_app)
+{
+  if (not is_enabled())
+    return false;
+
+  auto [hash, check] = remote_app.get_state_fingerprint();
+  auto [it, inserted] = fingerprints_.try_emplace(hash, check);
+  if (not inserted) {
+    if (it->second == check) {
+      XBT_DEBUG("State #%ld was already visited (fingerprint %016" PRIx64 ")", state.get_num(), hash);
+      revisits_++;
+      return true;
+    }
+    XBT_DEBUG("State #%ld collides with another one (fingerprint %016" PRIx64 ")", state.get_num(), hash);
+    collisions_++;
+    return false;
+  }
+
+  if (cfg_visited_states > 0) {
+    insertion_order_.push_back(hash);
+    if (insertion_order_.size() > static_cast<size_t>(cfg_visited_states)) {
+      fingerprints_.erase(insertion_order_.front());
+      insertion_order_.pop_front();
+    }
+  }
+  return false;
+}
+
+void VisitedStates::log_state() const
+{
+  if (not is_enabled())
+    return;
+  XBT_INFO("%zu visited states remembered, %lu revisits pruned, %lu fingerprint collisions", fingerprints_.size(),
+           revisits_, collisions_);
+}
+
+} // namespace simgrid::mc
@@ -0,0 +1,46 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_MC_VISITED_STATES_HPP
+#define SIMGRID_MC_VISITED_STATES_HPP
+
+#include "src/mc/api/RemoteApp.hpp"
+#include "src/mc/mc_forward.hpp"
+
+#include <cstdint>
+#include <deque>
+#include <unordered_map>
+
+namespace simgrid::mc {
+
+/** The fingerprints of the application states visited so far, to avoid exploring the same state twice.
+ *
+ * The fingerprint is computed by the application, from the memory areas declared with MC_declare_state() and from the
+ * pending simcall of each actor. It is made of two independent hashes: the first one indexes the table, and the second
+ * one detects the collisions of the first one. Colliding states are explored as if they were new.
+ *
+ * With model-check/visited:N, only the N last visited states are remembered (all of them if N is -1).
+ */
+class VisitedStates {
+  std::unordered_map<uint64_t, uint64_t> fingerprints_; // hash -> check
+  std::deque<uint64_t> insertion_order_;                 // Only used when the amount of remembered states is bounded
+
+  unsigned long revisits_   = 0;
+  unsigned long collisions_ = 0;
+
+public:
+  VisitedStates();
+
+  static bool is_enabled();
+
+  /** Record the state in which the application currently is. Returns whether it was already visited. */
+  bool visit(const State& state, const RemoteApp& remote_app);
+
+  void log_state() const;
+};
+
+} // namespace simgrid::mc
+
+#endif
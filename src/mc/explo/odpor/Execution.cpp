@@ -4,6 +4,7 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "src/mc/explo/odpor/Execution.hpp"
+#include "src/mc/transition/DependencyOracle.hpp"
 #include "src/mc/api/states/SleepSetState.hpp"
 #include "src/mc/api/states/State.hpp"
 #include "src/mc/explo/odpor/odpor_forward.hpp"
@@ -14,6 +15,7 @@
 #include "xbt/log.h"
 #include "xbt/string.hpp"
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <string>
@@ -50,22 +52,44 @@ Execution::Execution(const PartialExecution& w)
   push_partial_execution(w);
 }
 
+Execution::Execution(std::vector<Event>&& contents) : contents_(std::move(contents))
+{
+  for (EventHandle e = 0; e < contents_.size(); e++) {
+    const aid_t aid = get_actor_with_handle(e);
+    if (skip_list_.size() <= (unsigned)aid)
+      skip_list_.resize(aid + 1, {});
+    skip_list_[aid].push_back(e);
+  }
+}
+
 void Execution::push_transition(std::shared_ptr<Transition> t, bool are_we_restoring_execution)
 {
   xbt_assert(t != nullptr, "Unexpectedly received `nullptr`");
+  if (skip_list_.size() <= (unsigned)t->aid_)
+    skip_list_.resize(t->aid_ + 1, {});
+
+  // The new event happens after the last event of each actor it depends on. Start with the actor of the transition:
+  // the clock vector of its previous event already covers most of the past of the new one.
   ClockVector max_clock_vector;
-  for (const auto& events : this->skip_list_) {
+  auto join_last_dependent_event_of = [this, &t, &max_clock_vector](const std::vector<EventHandle>& events) {
     for (auto event_it = events.crbegin(); event_it != events.crend(); ++event_it) {
-      if (contents_[*event_it].get_transition()->depends(t.get())) {
+      // The events of an actor are all dependent with one another, so the clock vector already covers the events of
+      // that actor that are older than the one it knows about, as well as their past. No need to look further.
+      if (max_clock_vector.get(get_actor_with_handle(*event_it)).value_or(-1) >= static_cast<long>(*event_it))
+        return;
+      if (DependencyOracle::depends(contents_[*event_it].get_transition().get(), t.get())) {
         ClockVector::max_emplace_left(max_clock_vector, contents_[*event_it].get_clock_vector());
-        break;
+        return;
       }
     }
-  }
+  };
+  join_last_dependent_event_of(skip_list_[t->aid_]);
+  for (aid_t aid = 0; (unsigned)aid < skip_list_.size(); aid++)
+    if (aid != t->aid_)
+      join_last_dependent_event_of(skip_list_[aid]);
+
   max_clock_vector[t->aid_] = this->size();
   contents_.push_back(Event({t, std::move(max_clock_vector)}));
-  if (skip_list_.size() <= (unsigned)t->aid_)
-    skip_list_.resize(t->aid_ + 1, {});
   skip_list_[t->aid_].push_back(this->size() - 1);
 
   if (are_we_restoring_execution)
@@ -114,26 +138,34 @@ std::list<Execution::EventHandle> Execution::get_racing_events_of(Execution::Eve
 {
   std::list<Execution::EventHandle> racing_events;
   std::list<Execution::EventHandle> candidates;
-  for (aid_t aid = 0; (unsigned)aid < get_event_with_handle(target).get_clock_vector().size(); aid++)
-    if (aid != get_actor_with_handle(target) and get_event_with_handle(target).get_clock_vector().get(aid).value() >= 0)
-      candidates.push_back(get_event_with_handle(target).get_clock_vector().get(aid).value());
-
-  candidates.sort(std::greater<EventHandle>());
-  candidates.unique();
 
   // We need to determine previous action of actor proc(target) in order
   // to fully determine if there exist a "event in the middle"
-  Execution::EventHandle prev_on_actor;
-  for (prev_on_actor = target - 1; prev_on_actor != std::numeric_limits<Execution::EventHandle>::max(); prev_on_actor--)
-    if (get_actor_with_handle(prev_on_actor) == get_actor_with_handle(target))
-      break;
+  const aid_t target_actor             = get_actor_with_handle(target);
+  Execution::EventHandle prev_on_actor = std::numeric_limits<Execution::EventHandle>::max();
+  const auto& events_of_actor          = skip_list_[target_actor];
+  if (auto target_it = std::lower_bound(events_of_actor.begin(), events_of_actor.end(), target);
+      target_it != events_of_actor.begin())
+    prev_on_actor = *std::prev(target_it);
+
+  // For each actor, the last of its events that happens before the target is a candidate, unless it also happens
+  // before the previous event of proc(target). The clock vector of the target was computed from the one of that event,
+  // so only their differing components need to be considered.
+  static const ClockVector no_clock_vector;
+  const ClockVector& prev_clock_vector = prev_on_actor == std::numeric_limits<Execution::EventHandle>::max()
+                                             ? no_clock_vector
+                                             : get_event_with_handle(prev_on_actor).get_clock_vector();
+  get_event_with_handle(target).get_clock_vector().for_each_larger_than(prev_clock_vector, [&](aid_t aid, long value) {
+    if (aid != target_actor)
+      candidates.push_back(value);
+  });
+
+  candidates.sort(std::greater<EventHandle>());
+  candidates.unique();
 
   bool disqualified;
   // For each event in the vector clock that is not on the event itself
   for (auto e_i : candidates) {
-    if (prev_on_actor != std::numeric_limits<Execution::EventHandle>::max() and happens_before(e_i, prev_on_actor))
-      continue;
-
     disqualified = false;
     // If there exist an event e_j such that e_i --> e_j --> target
     // then e_j was found in the candidates already and we must drop e_i
@@ -163,7 +195,7 @@ std::list<Execution::EventHandle> Execution::get_reversible_races_of(EventHandle
   for (EventHandle race : get_racing_events_of(handle)) {
     const auto* other_transition = get_transition_for_handle(race);
 
-    if (this_transition->reversible_race(other_transition)) {
+    if (DependencyOracle::reversible_race(this_transition, other_transition)) {
       reversible_races.push_back(race);
     }
   }
@@ -327,7 +359,7 @@ std::optional<PartialExecution> Execution::get_odpor_extension_from(EventHandle
 
   for (auto transition_it = v.begin(); transition_it != v.end(); ++transition_it) {
     const bool is_initial = std::none_of(v.begin(), transition_it, [&](const auto& transition_it_prime) {
-      return (*transition_it)->depends(transition_it_prime.get());
+      return DependencyOracle::depends(transition_it->get(), transition_it_prime.get());
     });
     if (is_initial) {
       // If the sleep set already contains `q`, we're done:
@@ -360,7 +392,7 @@ bool Execution::is_in_weak_initial_of(Transition* t, const PartialExecution& w)
   for (const auto& w_i : w) {
     if (t->aid_ == w_i->aid_)
       return true;
-    if (w_i->depends(t))
+    if (DependencyOracle::depends(w_i.get(), t))
       return false;
   }
   return true;
@@ -373,12 +405,7 @@ bool Execution::is_initial_after_execution_of(const PartialExecution& w, aid_t p
     if ((*w_i)->aid_ != p)
       continue;
 
-    for (auto w_j = w.begin(); w_j != w_i; w_j++) {
-      if ((*w_j)->depends((*w_i).get()))
-        return false;
-    }
-
-    return true;
+    return DependencyOracle::find_dependent(w.begin(), w_i, w_i->get()) == w_i;
   }
 
   return false;
@@ -386,11 +413,7 @@ bool Execution::is_initial_after_execution_of(const PartialExecution& w, aid_t p
 
 bool Execution::is_independent_with_execution_of(const PartialExecution& w, std::shared_ptr<Transition> next_E_p)
 {
-  for (const auto& transition : w)
-    if (transition->depends(next_E_p.get()))
-      return false;
-
-  return true;
+  return DependencyOracle::find_dependent(w.begin(), w.end(), next_E_p.get()) == w.end();
 }
 
 std::optional<PartialExecution> Execution::get_shortest_odpor_sq_subset_insertion(const PartialExecution& v,
@@ -466,11 +489,10 @@ bool Execution::happens_before_process(Execution::EventHandle e, aid_t p) const
   if (get_actor_with_handle(e) == p)
     return true;
 
-  for (EventHandle k = e + 1; k < contents_.size(); k++) {
-    if (happens_before(e, k) && get_actor_with_handle(k) == p)
-      return true;
-  }
-  return false;
+  // The events of p all happen before its last one, so e happens before one of them iff it happens before the last one
+  if (p < 0 || (unsigned)p >= skip_list_.size() || skip_list_[p].empty())
+    return false;
+  return happens_before(e, skip_list_[p].back());
 }
 
 bool Execution::happens_before(Execution::EventHandle e1_handle, Execution::EventHandle e2_handle) const
@@ -518,7 +540,7 @@ bool MazurkiewiczTraces::are_equivalent(const PartialExecution& u, const Partial
     if ((*b)->type_ == a->type_ && (*b)->aid_ == a->aid_)
       break;
 
-    if ((*b)->depends(a.get())) {
+    if (DependencyOracle::depends(b->get(), a.get())) {
       XBT_DEBUG("The two execution are judge inequivalent because a-->b in the new one, where as b-->a in the old "
                 "one\na := Actor %ld: %s\nb := Actor %ld: %s",
                 a.get()->aid_, a.get()->to_string().c_str(), (*b)->aid_, (*b)->to_string().c_str());
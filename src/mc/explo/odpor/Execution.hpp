@@ -97,8 +97,9 @@ public:
 
 private:
   std::vector<Event> contents_;
+  /** The handles of the events of each actor, in increasing order */
   std::vector<std::vector<EventHandle>> skip_list_ = {{}};
-  Execution(std::vector<Event>&& contents) : contents_(std::move(contents)) {}
+  Execution(std::vector<Event>&& contents);
 
   static PartialExecution preallocated_partial_execution_;
 
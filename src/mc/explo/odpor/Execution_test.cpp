@@ -9,6 +9,9 @@
 #include "src/mc/explo/odpor/odpor_tests_private.hpp"
 #include "src/mc/transition/TransitionComm.hpp"
 
+#include <chrono>
+#include <random>
+
 using namespace simgrid::mc;
 using namespace simgrid::mc::odpor;
 using namespace simgrid::mc::udpor;
@@ -757,3 +760,89 @@ TEST_CASE("simgrid::mc::odpor::Execution: ODPOR Smallest Sequence Tests")
     }
   }
 }
+
+/* A trace of `length` steps of `actors` actors, each step touching one of `values` shared values: two steps are
+ * dependent when they are done by the same actor or touch the same value */
+static PartialExecution random_trace(unsigned actors, unsigned values, unsigned length, unsigned seed)
+{
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<aid_t> actor_dist(1, actors);
+  std::uniform_int_distribution<int> value_dist(0, values - 1);
+  PartialExecution trace;
+  for (unsigned i = 0; i < length; i++)
+    trace.push_back(std::make_shared<DependentIfSameValueAction>(actor_dist(gen), value_dist(gen)));
+  return trace;
+}
+
+TEST_CASE("simgrid::mc::odpor::Execution: Happens-Before on Long Traces")
+{
+  // Compare the happens-before relation of the execution with the transitive closure of the dependencies
+  for (auto [actors, values] : {std::pair{4u, 2u}, std::pair{20u, 5u}, std::pair{40u, 40u}}) {
+    const unsigned length = 150;
+    Execution execution(random_trace(actors, values, length, actors));
+    REQUIRE(execution.size() == length);
+
+    std::vector<std::vector<bool>> hb(length, std::vector<bool>(length, false));
+    for (unsigned j = 0; j < length; j++)
+      for (unsigned i = j; i-- > 0;)
+        if (not hb[i][j] && execution.get_transition_for_handle(i)->depends(execution.get_transition_for_handle(j))) {
+          hb[i][j] = true;
+          for (unsigned k = 0; k < i; k++)
+            if (hb[k][i])
+              hb[k][j] = true;
+        }
+
+    for (unsigned j = 0; j < length; j++)
+      for (unsigned i = 0; i < length; i++)
+        REQUIRE(execution.happens_before(i, j) == hb[i][j]);
+
+    for (unsigned e = 0; e < length; e++)
+      for (aid_t p = 1; p <= static_cast<aid_t>(actors); p++) {
+        bool expected = execution.get_actor_with_handle(e) == p;
+        for (unsigned k = e + 1; k < length; k++)
+          expected = expected || (hb[e][k] && execution.get_actor_with_handle(k) == p);
+        REQUIRE(execution.happens_before_process(e, p) == expected);
+      }
+
+    for (unsigned target = 0; target < length; target++) {
+      std::list<Execution::EventHandle> expected;
+      for (unsigned e = target; e-- > 0;) {
+        bool in_between = false;
+        for (unsigned k = e + 1; k < target && not in_between; k++)
+          in_between = hb[e][k] && hb[k][target];
+        if (hb[e][target] && not in_between &&
+            execution.get_actor_with_handle(e) != execution.get_actor_with_handle(target))
+          expected.push_back(e);
+      }
+      REQUIRE(execution.get_racing_events_of(target) == expected);
+    }
+  }
+}
+
+TEST_CASE("simgrid::mc::odpor::Execution: Benchmarking the Happens-Before Computations", "[.][benchmark]")
+{
+  // Run it with `unit-tests "[benchmark]"`
+  for (unsigned actors : {8u, 64u, 512u})
+    for (unsigned length : {1000u, 4000u, 16000u}) {
+      const auto trace = random_trace(actors, actors / 4, length, 42);
+
+      auto start = std::chrono::steady_clock::now();
+      Execution execution(trace);
+      auto pushed = std::chrono::steady_clock::now();
+      size_t races = 0;
+      for (Execution::EventHandle e = 0; e < length; e++)
+        races += execution.get_racing_events_of(e).size();
+      auto raced = std::chrono::steady_clock::now();
+      size_t followers = 0;
+      for (Execution::EventHandle e = 0; e < length; e++)
+        followers += execution.happens_before_process(e, 1) ? 1 : 0;
+      auto done = std::chrono::steady_clock::now();
+
+      auto per_event = [length](auto from, auto to) {
+        return std::chrono::duration<double, std::micro>(to - from).count() / length;
+      };
+      WARN(actors << " actors, " << length << " events: push " << per_event(start, pushed) << " us, races "
+                  << per_event(pushed, raced) << " us, happens-before-process " << per_event(raced, done)
+                  << " us per event (" << races << " races, " << followers << " followers)");
+    }
+}
@@ -11,19 +11,31 @@
 #include "xbt/string.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <deque>
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(mc_wut, mc, "Logging specific to ODPOR WakeupTrees");
 
 namespace simgrid::mc::odpor {
 
-void WakeupTreeNode::add_child(std::unique_ptr<WakeupTreeNode> node)
+/** @brief A transition referenced by the nodes of a wakeup tree */
+struct WakeupTreeInternedTransition {
+  std::shared_ptr<Transition> transition;
+  unsigned refcount = 0;
+};
+
+std::shared_ptr<Transition> WakeupTreeNode::get_action() const
+{
+  return action_ == nullptr ? nullptr : action_->transition;
+}
+
+Transition* WakeupTreeNode::get_transition() const
 {
-  xbt_assert(node != nullptr, "Who gave me a nullptr??");
-  node->parent_ = this;
-  node->sequence_ = this->sequence_;
-  node->sequence_.emplace_back(node->action_);
-  this->children_.push_back(std::move(node));
+  return action_ == nullptr ? nullptr : action_->transition.get();
 }
 
 std::string WakeupTreeNode::string_of_whole_tree(const std::string& prefix, bool is_first, bool is_last) const
@@ -31,31 +43,172 @@ std::string WakeupTreeNode::string_of_whole_tree(const std::string& prefix, bool
 
   std::string final_string = action_ == nullptr
                                  ? "<>\n"
-                                 : prefix + (is_last ? "└──" : "├──") + "Actor " + std::to_string(action_->aid_) +
-                                       ": " + action_->to_string(true) + "\n";
+                                 : prefix + (is_last ? "└──" : "├──") + "Actor " + std::to_string(get_actor()) +
+                                       ": " + get_transition()->to_string(true) + "\n";
   bool is_next_first       = true;
-  for (auto node_it = children_.begin(); node_it != children_.end(); node_it++) {
-    auto node                    = node_it;
+  for (const auto* node : *this) {
     const std::string new_prefix = prefix + (is_last ? "    " : "│   ");
-    final_string += node->get()->string_of_whole_tree(new_prefix, is_next_first, std::next(node_it) == children_.end());
+    final_string += node->string_of_whole_tree(new_prefix, is_next_first, node->next_sibling_ == nullptr);
     is_next_first = false;
   }
   return final_string;
 }
 
-const PartialExecution& WakeupTreeNode::get_sequence() const
+PartialExecution WakeupTreeNode::get_sequence() const
+{
+  PartialExecution sequence;
+  for (const WakeupTreeNode* node = this; not node->is_root(); node = node->parent_)
+    sequence.push_back(node->get_action());
+  std::reverse(sequence.begin(), sequence.end());
+  return sequence;
+}
+
+class WakeupTreeArena {
+  /* The subtrees handed to the child states share the arena of their parent, so all the trees of an exploration end up
+   * in the same arena. The states of the parallel exploration, and thus their trees, are released by any worker: the
+   * arenas are only locked then, so that the sequential explorations pay nothing for it. */
+  static inline std::atomic<bool> thread_safe_{false};
+  std::mutex mutex_;
+  std::deque<WakeupTreeNode> nodes_; // A deque, so that the nodes never move
+  std::vector<WakeupTreeNode*> free_nodes_;
+  /* Each transition is referenced only once by the arena, however many nodes hold it */
+  std::unordered_map<const Transition*, WakeupTreeInternedTransition> transitions_;
+
+  WakeupTreeNode* allocate()
+  {
+    if (free_nodes_.empty())
+      return &nodes_.emplace_back();
+    WakeupTreeNode* node = free_nodes_.back();
+    free_nodes_.pop_back();
+    return node;
+  }
+
+  void release_action_unlocked(WakeupTreeNode* node)
+  {
+    if (const Transition* t = node->get_transition(); t != nullptr && --node->action_->refcount == 0)
+      transitions_.erase(t);
+    node->action_ = nullptr;
+  }
+
+  void release_unlocked(WakeupTreeNode* node)
+  {
+    for (WakeupTreeNode* child = node->first_child_; child != nullptr;) {
+      WakeupTreeNode* next = child->next_sibling_;
+      release_unlocked(child);
+      child = next;
+    }
+    release_action_unlocked(node);
+    node->parent_       = nullptr;
+    node->first_child_  = nullptr;
+    node->last_child_   = nullptr;
+    node->next_sibling_ = nullptr;
+    free_nodes_.push_back(node);
+  }
+
+  std::unique_lock<std::mutex> guard()
+  {
+    return thread_safe_.load(std::memory_order_relaxed) ? std::unique_lock(mutex_) : std::unique_lock<std::mutex>();
+  }
+
+public:
+  static void set_thread_safe(bool thread_safe) { thread_safe_ = thread_safe; }
+
+  WakeupTreeNode* new_root()
+  {
+    const auto lock = guard();
+    return allocate();
+  }
+
+  WakeupTreeNode* new_node(const std::shared_ptr<Transition>& u)
+  {
+    const auto lock = guard();
+    WakeupTreeNode* node = allocate();
+    auto& interned       = transitions_[u.get()];
+    if (interned.refcount++ == 0)
+      interned.transition = u;
+    node->action_ = &interned;
+    return node;
+  }
+
+  /** Turns a detached node into the root of a tree, which does not correspond to any action */
+  void release_action(WakeupTreeNode* node)
+  {
+    const auto lock = guard();
+    release_action_unlocked(node);
+  }
+
+  /** Recycles the given detached node and all its descendants */
+  void release(WakeupTreeNode* node)
+  {
+    const auto lock = guard();
+    release_unlocked(node);
+  }
+};
+
+void WakeupTree::set_thread_safe(bool thread_safe)
+{
+  WakeupTreeArena::set_thread_safe(thread_safe);
+}
+
+WakeupTree::WakeupTree() : arena_(std::make_shared<WakeupTreeArena>()), root_(arena_->new_root()) {}
+WakeupTree::WakeupTree(std::shared_ptr<WakeupTreeArena> arena, WakeupTreeNode* root)
+    : arena_(std::move(arena)), root_(root)
 {
-  return sequence_;
 }
 
-WakeupTree::WakeupTree() : WakeupTree(std::make_unique<WakeupTreeNode>()) {}
-WakeupTree::WakeupTree(std::unique_ptr<WakeupTreeNode> root) : root_(std::move(root)) {}
+WakeupTree::WakeupTree(WakeupTree&& other) noexcept
+    : arena_(std::move(other.arena_)), root_(std::exchange(other.root_, nullptr))
+{
+}
+
+WakeupTree& WakeupTree::operator=(WakeupTree&& other) noexcept
+{
+  if (this != &other) {
+    if (root_ != nullptr)
+      arena_->release(root_);
+    arena_ = std::move(other.arena_);
+    root_  = std::exchange(other.root_, nullptr);
+  }
+  return *this;
+}
+
+WakeupTree::~WakeupTree()
+{
+  if (root_ != nullptr)
+    arena_->release(root_);
+}
+
+void WakeupTree::add_child(WakeupTreeNode* parent, WakeupTreeNode* child)
+{
+  child->parent_ = parent;
+  if (parent->last_child_ == nullptr)
+    parent->first_child_ = child;
+  else
+    parent->last_child_->next_sibling_ = child;
+  parent->last_child_ = child;
+}
+
+void WakeupTree::unlink_from_root(WakeupTreeNode* child)
+{
+  xbt_assert(child->parent_ == root_, "Only the direct children of the root can be unlinked");
+  WakeupTreeNode* prev = nullptr;
+  for (WakeupTreeNode* node = root_->first_child_; node != child; node = node->next_sibling_)
+    prev = node;
+  if (prev == nullptr)
+    root_->first_child_ = child->next_sibling_;
+  else
+    prev->next_sibling_ = child->next_sibling_;
+  if (root_->last_child_ == child)
+    root_->last_child_ = prev;
+  child->parent_       = nullptr;
+  child->next_sibling_ = nullptr;
+}
 
 std::vector<std::string> WakeupTree::get_single_process_texts() const
 {
   std::vector<std::string> trace;
-  for (const auto& child : root_->children_) {
-    const auto t = child->get_action();
+  for (const auto* child : *root_) {
+    const auto* t = child->get_transition();
     auto message = xbt::string_printf("Actor %ld: %s", t->aid_, t->to_string(true).c_str());
     trace.emplace_back(std::move(message));
   }
@@ -79,8 +232,7 @@ std::optional<WakeupTreeNode*> WakeupTree::get_min_single_process_node() const
   // in order before the parent. The list of children maintained by
   // each node represents that ordering, and the first child of
   // the root is by definition the smallest of the single-process nodes
-  xbt_assert(not this->root_->children_.empty(), "What the");
-  return this->root_->children_.front().get();
+  return this->root_->first_child_;
 }
 
 std::string WakeupTree::string_of_whole_tree() const
@@ -90,40 +242,28 @@ std::string WakeupTree::string_of_whole_tree() const
 
 WakeupTree WakeupTree::get_first_subtree()
 {
-  auto subtree = WakeupTree();
   if (empty())
-    return subtree;
-
-  auto node_it = this->root_->children_.begin();
+    return WakeupTree(arena_, arena_->new_root());
 
-  subtree.root_ = std::move(*node_it);
-  root_->children_.erase(node_it);
+  // The subtree keeps its nodes, that remain in the arena shared by both trees
+  WakeupTreeNode* first = this->root_->first_child_;
+  unlink_from_root(first);
+  arena_->release_action(first);
 
-  subtree.root_->parent_   = nullptr;
-  subtree.root_->action_   = nullptr;
-  subtree.root_->sequence_ = odpor::PartialExecution();
-
-  return subtree;
+  return WakeupTree(arena_, first);
 }
 
 void WakeupTree::remove_subtree_at_aid(aid_t proc)
 {
-  auto child = std::find_if(root_->children_.begin(), root_->children_.end(),
-                            [&](const auto& node) { return node->get_actor() == proc; });
-  if (child != root_->children_.end())
-    root_->children_.erase(child);
-}
-
-bool WakeupTree::contains(const WakeupTreeNode* node) const
-{
-  return std::find_if(this->root_->children_.begin(), this->root_->children_.end(),
-                      [=](const auto& pair) { return pair.get() == node; }) != this->root_->children_.end();
+  if (auto* child = root_->get_node_after_actor(proc); child != nullptr) {
+    unlink_from_root(child);
+    arena_->release(child);
+  }
 }
 
 void WakeupTree::insert_at_root(std::shared_ptr<Transition> u)
 {
-  std::unique_ptr<WakeupTreeNode> new_node = std::make_unique<WakeupTreeNode>(std::move(u));
-  this->root_->add_child(std::move(new_node));
+  add_child(root_, arena_->new_node(u));
 }
 
 InsertionResult WakeupTreeNode::recursive_insert(WakeupTree& father, PartialExecution& w)
@@ -133,8 +273,8 @@ InsertionResult WakeupTreeNode::recursive_insert(WakeupTree& father, PartialExec
   if (this->is_leaf() and not this->is_root())
     return InsertionResult::leaf;
 
-  for (auto& node : this->children_) {
-    const auto& next_E_p = node->action_;
+  for (auto* node : *this) {
+    const auto& next_E_p = node->action_->transition;
     // Is `p in `I_[E](w)`?
     if (const aid_t p = next_E_p->aid_; Execution::is_initial_after_execution_of(w, p)) {
       // Remove `p` from w and continue with this node
@@ -198,8 +338,8 @@ WakeupTreeNode* WakeupTreeNode::recursive_insert_and_get_inserted_seq(WakeupTree
   if (this->is_leaf())
     return this;
 
-  for (auto& node : this->children_) {
-    const auto& next_E_p = node->action_;
+  for (auto* node : *this) {
+    const auto& next_E_p = node->action_->transition;
     // Is `p in `I_[E](w)`?
     if (const aid_t p = next_E_p->aid_; Execution::is_initial_after_execution_of(w, p)) {
       // Remove `p` from w and continue with this node
@@ -260,38 +400,33 @@ WakeupTreeNode* WakeupTree::insert_sequence_after(WakeupTreeNode* node, const Pa
 {
   WakeupTreeNode* cur_node = node;
   for (const auto& w_i : w) {
-    std::unique_ptr<WakeupTreeNode> new_node = std::make_unique<WakeupTreeNode>(std::move(w_i));
-    auto tmp                                 = new_node.get();
-    cur_node->add_child(std::move(new_node));
-    cur_node = tmp;
+    WakeupTreeNode* child = arena_->new_node(w_i);
+    add_child(cur_node, child);
+    cur_node = child;
   }
   return cur_node;
 }
 
 WakeupTreeNode* WakeupTree::get_node_after_actor(aid_t aid) const
 {
-  for (auto const& node : root_->children_)
-    if (node->get_actor() == aid)
-      return node.get();
-
-  return nullptr;
+  return root_->get_node_after_actor(aid);
 }
 
 bool WakeupTreeNode::have_same_content(const WakeupTreeNode& n2) const
 {
-  return this->get_action() == n2.get_action();
+  return this->get_transition() == n2.get_transition();
 }
 
-bool WakeupTreeNode::is_contained_in(WakeupTreeNode& other_tree) const
+bool WakeupTreeNode::is_contained_in(const WakeupTreeNode& other_tree) const
 {
 
   if (not have_same_content(other_tree))
     return false;
 
-  for (auto& child : children_) {
-    auto other_candidate = std::find_if(other_tree.children_.begin(), other_tree.children_.end(),
-                                        [&](const auto& node) { return child->have_same_content(*node); });
-    if (other_candidate == other_tree.children_.end())
+  for (const auto* child : *this) {
+    auto other_candidate = std::find_if(other_tree.begin(), other_tree.end(),
+                                        [&](const auto* node) { return child->have_same_content(*node); });
+    if (other_candidate == other_tree.end())
       return false;
     if (not child->is_contained_in(**other_candidate))
       return false;
@@ -300,27 +435,23 @@ bool WakeupTreeNode::is_contained_in(WakeupTreeNode& other_tree) const
   return true;
 }
 
-bool WakeupTree::is_contained_in(WakeupTree& other_tree) const
+bool WakeupTree::is_contained_in(const WakeupTree& other_tree) const
 {
-  if (root_ == nullptr)
-    return true;
-  if (other_tree.root_ == nullptr)
-    return false; // if we are not empty but other is, we are not contained
   return this->root_->is_contained_in(*other_tree.root_);
 }
 
 void WakeupTree::force_insert(const PartialExecution& seq)
 {
-  WakeupTreeNode* cur_node = root_.get();
+  WakeupTreeNode* cur_node = root_;
   for (const auto& w_i : seq) {
     if (auto node_after_aid = cur_node->get_node_after_actor(w_i->aid_); node_after_aid != nullptr) {
       cur_node = node_after_aid;
       continue;
     }
 
-    std::unique_ptr<WakeupTreeNode> new_node = std::make_unique<WakeupTreeNode>(std::move(w_i));
-    cur_node->add_child(std::move(new_node));
-    cur_node = new_node.get();
+    WakeupTreeNode* child = arena_->new_node(w_i);
+    add_child(cur_node, child);
+    cur_node = child;
   }
 }
 
@@ -9,6 +9,9 @@
 #include "src/mc/explo/odpor/odpor_forward.hpp"
 #include "src/mc/transition/Transition.hpp"
 
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <string>
@@ -20,6 +23,9 @@ namespace simgrid::mc::odpor {
 /** @brief Describes how a tree insertion was carried out */
 enum class InsertionResult { leaf, interior_node, root };
 
+class WakeupTreeArena;
+struct WakeupTreeInternedTransition;
+
 /**
  * @brief A single node in a wakeup tree
  *
@@ -39,66 +45,72 @@ class WakeupTreeNode {
 private:
   WakeupTreeNode* parent_ = nullptr;
 
-  /** An ordered list of children of for this node in the tree */
-  std::list<std::unique_ptr<WakeupTreeNode>> children_ = {};
-
-  /** @brief The contents of the node */
-  std::shared_ptr<Transition> action_ = nullptr;
+  /** The children of this node form an ordered list, threaded through the nodes themselves */
+  WakeupTreeNode* first_child_  = nullptr;
+  WakeupTreeNode* last_child_   = nullptr;
+  WakeupTreeNode* next_sibling_ = nullptr;
 
-  /** @brief Removes the node as a child from the parent */
-  void detatch_from_parent();
-
-  PartialExecution sequence_ = PartialExecution{};
+  /** @brief The contents of the node, interned in the arena of the node (nullptr for the root) */
+  WakeupTreeInternedTransition* action_ = nullptr;
 
   /** Allows the owning tree to insert directly into the child */
   friend WakeupTree;
+  friend WakeupTreeArena;
 
 public:
-  explicit WakeupTreeNode(std::shared_ptr<Transition> u) : action_(u), sequence_({u}) {}
+  class const_iterator
+      : public boost::iterator_facade<const_iterator, WakeupTreeNode* const, boost::forward_traversal_tag,
+                                      WakeupTreeNode*> {
+    WakeupTreeNode* node_ = nullptr;
+
+    friend boost::iterator_core_access;
+    void increment() { node_ = node_->next_sibling_; }
+    bool equal(const const_iterator& other) const { return node_ == other.node_; }
+    WakeupTreeNode* dereference() const { return node_; }
+
+  public:
+    const_iterator() = default;
+    explicit const_iterator(WakeupTreeNode* node) : node_(node) {}
+  };
 
   WakeupTreeNode()                                 = default;
-  ~WakeupTreeNode()                                = default;
   WakeupTreeNode(const WakeupTreeNode&)            = delete;
-  WakeupTreeNode(WakeupTreeNode&&)                 = default;
   WakeupTreeNode& operator=(const WakeupTreeNode&) = delete;
-  WakeupTreeNode& operator=(WakeupTreeNode&&)      = default;
 
-  auto begin() const { return this->children_.begin(); }
-  auto end() const { return this->children_.end(); }
-  auto rbegin() const { return this->children_.rbegin(); }
-  auto rend() const { return this->children_.rend(); }
+  /** Iterates over the children of this node, in order */
+  const_iterator begin() const { return const_iterator(first_child_); }
+  const_iterator end() const { return const_iterator(); }
 
-  bool is_leaf() const { return children_.empty(); }
+  bool is_leaf() const { return first_child_ == nullptr; }
   bool is_root() const { return parent_ == nullptr; }
-  aid_t get_actor() const { return action_->aid_; }
-  const PartialExecution& get_sequence() const;
+  aid_t get_actor() const { return get_transition()->aid_; }
+
+  /** @brief The partial execution represented by this node, rebuilt from the path leading to it in the tree */
+  PartialExecution get_sequence() const;
 
   /** @brief Return a shared pointer to the transition if the action exists.
 
    *  @note that the root of a wakeup tree does not correspond to any action.
    *  In that case, get_action() return nullptr.
    **/
-  std::shared_ptr<Transition> get_action() const { return action_; }
-  const std::list<std::unique_ptr<WakeupTreeNode>>& get_ordered_children() const { return children_; }
+  std::shared_ptr<Transition> get_action() const;
+  Transition* get_transition() const;
 
   std::string string_of_whole_tree(const std::string& prefix, bool is_first, bool is_last) const;
 
-  /** Insert a node `node` as a new child of this node */
-  void add_child(std::unique_ptr<WakeupTreeNode> node);
-
   /**
    * @brief returns true iff calling object is a subset of called object
    *
    */
-  bool is_contained_in(WakeupTreeNode& other_tree) const;
+  bool is_contained_in(const WakeupTreeNode& other_tree) const;
 
   bool have_same_content(const WakeupTreeNode& n2) const;
 
   WakeupTreeNode* get_node_after_actor(aid_t aid) const
   {
-    for (auto const& node : children_)
+    for (auto* node : *this)
       if (node->get_actor() == aid)
-        return node.get();
+        return node;
 
     return nullptr;
   }
@@ -134,16 +146,31 @@ public:
  */
 class WakeupTree {
 private:
-  std::unique_ptr<WakeupTreeNode> root_;
+  /* The nodes are allocated in an arena, that is shared with the subtrees extracted from this tree (so that they can
+   * be handed to the child states without being copied). The nodes of the destroyed (sub)trees are recycled by the
+   * next insertions, and the arena is released with the last tree using it. */
+  std::shared_ptr<WakeupTreeArena> arena_;
+  WakeupTreeNode* root_ = nullptr;
+
+  WakeupTree(std::shared_ptr<WakeupTreeArena> arena, WakeupTreeNode* root);
+
+  void add_child(WakeupTreeNode* parent, WakeupTreeNode* child);
+  /** Detaches the given child of the root from the tree */
+  void unlink_from_root(WakeupTreeNode* child);
 
   // Returns a pointer to the lastly inserted node
   WakeupTreeNode* insert_sequence_after(WakeupTreeNode* node, const PartialExecution& w);
 
-  bool contains(const WakeupTreeNode* node) const;
-
 public:
   WakeupTree();
-  explicit WakeupTree(std::unique_ptr<WakeupTreeNode> root);
+  WakeupTree(const WakeupTree&)            = delete;
+  WakeupTree& operator=(const WakeupTree&) = delete;
+  WakeupTree(WakeupTree&& other) noexcept;
+  WakeupTree& operator=(WakeupTree&& other) noexcept;
+  ~WakeupTree();
+
+  /** Whether the trees may be created and destroyed by several threads at once (false by default) */
+  static void set_thread_safe(bool thread_safe);
 
   /**
    * @brief extract the subtree after the left-most action
@@ -163,7 +190,7 @@ public:
    * considered "empty" if it only contains the root node;
    * that is, if it is "uninteresting". In such a case,
    */
-  bool empty() const { return root_->children_.size() == 0; }
+  bool empty() const { return root_->is_leaf(); }
   /**
    * @brief Gets the actor of the node that is the "smallest" (with respect
    * to the tree's "<" relation) single-process node.
@@ -221,12 +248,12 @@ public:
   /**
    * @brief The number of children at depth one
    */
-  unsigned int count_direct_children() const { return root_->get_ordered_children().size(); }
+  unsigned int count_direct_children() const { return std::distance(root_->begin(), root_->end()); }
 
   std::vector<aid_t> get_direct_children_actors() const
   {
     std::vector<aid_t> result;
-    for (auto const& leaf : root_->get_ordered_children())
+    for (auto const* leaf : *root_)
       result.push_back(leaf->get_actor());
     return result;
   }
@@ -243,7 +270,7 @@ public:
    * @brief returns true iff calling object is a subset of called object
    *
    */
-  bool is_contained_in(WakeupTree& other_tree) const;
+  bool is_contained_in(const WakeupTree& other_tree) const;
 
   /**
    * @brief insert a sequence in the wakeup tree as though it was a normal tree.
@@ -9,6 +9,9 @@
 #include "src/mc/explo/odpor/odpor_forward.hpp"
 #include "src/mc/explo/udpor/udpor_tests_private.hpp"
 
+#include <algorithm>
+#include <set>
+
 using namespace simgrid::mc;
 using namespace simgrid::mc::odpor;
 using namespace simgrid::mc::udpor;
@@ -17,8 +20,8 @@ static PartialExecution get_node_post_order_traversal(const WakeupTreeNode* node
 {
 
   PartialExecution traversal = {};
-  for (auto const& child : node->get_ordered_children()) {
-    auto recursive_traversal = get_node_post_order_traversal(child.get());
+  for (auto const* child : *node) {
+    auto recursive_traversal = get_node_post_order_traversal(child);
     traversal.insert(traversal.end(), recursive_traversal.begin(), recursive_traversal.end());
   }
 
@@ -39,6 +42,21 @@ static PartialExecution get_tree_post_order_traversal(const WakeupTree& tree)
   return traversal;
 }
 
+static void collect_nodes(const WakeupTreeNode* node, std::set<const WakeupTreeNode*>& nodes)
+{
+  nodes.insert(node);
+  for (auto const* child : *node)
+    collect_nodes(child, nodes);
+}
+
+static std::set<const WakeupTreeNode*> get_tree_nodes(const WakeupTree& tree)
+{
+  std::set<const WakeupTreeNode*> nodes;
+  for (auto const& child_aid : tree.get_direct_children_actors())
+    collect_nodes(tree.get_node_after_actor(child_aid), nodes);
+  return nodes;
+}
+
 static void compare_tree(const WakeupTree& tree, PartialExecution seq)
 {
   REQUIRE(get_tree_post_order_traversal(tree) == seq);
@@ -122,6 +140,33 @@ TEST_CASE("simgrid::mc::odpor::WakeupTree: Constructing Trees")
       REQUIRE(tree.empty());
     }
 
+    SECTION("The nodes of the removed subtrees are reused by the next insertions")
+    {
+      auto subtree_a1          = tree.get_first_subtree();
+      const auto subtree_nodes = get_tree_nodes(subtree_a1);
+      const auto removed_nodes = get_tree_nodes(tree);
+      tree.remove_subtree_at_aid(a4->aid_);
+      REQUIRE(tree.empty());
+
+      // The subtree shares the arena of the tree, but its nodes are not recycled by the next insertions in the tree:
+      // only the ones of the removed subtree are
+      REQUIRE(tree.insert({a2, a1, a5}) == InsertionResult::root);
+      REQUIRE(tree.insert_and_get_inserted_seq({a2, a3}) == PartialExecution{a2, a3});
+      compare_tree(tree, {a5, a1, a3, a2});
+      compare_tree(subtree_a1, {a4, a3, a2, a4, a2, a5, a3});
+      const auto new_nodes = get_tree_nodes(tree);
+      REQUIRE(std::none_of(new_nodes.begin(), new_nodes.end(),
+                           [&subtree_nodes](const auto* node) { return subtree_nodes.count(node) > 0; }));
+      REQUIRE(std::any_of(new_nodes.begin(), new_nodes.end(),
+                          [&removed_nodes](const auto* node) { return removed_nodes.count(node) > 0; }));
+      REQUIRE(get_tree_nodes(subtree_a1) == subtree_nodes);
+
+      // Moving a tree keeps its nodes in place
+      WakeupTree moved = std::move(subtree_a1);
+      REQUIRE(moved.insert_and_get_inserted_seq({a3, a4, a0}) == PartialExecution{a3, a4, a0});
+      compare_tree(moved, {a4, a3, a2, a4, a2, a5, a0, a4, a3});
+    }
+
     SECTION("Removing the first single-process subtree from an empty tree has no effect")
     {
       WakeupTree empty_tree;
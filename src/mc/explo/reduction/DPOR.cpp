@@ -5,6 +5,7 @@
 
 #include "src/mc/explo/reduction/DPOR.hpp"
 #include "src/mc/explo/Exploration.hpp"
+#include "src/mc/transition/DependencyOracle.hpp"
 #include "xbt/asserts.h"
 #include "xbt/log.h"
 #include <cstddef>
@@ -24,7 +25,7 @@ std::optional<EventHandle> DPOR::max_dependent_dpor(const odpor::Execution& S, c
     auto past_transition      = S.get_transition_for_handle(i - 1);
     auto next_transition_of_p = s->get_transition_in();
 
-    if (past_transition->depends(next_transition_of_p.get()) &&
+    if (DependencyOracle::depends(past_transition, next_transition_of_p.get()) &&
         past_transition->can_be_co_enabled(next_transition_of_p.get()) && not S.happens_before_process(i - 1, p))
       return i - 1;
   }
@@ -54,6 +54,11 @@ int main(int argc, char** argv)
 #endif
   }
 
+  // The initial process of a swarm only coordinates the workers, that go on below with their own configuration
+  if (_sg_mc_explore_algo == "swarm")
+    if (auto verdict = run_swarm_exploration(get_model_checking_reduction()))
+      return static_cast<int>(*verdict);
+
   std::unique_ptr<Exploration> explo;
 
   if (_sg_mc_comms_determinism || _sg_mc_send_determinism)
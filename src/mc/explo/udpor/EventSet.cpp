@@ -14,16 +14,80 @@
 
 namespace simgrid::mc::udpor {
 
+std::deque<const UnfoldingEvent*> EventSet::events_by_id_;
+
+unsigned long EventSet::register_event(const UnfoldingEvent* e)
+{
+  // Ids start at 1, as they always did
+  if (events_by_id_.empty())
+    events_by_id_.push_back(nullptr);
+  events_by_id_.push_back(e);
+  return events_by_id_.size() - 1;
+}
+
+void EventSet::unregister_event(unsigned long id)
+{
+  events_by_id_[id] = nullptr;
+}
+
+static unsigned long get_id(const UnfoldingEvent* e)
+{
+  return e->get_id();
+}
+
 EventSet::EventSet(const Configuration& config) : EventSet(config.get_events()) {}
 
+EventSet::EventSet(const std::vector<const UnfoldingEvent*>& raw_events)
+{
+  for (const auto* e : raw_events)
+    insert(e);
+}
+
+EventSet::EventSet(std::initializer_list<const UnfoldingEvent*> event_list)
+{
+  for (const auto* e : event_list)
+    insert(e);
+}
+
+EventSet::const_iterator EventSet::begin() const
+{
+  return const_iterator(words_.data(), words_.data() + words_.size());
+}
+
+EventSet::const_iterator EventSet::end() const
+{
+  return const_iterator(words_.data() + words_.size(), words_.data() + words_.size());
+}
+
 void EventSet::remove(const UnfoldingEvent* e)
 {
-  this->events_.erase(e);
+  if (e == nullptr) // No set contains it
+    return;
+  const unsigned long id = get_id(e);
+  auto word = std::lower_bound(words_.begin(), words_.end(), id / word_size,
+                               [](const Word& w, unsigned long index) { return w.index < index; });
+  if (word == words_.end() || word->index != id / word_size)
+    return;
+  word->bits &= ~(uint64_t{1} << (id % word_size));
+  if (word->bits == 0)
+    words_.erase(word);
 }
 
 void EventSet::subtract(const EventSet& other)
 {
-  this->events_ = std::move(subtracting(other).events_);
+  // Clear the bits of the other set in place, and drop the words that become empty
+  auto theirs = other.words_.begin();
+  auto kept   = words_.begin();
+  for (auto const& word : words_) {
+    while (theirs != other.words_.end() && theirs->index < word.index)
+      ++theirs;
+    uint64_t bits = word.bits;
+    if (theirs != other.words_.end() && theirs->index == word.index)
+      bits &= ~theirs->bits;
+    if (bits != 0)
+      *kept++ = Word{word.index, bits};
+  }
+  words_.erase(kept, words_.end());
 }
 
 void EventSet::subtract(const Configuration& config)
@@ -33,12 +97,9 @@ void EventSet::subtract(const Configuration& config)
 
 EventSet EventSet::subtracting(const EventSet& other) const
 {
-  std::unordered_set<const UnfoldingEvent*> result = this->events_;
-
-  for (const UnfoldingEvent* e : other.events_)
-    result.erase(e);
-
-  return EventSet(std::move(result));
+  EventSet result = *this;
+  result.subtract(other);
+  return result;
 }
 
 EventSet EventSet::subtracting(const Configuration& config) const
@@ -48,19 +109,25 @@ EventSet EventSet::subtracting(const Configuration& config) const
 
 EventSet EventSet::subtracting(const UnfoldingEvent* e) const
 {
-  auto result = this->events_;
-  result.erase(e);
-  return EventSet(std::move(result));
+  EventSet result = *this;
+  result.remove(e);
+  return result;
 }
 
 void EventSet::insert(const UnfoldingEvent* e)
 {
-  this->events_.insert(e);
+  xbt_assert(e != nullptr, "Cannot insert a null event in an event set");
+  const unsigned long id = get_id(e);
+  auto word = std::lower_bound(words_.begin(), words_.end(), id / word_size,
+                               [](const Word& w, unsigned long index) { return w.index < index; });
+  if (word == words_.end() || word->index != id / word_size)
+    word = words_.insert(word, Word{id / word_size, 0});
+  word->bits |= uint64_t{1} << (id % word_size);
 }
 
 void EventSet::form_union(const EventSet& other)
 {
-  this->events_ = std::move(make_union(other).events_);
+  this->words_ = std::move(make_union(other).words_);
 }
 
 void EventSet::form_union(const Configuration& config)
@@ -70,19 +137,31 @@ void EventSet::form_union(const Configuration& config)
 
 EventSet EventSet::make_union(const UnfoldingEvent* e) const
 {
-  auto result = this->events_;
+  EventSet result = *this;
   result.insert(e);
-  return EventSet(std::move(result));
+  return result;
 }
 
 EventSet EventSet::make_union(const EventSet& other) const
 {
-  std::unordered_set<const UnfoldingEvent*> result = this->events_;
-
-  for (const UnfoldingEvent* e : other.events_)
-    result.insert(e);
-
-  return EventSet(std::move(result));
+  if (other.words_.empty())
+    return *this;
+  if (words_.empty())
+    return other;
+
+  EventSet result;
+  result.words_.reserve(std::max(words_.size(), other.words_.size()));
+  auto ours   = words_.begin();
+  auto theirs = other.words_.begin();
+  while (ours != words_.end() || theirs != other.words_.end()) {
+    if (theirs == other.words_.end() || (ours != words_.end() && ours->index < theirs->index))
+      result.words_.push_back(*ours++);
+    else if (ours == words_.end() || theirs->index < ours->index)
+      result.words_.push_back(*theirs++);
+    else
+      result.words_.push_back(Word{ours->index, (ours++)->bits | (theirs++)->bits});
+  }
+  return result;
 }
 
 EventSet EventSet::make_union(const Configuration& config) const
@@ -92,15 +171,17 @@ EventSet EventSet::make_union(const Configuration& config) const
 
 EventSet EventSet::make_intersection(const EventSet& other) const
 {
-  std::unordered_set<const UnfoldingEvent*> result;
-
-  for (const UnfoldingEvent* e : other.events_) {
-    if (contains(e)) {
-      result.insert(e);
-    }
+  EventSet result;
+  auto theirs = other.words_.begin();
+  for (auto const& word : words_) {
+    while (theirs != other.words_.end() && theirs->index < word.index)
+      ++theirs;
+    if (theirs == other.words_.end())
+      break;
+    if (theirs->index == word.index && (word.bits & theirs->bits) != 0)
+      result.words_.push_back(Word{word.index, word.bits & theirs->bits});
   }
-
-  return EventSet(std::move(result));
+  return result;
 }
 
 EventSet EventSet::get_local_config() const
@@ -110,17 +191,25 @@ EventSet EventSet::get_local_config() const
 
 size_t EventSet::size() const
 {
-  return this->events_.size();
+  size_t size = 0;
+  for (auto const& word : words_)
+    size += __builtin_popcountll(word.bits);
+  return size;
 }
 
 bool EventSet::empty() const
 {
-  return this->events_.empty();
+  return this->words_.empty();
 }
 
 bool EventSet::contains(const UnfoldingEvent* e) const
 {
-  return this->events_.find(e) != this->events_.end();
+  if (e == nullptr)
+    return false;
+  const unsigned long id = get_id(e);
+  auto word = std::lower_bound(words_.begin(), words_.end(), id / word_size,
+                               [](const Word& w, unsigned long index) { return w.index < index; });
+  return word != words_.end() && word->index == id / word_size && (word->bits >> (id % word_size)) & 1;
 }
 
 bool EventSet::contains_equivalent_to(const UnfoldingEvent* e) const
@@ -130,10 +219,14 @@ bool EventSet::contains_equivalent_to(const UnfoldingEvent* e) const
 
 bool EventSet::is_subset_of(const EventSet& other) const
 {
-  // If there is some element not contained in `other`, then
-  // the set difference will contain that element and the
-  // result won't be empty
-  return subtracting(other).empty();
+  auto theirs = other.words_.begin();
+  for (auto const& word : words_) {
+    while (theirs != other.words_.end() && theirs->index < word.index)
+      ++theirs;
+    if (theirs == other.words_.end() || theirs->index != word.index || (word.bits & ~theirs->bits) != 0)
+      return false;
+  }
+  return true;
 }
 
 bool EventSet::is_valid_configuration() const
@@ -162,7 +255,16 @@ bool EventSet::intersects(const History& history) const
 
 bool EventSet::intersects(const EventSet& other) const
 {
-  return std::any_of(other.begin(), other.end(), [=](const UnfoldingEvent* e) { return this->contains(e); });
+  auto theirs = other.words_.begin();
+  for (auto const& word : words_) {
+    while (theirs != other.words_.end() && theirs->index < word.index)
+      ++theirs;
+    if (theirs == other.words_.end())
+      return false;
+    if (theirs->index == word.index && (word.bits & theirs->bits) != 0)
+      return true;
+  }
+  return false;
 }
 
 EventSet EventSet::get_largest_maximal_subset() const
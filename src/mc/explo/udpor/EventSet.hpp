@@ -9,36 +9,86 @@
 #include "src/mc/explo/udpor/udpor_forward.hpp"
 
 #include <algorithm>
+#include <boost/iterator/iterator_facade.hpp>
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <initializer_list>
-#include <unordered_set>
 #include <vector>
 #include <xbt/asserts.h>
 
 namespace simgrid::mc::udpor {
 
+/**
+ * @brief A set of events of an unfolding
+ *
+ * The events are stored as a compressed bitset over their ids: the sorted list of the 64-bit words of the bitset that
+ * have at least one bit set, along with their position. The set operations then work on whole words, and the memory
+ * stays proportional to the amount of events even when their ids are far apart. The events are enumerated by increasing
+ * id, that is, in the order in which they were created.
+ */
 class EventSet {
 private:
-  std::unordered_set<const UnfoldingEvent*> events_;
+  struct Word {
+    unsigned long index; // The ids of the events of this word are in [64 * index, 64 * index + 63]
+    uint64_t bits;
+    bool operator==(const Word& other) const { return index == other.index && bits == other.bits; }
+  };
+  static constexpr unsigned word_size = 64;
+  std::vector<Word> words_;
+
+  /** All the events ever created, indexed by their id (nullptr once destroyed) */
+  static std::deque<const UnfoldingEvent*> events_by_id_;
+  static unsigned long register_event(const UnfoldingEvent* e);
+  static void unregister_event(unsigned long id);
+  friend UnfoldingEvent;
 
 public:
+  class const_iterator
+      : public boost::iterator_facade<const_iterator, const UnfoldingEvent* const, boost::forward_traversal_tag> {
+    const Word* word_        = nullptr;
+    const Word* last_        = nullptr;
+    uint64_t remaining_bits_ = 0; // The bits of the current word that are not enumerated yet, including the current one
+
+    friend class boost::iterator_core_access;
+    void increment()
+    {
+      remaining_bits_ &= remaining_bits_ - 1;
+      if (remaining_bits_ == 0 && ++word_ != last_)
+        remaining_bits_ = word_->bits;
+    }
+    bool equal(const const_iterator& other) const
+    {
+      return word_ == other.word_ && remaining_bits_ == other.remaining_bits_;
+    }
+    const UnfoldingEvent* const& dereference() const
+    {
+      return events_by_id_[word_->index * word_size + __builtin_ctzll(remaining_bits_)];
+    }
+
+  public:
+    const_iterator() = default;
+    const_iterator(const Word* word, const Word* last)
+        : word_(word), last_(last), remaining_bits_(word != last ? word->bits : 0)
+    {
+    }
+  };
+  using iterator   = const_iterator;
+  using value_type = const UnfoldingEvent*;
+
   EventSet()                           = default;
   EventSet(const EventSet&)            = default;
   EventSet& operator=(const EventSet&) = default;
   EventSet& operator=(EventSet&&)      = default;
   EventSet(EventSet&&)                 = default;
   explicit EventSet(const Configuration& config);
-  explicit EventSet(const std::vector<const UnfoldingEvent*>& raw_events)
-      : events_(raw_events.begin(), raw_events.end())
-  {
-  }
-  explicit EventSet(std::unordered_set<const UnfoldingEvent*>&& raw_events) : events_(std::move(raw_events)) {}
-  explicit EventSet(std::initializer_list<const UnfoldingEvent*> event_list) : events_(std::move(event_list)) {}
-
-  auto begin() const { return this->events_.begin(); }
-  auto end() const { return this->events_.end(); }
-  auto cbegin() const { return this->events_.cbegin(); }
-  auto cend() const { return this->events_.cend(); }
+  explicit EventSet(const std::vector<const UnfoldingEvent*>& raw_events);
+  explicit EventSet(std::initializer_list<const UnfoldingEvent*> event_list);
+
+  const_iterator begin() const;
+  const_iterator end() const;
+  const_iterator cbegin() const { return begin(); }
+  const_iterator cend() const { return end(); }
 
   void remove(const UnfoldingEvent*);
   void subtract(const EventSet&);
@@ -66,8 +116,8 @@ public:
   bool intersects(const History&) const;
   bool is_subset_of(const EventSet&) const;
 
-  bool operator==(const EventSet& other) const { return this->events_ == other.events_; }
-  bool operator!=(const EventSet& other) const { return this->events_ != other.events_; }
+  bool operator==(const EventSet& other) const { return this->words_ == other.words_; }
+  bool operator!=(const EventSet& other) const { return this->words_ != other.words_; }
   std::string to_string() const;
 
   /**
@@ -165,10 +215,6 @@ public:
    * @brief Moves the event set into a list
    */
   std::vector<const UnfoldingEvent*> move_into_vector() const&&;
-
-  using iterator       = decltype(events_)::iterator;
-  using const_iterator = decltype(events_)::const_iterator;
-  using value_type     = decltype(events_)::value_type;
 };
 
 } // namespace simgrid::mc::udpor
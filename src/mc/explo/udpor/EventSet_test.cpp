@@ -10,6 +10,9 @@
 #include "src/mc/explo/udpor/udpor_tests_private.hpp"
 #include "src/xbt/utils/iter/LazyPowerset.hpp"
 
+#include <algorithm>
+#include <set>
+
 using namespace simgrid::xbt;
 using namespace simgrid::mc::udpor;
 
@@ -1142,3 +1145,69 @@ TEST_CASE("simgrid::mc::udpor::EventSet: Topological Ordering Property Observed
     }
   }
 }
+
+TEST_CASE("simgrid::mc::udpor::EventSet: Sets spanning many words")
+{
+  // Enough events for their ids to span several words of the underlying bitset
+  std::vector<UnfoldingEvent> events(200);
+  std::set<const UnfoldingEvent*> ref_A;
+  std::set<const UnfoldingEvent*> ref_B;
+  EventSet A;
+  EventSet B;
+  for (size_t i = 0; i < events.size(); i++) {
+    if (i % 3 == 0 || (i > 64 && i < 100)) {
+      A.insert(&events[i]);
+      ref_A.insert(&events[i]);
+    }
+    if (i % 5 == 0 || i > 150) {
+      B.insert(&events[i]);
+      ref_B.insert(&events[i]);
+    }
+  }
+
+  const auto matches = [](const EventSet& set, const std::set<const UnfoldingEvent*>& ref) {
+    if (set.size() != ref.size())
+      return false;
+    return std::all_of(ref.begin(), ref.end(), [&set](const auto* e) { return set.contains(e); });
+  };
+  REQUIRE(matches(A, ref_A));
+  REQUIRE(matches(B, ref_B));
+
+  SECTION("Iteration follows the order of the ids")
+  {
+    unsigned long last_id = 0;
+    size_t count          = 0;
+    for (const auto* e : A) {
+      REQUIRE(e->get_id() > last_id);
+      last_id = e->get_id();
+      count++;
+    }
+    REQUIRE(count == ref_A.size());
+  }
+
+  SECTION("Set operations")
+  {
+    std::set<const UnfoldingEvent*> ref_union = ref_A;
+    ref_union.insert(ref_B.begin(), ref_B.end());
+    std::set<const UnfoldingEvent*> ref_intersection;
+    std::set<const UnfoldingEvent*> ref_difference;
+    for (const auto* e : ref_A)
+      (ref_B.count(e) ? ref_intersection : ref_difference).insert(e);
+
+    REQUIRE(matches(A.make_union(B), ref_union));
+    REQUIRE(matches(A.make_intersection(B), ref_intersection));
+    REQUIRE(matches(A.subtracting(B), ref_difference));
+    REQUIRE(A.intersects(B));
+    REQUIRE_FALSE(A.subtracting(B).intersects(B));
+    REQUIRE(A.make_intersection(B).is_subset_of(A));
+    REQUIRE(A.make_intersection(B).is_subset_of(B));
+    REQUIRE_FALSE(A.is_subset_of(B));
+
+    EventSet C = A;
+    C.subtract(B);
+    REQUIRE(C == A.subtracting(B));
+    for (const auto* e : ref_difference)
+      C.remove(e);
+    REQUIRE(C.empty());
+  }
+}
@@ -6,6 +6,7 @@
 #include "src/mc/explo/udpor/UnfoldingEvent.hpp"
 #include "src/mc/explo/Exploration.hpp"
 #include "src/mc/explo/udpor/History.hpp"
+#include "src/mc/transition/DependencyOracle.hpp"
 
 #include <xbt/asserts.h>
 #include <xbt/log.h>
@@ -21,10 +22,31 @@ UnfoldingEvent::UnfoldingEvent(std::initializer_list<const UnfoldingEvent*> init
 }
 
 UnfoldingEvent::UnfoldingEvent(EventSet immediate_causes, std::shared_ptr<Transition> transition)
-    : associated_transition(std::move(transition)), immediate_causes(std::move(immediate_causes))
+    : associated_transition(std::move(transition))
+    , immediate_causes(std::move(immediate_causes))
+    , id(EventSet::register_event(this))
 {
-  static uint64_t event_id = 0;
-  this->id                 = ++event_id;
+}
+
+UnfoldingEvent::UnfoldingEvent(const UnfoldingEvent& other)
+    : associated_transition(other.associated_transition)
+    , immediate_causes(other.immediate_causes)
+    , id(EventSet::register_event(this))
+    , has_been_executed_(other.has_been_executed_)
+{
+}
+
+UnfoldingEvent& UnfoldingEvent::operator=(UnfoldingEvent const& other)
+{
+  associated_transition = other.associated_transition;
+  immediate_causes      = other.immediate_causes;
+  has_been_executed_    = other.has_been_executed_;
+  return *this;
+}
+
+UnfoldingEvent::~UnfoldingEvent()
+{
+  EventSet::unregister_event(id);
 }
 
 bool UnfoldingEvent::operator==(const UnfoldingEvent& other) const
@@ -154,7 +176,7 @@ bool UnfoldingEvent::immediately_conflicts_with(const UnfoldingEvent* other) con
 
 bool UnfoldingEvent::is_dependent_with(const Transition* t) const
 {
-  return associated_transition->depends(t);
+  return DependencyOracle::depends(associated_transition.get(), t);
 }
 
 bool UnfoldingEvent::is_dependent_with(const UnfoldingEvent* other) const
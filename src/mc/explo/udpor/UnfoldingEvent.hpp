@@ -22,9 +22,10 @@ public:
   UnfoldingEvent(EventSet immediate_causes              = EventSet(),
                  std::shared_ptr<Transition> transition = std::make_unique<Transition>());
 
-  UnfoldingEvent(const UnfoldingEvent&)            = default;
-  UnfoldingEvent& operator=(UnfoldingEvent const&) = default;
-  UnfoldingEvent(UnfoldingEvent&&)                 = default;
+  /* A copy is a different event, with its own id */
+  UnfoldingEvent(const UnfoldingEvent& other);
+  UnfoldingEvent& operator=(UnfoldingEvent const&);
+  ~UnfoldingEvent();
 
   EventSet get_history() const;
   EventSet get_local_config() const;
@@ -102,7 +103,7 @@ private:
 
   /**
    * @brief An identifier which is used to sort events
-   * deterministically
+   * deterministically, and to index them in event sets
    */
   unsigned long id = 0;
 
@@ -49,6 +49,14 @@ void MC_assert(int prop)
 #endif
 }
 
+void MC_declare_state(const void* addr, size_t size)
+{
+#if SIMGRID_HAVE_MC
+  if (auto* app = AppSide::get())
+    app->declare_state(addr, size);
+#endif
+}
+
 int MC_is_active()
 {
   return get_model_checking_mode() == ModelCheckingMode::APP_SIDE ||
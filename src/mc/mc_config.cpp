@@ -74,7 +74,17 @@ simgrid::config::Flag<std::string> _sg_mc_explore_algo{
       "Best First Search: this search politic allows for a better use of the strategy by augmenting the number of "
       "state choices available at runtime."},
      {"parallel",
-      "parallel search: this work-in-progress aims at leveraging BeFS algorithm to heavily parallelize the search."}}};
+      "parallel search: several threads explore the state space, each with its own application (see "
+      "model-check/parallel-workers)."},
+     {"swarm",
+      "swarm search: several independent and randomized explorations run in separate processes, until the first of "
+      "them ends (see model-check/parallel-workers)."}}};
+
+simgrid::config::Flag<int> _sg_mc_parallel_workers{
+    "model-check/parallel-workers",
+    "Amount of threads exploring the state space in parallel, each with its own application process, when the parallel "
+    "exploration algorithm is used, or amount of processes of the swarm exploration algorithm (0: one per core)",
+    0, [](int val) { xbt_assert(val >= 0, "The value of model-check/parallel-workers must be positive or null"); }};
 
 simgrid::config::Flag<std::string> _sg_mc_strategy{
     "model-check/strategy",
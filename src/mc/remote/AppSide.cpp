@@ -424,6 +424,81 @@ void AppSide::handle_actors_maxpid()
   xbt_assert(channel_.send(answer) == 0, "Could not send response: %s", strerror(errno));
 }
 
+/* Word-wise hashing of memory areas, with two different seeds and multipliers to get two independent hashes */
+class StateHasher {
+  uint64_t hash_  = 0x9e3779b97f4a7c15ULL;
+  uint64_t check_ = 0xc2b2ae3d27d4eb4fULL;
+
+  static uint64_t mix(uint64_t h, uint64_t word, uint64_t mult)
+  {
+    h ^= word * mult;
+    return ((h << 31) | (h >> 33)) * 0x87c37b91114253d5ULL;
+  }
+  static uint64_t finalize(uint64_t h) // the finalizer of splitmix64
+  {
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    return h ^ (h >> 31);
+  }
+
+  void add_word(uint64_t word)
+  {
+    hash_  = mix(hash_, word, 0xff51afd7ed558ccdULL);
+    check_ = mix(check_, word, 0xc4ceb9fe1a85ec53ULL);
+  }
+
+public:
+  void add(const void* data, size_t size)
+  {
+    // Start with the size, so that the concatenation of two areas is not ambiguous
+    add_word(size);
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    size_t i          = 0;
+    for (; i + sizeof(uint64_t) <= size; i += sizeof(uint64_t)) {
+      uint64_t word;
+      memcpy(&word, bytes + i, sizeof word);
+      add_word(word);
+    }
+    if (i < size) {
+      uint64_t tail = 0;
+      memcpy(&tail, bytes + i, size - i);
+      add_word(tail);
+    }
+  }
+  uint64_t get_hash() const { return finalize(hash_); }
+  uint64_t get_check() const { return finalize(check_); }
+};
+
+void AppSide::handle_state_fingerprint()
+{
+  // The state of the application is made of the memory declared by the user, and of what each actor is about to do.
+  // That second part is hashed from the serialization of the simcall of each actor (as sent in ACTORS_STATUS).
+  StateHasher hasher;
+  for (auto const& [addr, size] : declared_state_)
+    hasher.add(addr, size);
+
+  const size_t mark = channel_.get_packed_size();
+  for (auto const& [aid, actor] : kernel::EngineImpl::get_instance()->get_actor_list()) {
+    channel_.pack(aid);
+    channel_.pack(mc::actor_is_enabled(actor));
+    auto* observer           = actor->simcall_.observer_;
+    const int max_considered = observer != nullptr ? observer->get_max_consider() : 0;
+    channel_.pack(max_considered);
+    for (int times_considered = 0; times_considered < max_considered; times_considered++) {
+      observer->prepare(times_considered);
+      observer->serialize(channel_);
+    }
+  }
+  hasher.add(channel_.get_packed_data() + mark, channel_.get_packed_size() - mark);
+  channel_.discard_packed(mark);
+
+  s_mc_message_fingerprint_t answer = {};
+  answer.type                       = MessageType::STATE_FINGERPRINT_REPLY;
+  answer.hash                       = hasher.get_hash();
+  answer.check                      = hasher.get_check();
+  xbt_assert(channel_.send(answer) == 0, "Could not send response: %s", strerror(errno));
+}
+
 void AppSide::handle_messages()
 {
   while (true) { // Until we get a CONTINUE message
@@ -488,6 +563,11 @@ void AppSide::handle_messages()
         handle_actors_maxpid();
         break;
 
+      case MessageType::STATE_FINGERPRINT:
+        received = channel_.receive(sizeof(s_mc_message_t));
+        handle_state_fingerprint();
+        break;
+
       default:
         xbt_die("Received unexpected message %s (%i)", to_c_str(msg_type), static_cast<int>(msg_type));
         break;
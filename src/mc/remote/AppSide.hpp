@@ -13,6 +13,8 @@
 
 #include <memory>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace simgrid::mc {
 
@@ -25,6 +27,7 @@ private:
   Channel channel_;
   static std::unique_ptr<AppSide> instance_;
   std::unordered_map<int, int> child_statuses_;
+  std::vector<std::pair<const void*, size_t>> declared_state_; // See MC_declare_state()
 
 public:
   AppSide();
@@ -41,12 +44,14 @@ private:
   void handle_wait_child(const s_mc_message_int_t* msg);
   void handle_actors_status(const s_mc_message_actors_status_t* msg);
   void handle_actors_maxpid();
+  void handle_state_fingerprint();
 
 public:
   Channel const& get_channel() const { return channel_; }
   Channel& get_channel() { return channel_; }
   XBT_ATTRIB_NORETURN void main_loop();
   void report_assertion_failure();
+  void declare_state(const void* addr, size_t size) { declared_state_.emplace_back(addr, size); }
 
   // TODO, remove the singleton antipattern.
   static AppSide* get();
@@ -57,6 +57,10 @@ public:
   template <class T> void pack(T data) { pack(&data, sizeof(T)); }
   void pack(const void* message, size_t size); // queue something for later emission
   int send();                                  // Send everything that was packed
+  // Inspect or discard what was packed so far, to use the serialization code for other purposes than sending
+  size_t get_packed_size() const { return buffer_out_size_; }
+  const char* get_packed_data() const { return buffer_out_; }
+  void discard_packed(size_t size) { buffer_out_size_ = size; }
 
   // Receive
   std::pair<bool, void*> receive(size_t size);
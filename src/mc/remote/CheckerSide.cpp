@@ -48,7 +48,8 @@ static simgrid::config::Flag<std::string> _sg_mc_setenv{
 
 namespace simgrid::mc {
 
-unsigned CheckerSide::count_ = 0;
+std::atomic<unsigned> CheckerSide::count_ = 0;
+std::mutex CheckerSide::parent_lock_;
 
 XBT_ATTRIB_NORETURN static void run_child_process(int socket, const std::vector<char*>& args)
 {
@@ -186,9 +187,12 @@ std::unique_ptr<CheckerSide> CheckerSide::clone(int master_socket, const std::st
   m.type                = MessageType::FORK;
   xbt_assert(master_socket_name.size() == MC_SOCKET_NAME_LEN);
   std::copy_n(begin(master_socket_name), MC_SOCKET_NAME_LEN, begin(m.socket_name));
+
+  std::unique_lock lock(parent_lock_); // Make sure that we accept the connection of the app we asked to fork
   xbt_assert(get_channel().send(m) == 0, "Could not ask the app to fork on need.");
 
   int sock = accept(master_socket, nullptr /* I know who's connecting*/, nullptr);
+  lock.unlock();
   if (sock <= 0) {
     switch (errno) {
       case EMFILE:
@@ -399,6 +403,7 @@ void CheckerSide::handle_waitpid()
     }
 
   } else { // Ask our proxy to wait for us
+    std::unique_lock lock(parent_lock_);
     s_mc_message_int_t request = {};
     request.type               = MessageType::WAIT_CHILD;
     request.value              = pid_;
@@ -407,8 +412,10 @@ void CheckerSide::handle_waitpid()
 
     auto answer = (s_mc_message_int_t*)child_checker_->get_channel().expect_message(
         sizeof(s_mc_message_int_t), MessageType::WAIT_CHILD_REPLY, "Could not receive MessageType::WAIT_CHILD_REPLY");
+    const int status = answer->value;
+    lock.unlock();
 
-    handle_dead_child(answer->value);
+    handle_dead_child(status);
   }
 }
 
@@ -10,7 +10,9 @@
 #include "src/mc/remote/Channel.hpp"
 #include "src/mc/transition/Transition.hpp"
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 namespace simgrid::mc {
 
@@ -19,7 +21,10 @@ namespace simgrid::mc {
 class CheckerSide {
   Channel channel_;
   pid_t pid_;
-  static unsigned count_;
+  static std::atomic<unsigned> count_;
+  // Serializes the FORK and WAIT_CHILD exchanges, that go through the channel of another CheckerSide (or through the
+  // master socket) and could get mixed up when several explorer threads use the same parent concurrently
+  static std::mutex parent_lock_;
   // Because of the way we fork, the real app is our grandchild.
   // child_checker_ is a CheckerSide to our child that can waitpid our grandchild on our behalf
   CheckerSide* child_checker_ = nullptr;
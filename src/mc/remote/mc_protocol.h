@@ -25,7 +25,7 @@ XBT_DECLARE_ENUM_CLASS(MessageType, NONE, FORK, FORK_REPLY, WAIT_CHILD, WAIT_CHI
                        DEADLOCK_CHECK_REPLY, WAITING, SIMCALL_EXECUTE, SIMCALL_EXECUTE_REPLY, ASSERTION_FAILED,
                        ACTORS_STATUS, ACTORS_STATUS_REPLY_COUNT, ACTORS_STATUS_REPLY_SIMCALL,
                        ACTORS_STATUS_REPLY_TRANSITION, ACTORS_MAXPID, ACTORS_MAXPID_REPLY, FINALIZE, FINALIZE_REPLY,
-                       REPLAY, GO_ONE_WAY);
+                       REPLAY, GO_ONE_WAY, STATE_FINGERPRINT, STATE_FINGERPRINT_REPLY);
 } // namespace simgrid::mc
 
 constexpr unsigned MC_MESSAGE_LENGTH                 = 48 * 1024 * 1024;
@@ -87,6 +87,13 @@ struct s_mc_message_one_way_t {
   bool is_random;
 };
 
+/* Two independent hashes of the state of the application: the second one detects the collisions of the first one */
+struct s_mc_message_fingerprint_t {
+  simgrid::mc::MessageType type;
+  uint64_t hash;
+  uint64_t check;
+};
+
 struct s_mc_message_actors_status_one_t { // an array of `s_mc_message_actors_status_one_t[count]` is sent right after
                                           // after a `s_mc_message_actors_status_answer_t`
   simgrid::mc::MessageType type;
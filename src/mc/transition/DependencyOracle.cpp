@@ -0,0 +1,56 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/mc/transition/DependencyOracle.hpp"
+#include "src/mc/mc_config.hpp"
+#include "xbt/log.h"
+
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(mc_dependency, mc, "Memoization of the dependencies between transitions");
+
+namespace simgrid::mc {
+
+static simgrid::config::Flag<bool> cfg_dependency_cache{
+    "model-check/dependency-cache", "Whether to memoize the dependencies between the transitions", true};
+
+namespace {
+std::mutex signatures_mutex;
+std::unordered_map<std::string, unsigned> signatures;
+} // namespace
+
+unsigned DependencyOracle::compute_signature_id(const Transition* t)
+{
+  unsigned id = std::numeric_limits<unsigned>::max(); // Not cached
+  if (std::string signature; cfg_dependency_cache) {
+    Transition::append_to_signature(signature, t->type_, t->aid_, t->times_considered_);
+    if (t->append_signature(signature)) {
+      const std::scoped_lock lock(signatures_mutex);
+      if (signatures.size() + 1 < (1U << id_bits))
+        id = signatures.try_emplace(std::move(signature), signatures.size() + 1).first->second;
+    }
+  }
+  t->signature_id_.store(id, std::memory_order_relaxed);
+  return id;
+}
+
+void DependencyOracle::log_state()
+{
+  if (not cfg_dependency_cache)
+    return;
+  const unsigned long hits    = hits_.load();
+  const unsigned long queries = hits + misses_.load();
+  size_t signature_count;
+  {
+    const std::scoped_lock lock(signatures_mutex);
+    signature_count = signatures.size();
+  }
+  XBT_INFO("Dependency cache: %lu hits out of %lu queries (%.1f%%) over %zu transition signatures", hits, queries,
+           queries == 0 ? 0.0 : 100.0 * hits / queries, signature_count);
+}
+
+} // namespace simgrid::mc
@@ -0,0 +1,118 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SIMGRID_MC_DEPENDENCY_ORACLE_HPP
+#define SIMGRID_MC_DEPENDENCY_ORACLE_HPP
+
+#include "src/mc/transition/Transition.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace simgrid::mc {
+
+/** Memoization of the dependency relation between transitions, that the reductions query over and over.
+ *
+ * Each transition is summarized by a signature (its type, its actor, its times_considered and the fields given by
+ * Transition::append_signature()), and all transitions of the same signature share a compact identifier. The answers of
+ * Transition::depends() and Transition::reversible_race() are then cached per pair of identifiers in a direct-mapped
+ * table, where each slot packs both identifiers and the known answers in one word so that the threads of the parallel
+ * explorer can share it without locking. The transitions that cannot be summarized are never cached.
+ *
+ * Use model-check/dependency-cache:no to query the transitions directly.
+ */
+class DependencyOracle {
+  static constexpr unsigned id_bits    = 28;
+  static constexpr unsigned memo_bits  = 15;
+  static constexpr uint64_t answer_bits = 4;
+
+  static constexpr uint64_t depends_known = 1;
+  static constexpr uint64_t depends_value = 2;
+  static constexpr uint64_t race_known    = 4;
+  static constexpr uint64_t race_value    = 8;
+
+  /* Slot = (id1 << 32 | id2) << answer_bits | answers. The empty slots are zero, and no identifier is zero. */
+  static inline std::array<std::atomic<uint64_t>, 1U << memo_bits> memo_{};
+  /* The statistics are not updated atomically: this is cheaper, and a few lost counts in parallel explorations are fine */
+  static inline std::atomic<unsigned long> hits_{0};
+  static inline std::atomic<unsigned long> misses_{0};
+  static void count(std::atomic<unsigned long>& counter)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  static unsigned compute_signature_id(const Transition* t);
+  static unsigned get_signature_id(const Transition* t)
+  {
+    const unsigned id = t->signature_id_.load(std::memory_order_relaxed);
+    return id != 0 ? id : compute_signature_id(t);
+  }
+  static bool is_cached(unsigned id) { return id < (1U << id_bits); }
+
+  static std::atomic<uint64_t>& get_slot(uint64_t key)
+  {
+    return memo_[(key * 0x9E3779B97F4A7C15ULL) >> (64 - memo_bits)];
+  }
+  template <class Query>
+  static bool ask(unsigned id1, unsigned id2, uint64_t known, uint64_t value, Query&& query)
+  {
+    if (not is_cached(id1) || not is_cached(id2))
+      return query();
+
+    const uint64_t key = (static_cast<uint64_t>(id1) << 32 | id2) << answer_bits;
+    auto& slot         = get_slot(key);
+    uint64_t content   = slot.load(std::memory_order_relaxed);
+    if ((content & ~(depends_known | depends_value | race_known | race_value)) == key) {
+      if (content & known) {
+        count(hits_);
+        return content & value;
+      }
+    } else {
+      content = key;
+    }
+    count(misses_);
+    const bool res = query();
+    slot.store(content | known | (res ? value : 0), std::memory_order_relaxed);
+    return res;
+  }
+
+  static bool depends(unsigned id1, const Transition* t1, unsigned id2, const Transition* t2)
+  {
+    return ask(id1, id2, depends_known, depends_value, [t1, t2] { return t1->depends(t2); });
+  }
+
+public:
+  /** Returns `t1->depends(t2)` */
+  static bool depends(const Transition* t1, const Transition* t2)
+  {
+    return depends(get_signature_id(t1), t1, get_signature_id(t2), t2);
+  }
+  /** Returns `t1->reversible_race(t2)` */
+  static bool reversible_race(const Transition* t1, const Transition* t2)
+  {
+    return ask(get_signature_id(t1), get_signature_id(t2), race_known, race_value,
+               [t1, t2] { return t1->reversible_race(t2); });
+  }
+
+  /** Returns the first transition `t'` of [first, last) such that `t'->depends(t)`, or last if there is none.
+   *
+   * The signature of `t` is only looked up once for the whole range. */
+  template <class It> static It find_dependent(It first, It last, const Transition* t)
+  {
+    const unsigned id = get_signature_id(t);
+    return std::find_if(first, last, [id, t](const auto& other) {
+      const Transition* t_other = &*other;
+      return depends(get_signature_id(t_other), t_other, id, t);
+    });
+  }
+
+  static void log_state();
+};
+
+} // namespace simgrid::mc
+
+#endif
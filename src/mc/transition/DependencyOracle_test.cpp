@@ -0,0 +1,107 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "src/3rd-party/catch.hpp"
+#include "src/mc/remote/Channel.hpp"
+#include "src/mc/transition/DependencyOracle.hpp"
+#include "src/mc/transition/TransitionComm.hpp"
+#include "src/mc/transition/TransitionSynchro.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+using namespace simgrid::mc;
+
+/* The synchronization transitions can only be built from what the application sends, so fake that message.
+ * The channels are too large for the stack, so share a pair of them. */
+template <class T, class... Fields>
+static std::shared_ptr<Transition> receive_transition(aid_t issuer, Transition::Type type, Fields... fields)
+{
+  static auto message = std::make_unique<Channel>();
+  static auto channel = std::make_unique<Channel>();
+  (message->pack(fields), ...);
+  channel->reinject(message->get_packed_data(), message->get_packed_size());
+  message->discard_packed(0);
+  return std::make_shared<T>(issuer, 0, type, *channel);
+}
+
+/* Many transitions, so that the pairs of signatures outnumber the slots of the memoization table and collide */
+static std::vector<std::shared_ptr<Transition>> build_transitions()
+{
+  std::vector<std::shared_ptr<Transition>> transitions;
+  for (aid_t aid = 1; aid <= 3; aid++) {
+    for (unsigned comm = 1; comm <= 4; comm++) {
+      for (unsigned mbox = 0; mbox <= 2; mbox++)
+        for (int tag = 0; tag <= 1; tag++) {
+          transitions.push_back(std::make_shared<CommSendTransition>(aid, 0, comm, mbox, tag));
+          transitions.push_back(std::make_shared<CommRecvTransition>(aid, 0, comm, mbox, tag));
+        }
+      for (aid_t sender = 1; sender <= 2; sender++)
+        for (aid_t receiver = 2; receiver <= 3; receiver++)
+          for (unsigned mbox = 0; mbox <= 1; mbox++) {
+            transitions.push_back(std::make_shared<CommWaitTransition>(aid, 0, false, comm, sender, receiver, mbox));
+            transitions.push_back(std::make_shared<CommTestTransition>(aid, 0, comm, sender, receiver, mbox));
+          }
+    }
+    for (auto type : {Transition::Type::MUTEX_ASYNC_LOCK, Transition::Type::MUTEX_TEST, Transition::Type::MUTEX_TRYLOCK,
+                      Transition::Type::MUTEX_UNLOCK, Transition::Type::MUTEX_WAIT})
+      for (unsigned mutex = 1; mutex <= 2; mutex++)
+        for (aid_t owner = -1; owner <= 2; owner++)
+          transitions.push_back(receive_transition<MutexTransition>(aid, type, mutex, owner));
+    for (auto type : {Transition::Type::SEM_ASYNC_LOCK, Transition::Type::SEM_UNLOCK, Transition::Type::SEM_WAIT})
+      for (unsigned sem = 1; sem <= 2; sem++)
+        for (bool granted : {false, true})
+          for (unsigned capacity = 0; capacity <= 1; capacity++)
+            transitions.push_back(receive_transition<SemaphoreTransition>(aid, type, sem, granted, capacity));
+  }
+  return transitions;
+}
+
+TEST_CASE("simgrid::mc::DependencyOracle: Memoized answers")
+{
+  const auto transitions = build_transitions();
+  REQUIRE(transitions.size() * transitions.size() > 4 * (1U << 15));
+
+  SECTION("The dependencies are the ones of the transitions")
+  {
+    // The second round gets its answers from the table, or computes them again when another pair took their slot
+    for (int round = 0; round < 2; round++)
+      for (auto const& t1 : transitions)
+        for (auto const& t2 : transitions)
+          REQUIRE(DependencyOracle::depends(t1.get(), t2.get()) == t1->depends(t2.get()));
+  }
+
+  SECTION("The reversible races are the ones of the transitions")
+  {
+    for (int round = 0; round < 2; round++)
+      for (auto const& t1 : transitions)
+        for (auto const& t2 : transitions)
+          if (t1->aid_ != t2->aid_ && t1->depends(t2.get())) {
+            REQUIRE(DependencyOracle::reversible_race(t2.get(), t1.get()) == t2->reversible_race(t1.get()));
+            // Both answers share the slot of the pair
+            REQUIRE(DependencyOracle::depends(t2.get(), t1.get()) == t2->depends(t1.get()));
+          }
+  }
+
+  SECTION("Equivalent transitions get the same answers")
+  {
+    auto send  = std::make_shared<CommSendTransition>(1, 0, 3, 1, 0);
+    auto again = std::make_shared<CommSendTransition>(1, 0, 3, 1, 0);
+    for (auto const& t : transitions) {
+      REQUIRE(DependencyOracle::depends(send.get(), t.get()) == send->depends(t.get()));
+      REQUIRE(DependencyOracle::depends(again.get(), t.get()) == send->depends(t.get()));
+    }
+  }
+
+  SECTION("Finding the first dependent transition")
+  {
+    for (auto const& t : transitions) {
+      auto expected = std::find_if(transitions.begin(), transitions.end(),
+                                   [&t](auto const& other) { return other->depends(t.get()); });
+      REQUIRE(DependencyOracle::find_dependent(transitions.begin(), transitions.end(), t.get()) == expected);
+    }
+  }
+}
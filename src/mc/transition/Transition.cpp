@@ -23,8 +23,8 @@
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(mc_transition, mc, "Logging specific to MC transitions");
 
 namespace simgrid::mc {
-unsigned long Transition::executed_transitions_ = 0;
-unsigned long Transition::replayed_transitions_ = 0;
+std::atomic<unsigned long> Transition::executed_transitions_ = 0;
+std::atomic<unsigned long> Transition::replayed_transitions_ = 0;
 
 // Do not move this to the header, to ensure that we have a vtable for Transition
 Transition::~Transition() = default;
@@ -10,11 +10,15 @@
 #include "xbt/ex.h"
 #include "xbt/utility.hpp"   // XBT_DECLARE_ENUM_CLASS
 
+#include <atomic>
 #include <sstream>
 #include <string>
+#include <type_traits>
 
 namespace simgrid::mc {
 
+class DependencyOracle;
+
 /** An element in the recorded path
  *
  *  At each decision point, we need to record which process transition
@@ -25,12 +29,23 @@ namespace simgrid::mc {
  */
 class Transition {
   /* Global statistics */
-  static unsigned long executed_transitions_;
+  static std::atomic<unsigned long> executed_transitions_;
 
   friend State; // FIXME remove this once we have a proper class to handle the statistics
 
+  /* Identifier of the signature of this transition in the DependencyOracle (0 if not computed yet) */
+  mutable std::atomic<unsigned> signature_id_ = 0;
+  friend DependencyOracle;
+
+protected:
+  template <class... T> static void append_to_signature(std::string& signature, const T&... values)
+  {
+    static_assert((std::is_scalar_v<T> && ...), "Only scalar values can be appended to a signature");
+    (signature.append(reinterpret_cast<const char*>(&values), sizeof(values)), ...);
+  }
+
 public:
-  static unsigned long replayed_transitions_;
+  static std::atomic<unsigned long> replayed_transitions_;
 
   /* Ordering is important here. depends() implementations only consider subsequent types in this ordering */
   XBT_DECLARE_ENUM_CLASS(
@@ -91,6 +106,11 @@ public:
 
   virtual bool depends(const Transition* other) const { return true; }
 
+  /** Appends to the signature everything that depends() and reversible_race() read in this transition, beyond its
+   *  type, actor and times_considered. The answers of these methods are memoized by the DependencyOracle for the
+   *  transitions of the same signature. Transitions returning false are never memoized. */
+  virtual bool append_signature(std::string& signature) const { return false; }
+
   /* Transitions can be co-enabled if there can exist a state in which one actor wants to do one of them
      and an other actor wants to do the other one */
   virtual bool can_be_co_enabled(const Transition* other) const
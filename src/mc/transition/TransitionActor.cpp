@@ -65,6 +65,12 @@ bool ActorJoinTransition::can_be_co_enabled(const Transition* other) const
   return true;
 }
 
+bool ActorJoinTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, timeout_, target_);
+  return true;
+}
+
   bool ActorJoinTransition::reversible_race(const Transition* other) const
   {
   xbt_assert(type_ == Type::ACTOR_JOIN, "Unexpected transition type %s", to_c_str(type_));
@@ -93,6 +99,11 @@ bool ActorSleepTransition::depends(const Transition* other) const
   return false;
 }
 
+bool ActorSleepTransition::append_signature(std::string&) const
+{
+  return true;
+}
+
 bool ActorSleepTransition::reversible_race(const Transition* other) const
 {
   xbt_assert(other->type_ == Type::ACTOR_CREATE, "Unexpected transition type %s", to_c_str(type_));
@@ -145,6 +156,12 @@ bool ActorCreateTransition::can_be_co_enabled(const Transition* other) const
   return true;
 }
 
+bool ActorCreateTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, child_);
+  return true;
+}
+
 bool ActorCreateTransition::reversible_race(const Transition* other) const
 {
   // FIXME: Please review this code, MLaurent :)
@@ -23,6 +23,7 @@ public:
   ActorJoinTransition(aid_t issuer, int times_considered, mc::Channel& channel);
   std::string to_string(bool verbose) const override;
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool can_be_co_enabled(const Transition* other) const override;
   bool reversible_race(const Transition* other) const override;
 
@@ -37,6 +38,7 @@ public:
   ActorSleepTransition(aid_t issuer, int times_considered, mc::Channel& channel);
   std::string to_string(bool verbose) const override;
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool reversible_race(const Transition* other) const override;
 };
 
@@ -47,6 +49,7 @@ public:
   ActorCreateTransition(aid_t issuer, int times_considered, mc::Channel& channel);
   std::string to_string(bool verbose) const override;
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool can_be_co_enabled(const Transition* other) const override;
   bool reversible_race(const Transition* other) const override;
 
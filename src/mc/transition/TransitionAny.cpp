@@ -45,6 +45,17 @@ bool TestAnyTransition::depends(const Transition* other) const
       return true;
   return false;
 }
+bool TestAnyTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, transitions_.size());
+  for (auto const* t : transitions_) {
+    append_to_signature(signature, t->type_, t->aid_, t->times_considered_);
+    if (not t->append_signature(signature))
+      return false;
+  }
+  return true;
+}
+
 bool TestAnyTransition::reversible_race(const Transition* other) const
 {
   xbt_assert(type_ == Type::TESTANY, "Unexpected transition type %s", to_c_str(type_));
@@ -81,6 +92,17 @@ bool WaitAnyTransition::depends(const Transition* other) const
       return true;
   return false;
 }
+bool WaitAnyTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, transitions_.size());
+  for (auto const* t : transitions_) {
+    append_to_signature(signature, t->type_, t->aid_, t->times_considered_);
+    if (not t->append_signature(signature))
+      return false;
+  }
+  return true;
+}
+
 bool WaitAnyTransition::reversible_race(const Transition* other) const
 {
   xbt_assert(type_ == Type::WAITANY, "Unexpected transition type %s", to_c_str(type_));
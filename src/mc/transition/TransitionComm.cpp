@@ -70,6 +70,12 @@ bool CommWaitTransition::depends(const Transition* other) const
   return false; // Comm transitions are INDEP with non-comm transitions
 }
 
+bool CommWaitTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, timeout_, comm_, mbox_, sender_, receiver_);
+  return true;
+}
+
 bool CommWaitTransition::reversible_race(const Transition* other) const
 {
   xbt_assert(type_ == Type::COMM_WAIT, "Unexpected transition type %s", to_c_str(type_));
@@ -128,6 +134,12 @@ bool CommTestTransition::depends(const Transition* other) const
   return false; // Comm transitions are INDEP with non-comm transitions
 }
 
+bool CommTestTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, comm_, mbox_, sender_, receiver_);
+  return true;
+}
+
 bool CommTestTransition::reversible_race(const Transition* other) const
 {
   xbt_assert(type_ == Type::COMM_TEST, "Unexpected transition type %s", to_c_str(type_));
@@ -213,6 +225,12 @@ bool CommRecvTransition::depends(const Transition* other) const
   return false; // Comm transitions are INDEP with non-comm transitions
 }
 
+bool CommRecvTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, comm_, mbox_, tag_);
+  return true;
+}
+
 bool CommRecvTransition::reversible_race(const Transition* other) const
 {
   xbt_assert(type_ == Type::COMM_ASYNC_RECV, "Unexpected transition type %s", to_c_str(type_));
@@ -300,6 +318,12 @@ bool CommSendTransition::depends(const Transition* other) const
   return false; // Comm transitions are INDEP with non-comm transitions
 }
 
+bool CommSendTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, comm_, mbox_, tag_);
+  return true;
+}
+
 bool CommSendTransition::reversible_race(const Transition* other) const
 {
   xbt_assert(type_ == Type::COMM_ASYNC_SEND, "Unexpected transition type %s", to_c_str(type_));
@@ -343,6 +367,12 @@ bool CommIprobeTransition::depends(const Transition* other) const
   // Iprobe can't enable a wait and is independent with every non Recv nor Send transition
   return false;
 }
+bool CommIprobeTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, is_sender_, mbox_, tag_);
+  return true;
+}
+
 bool CommIprobeTransition::reversible_race(const Transition* other) const
 {
   // In every cases, we can execute Iprobe before someone else
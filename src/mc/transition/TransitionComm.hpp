@@ -35,6 +35,7 @@ public:
   CommWaitTransition(aid_t issuer, int times_considered, mc::Channel& channel);
   std::string to_string(bool verbose) const override;
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool reversible_race(const Transition* other) const override;
 
   bool get_timeout() const { return timeout_; }
@@ -61,6 +62,7 @@ public:
   CommTestTransition(aid_t issuer, int times_considered, mc::Channel& channel);
   std::string to_string(bool verbose) const override;
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool reversible_race(const Transition* other) const override;
 
   /** ID of the corresponding Communication object in the application, or 0 if unknown */
@@ -83,6 +85,7 @@ public:
   CommRecvTransition(aid_t issuer, int times_considered, mc::Channel& channel);
   std::string to_string(bool verbose) const override;
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool reversible_race(const Transition* other) const override;
 
   /** ID of the corresponding Communication object in the application (or 0 if unknown)*/
@@ -103,6 +106,7 @@ public:
   CommSendTransition(aid_t issuer, int times_considered, mc::Channel& channel);
   std::string to_string(bool verbose) const override;
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool reversible_race(const Transition* other) const override;
 
   /** ID of the corresponding Communication object in the application, or 0 if unknown */
@@ -123,6 +127,7 @@ public:
   CommIprobeTransition(aid_t issuer, int times_considered, mc::Channel& channel);
   std::string to_string(bool verbose) const override;
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool reversible_race(const Transition* other) const override;
   bool can_be_co_enabled(const Transition* o) const override;
 
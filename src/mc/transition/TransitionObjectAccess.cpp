@@ -48,6 +48,12 @@ bool ObjectAccessTransition::depends(const Transition* o) const
   return false;
 }
 
+bool ObjectAccessTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, access_type_, objaddr_);
+  return true;
+}
+
 bool ObjectAccessTransition::reversible_race(const Transition* other) const
 {
   xbt_assert(type_ == Type::OBJECT_ACCESS, "Unexpected transition type %s", to_c_str(type_));
@@ -22,6 +22,7 @@ public:
   ObjectAccessTransition(aid_t issuer, int times_considered, mc::Channel& channel);
   std::string to_string(bool verbose) const override;
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool reversible_race(const Transition* other) const override;
 };
 
@@ -24,6 +24,7 @@ public:
 
     return aid_ == other->aid_;
   } // Independent with any other transition
+  bool append_signature(std::string&) const override { return true; }
   bool reversible_race(const Transition* other) const override;
 };
 
@@ -54,6 +54,12 @@ bool BarrierTransition::depends(const Transition* o) const
 
   return false; // barriers are INDEP with non-barrier transitions
 }
+bool BarrierTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, bar_);
+  return true;
+}
+
 bool BarrierTransition::reversible_race(const Transition* other) const
 {
   if (other->type_ == Type::ACTOR_CREATE) {
@@ -181,6 +187,12 @@ bool MutexTransition::can_be_co_enabled(const Transition* o) const
   return true; // mutexes are INDEP with non-mutex transitions
 }
 
+bool SemaphoreTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, sem_, granted_, capacity_);
+  return true;
+}
+
 bool SemaphoreTransition::reversible_race(const Transition* other) const
 {
   if (other->type_ == Type::ACTOR_CREATE) {
@@ -261,6 +273,12 @@ bool SemaphoreTransition::depends(const Transition* o) const
   return false; // semaphores are INDEP with non-semaphore transitions
 }
 
+bool MutexTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, mutex_, owner_);
+  return true;
+}
+
 bool MutexTransition::reversible_race(const Transition* other) const
 {
   if (other->type_ == Type::ACTOR_CREATE) {
@@ -339,6 +357,12 @@ bool CondvarTransition::depends(const Transition* o) const
   // Independent with transitions that are neither Condvar nor Mutex related
   return false;
 }
+bool CondvarTransition::append_signature(std::string& signature) const
+{
+  append_to_signature(signature, condvar_, mutex_, granted_, timeout_);
+  return true;
+}
+
 bool CondvarTransition::reversible_race(const Transition* other) const
 {
   if (other->type_ == Type::ACTOR_CREATE) {
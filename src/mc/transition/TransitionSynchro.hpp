@@ -20,6 +20,7 @@ public:
   std::string to_string(bool verbose) const override;
   BarrierTransition(aid_t issuer, int times_considered, Type type, mc::Channel& channel);
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool reversible_race(const Transition* other) const override;
 };
 
@@ -31,6 +32,7 @@ public:
   std::string to_string(bool verbose) const override;
   MutexTransition(aid_t issuer, int times_considered, Type type, mc::Channel& channel);
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool can_be_co_enabled(const Transition* other) const override;
   bool reversible_race(const Transition* other) const override;
 
@@ -47,6 +49,7 @@ public:
   std::string to_string(bool verbose) const override;
   SemaphoreTransition(aid_t issuer, int times_considered, Type type, mc::Channel& channel);
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool reversible_race(const Transition* other) const override;
 
   int get_capacity() const { return capacity_; }
@@ -55,14 +58,15 @@ public:
 
 class CondvarTransition : public Transition {
   unsigned int condvar_;
-  unsigned int mutex_;
-  bool granted_;
-  bool timeout_;
+  unsigned int mutex_ = 0; // Not set by signals and broadcasts
+  bool granted_       = false;
+  bool timeout_       = false;
 
 public:
   std::string to_string(bool verbose) const override;
   CondvarTransition(aid_t issuer, int times_considered, Type type, mc::Channel& channel);
   bool depends(const Transition* other) const override;
+  bool append_signature(std::string& signature) const override;
   bool can_be_co_enabled(const Transition* other) const override;
   bool reversible_race(const Transition* other) const override;
 
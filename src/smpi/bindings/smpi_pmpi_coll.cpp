@@ -1016,3 +1016,214 @@ int PMPI_Ialltoallw(const void* sendbuf, const int* sendcounts, const int* sendd
   TRACE_smpi_comm_out(pid);
   return retval;
 }
+
+/* Persistent collectives: the requests are built here, and started by each MPI_Start */
+
+int PMPI_Barrier_init(MPI_Comm comm, MPI_Info, MPI_Request* request)
+{
+  CHECK_COMM(1)
+  CHECK_REQUEST(3)
+  CHECK_COLLECTIVE(comm, __func__)
+
+  const SmpiBenchGuard suspend_bench;
+  simgrid::smpi::colls::ibarrier(comm, request, 1, true);
+  return MPI_SUCCESS;
+}
+
+int PMPI_Bcast_init(void* buf, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Info,
+                    MPI_Request* request)
+{
+  SET_BUF1(buf)
+  CHECK_COMM(5)
+  CHECK_COUNT(2, count)
+  CHECK_TYPE(3, datatype)
+  CHECK_BUFFER(1, buf, count, datatype)
+  CHECK_ROOT(4)
+  CHECK_REQUEST(7)
+  CHECK_COLLECTIVE(comm, std::string(__func__) + " with root " + std::to_string(root))
+
+  const SmpiBenchGuard suspend_bench;
+  simgrid::smpi::colls::ibcast(buf, count, datatype, root, comm, request, 1, true);
+  return MPI_SUCCESS;
+}
+
+int PMPI_Gather_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                     MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Info, MPI_Request* request)
+{
+  CHECK_COMM(8)
+  SET_BUF1(sendbuf)
+  int rank = comm->rank();
+  if(sendbuf != MPI_IN_PLACE){
+    CHECK_COUNT(2, sendcount)
+    CHECK_TYPE(3, sendtype)
+    CHECK_BUFFER(1,sendbuf, sendcount, sendtype)
+  }
+  if(rank == root){
+    SET_BUF2(recvbuf)
+    CHECK_NOT_IN_PLACE_ROOT(4, recvbuf)
+    CHECK_TYPE(6, recvtype)
+    CHECK_COUNT(5, recvcount)
+    CHECK_BUFFER(4, recvbuf, recvcount, recvtype)
+  } else {
+    CHECK_NOT_IN_PLACE_ROOT(1, sendbuf)
+  }
+  CHECK_ROOT(7)
+  CHECK_REQUEST(10)
+  CHECK_COLLECTIVE(comm, std::string(__func__) + " with root " + std::to_string(root))
+
+  if (rank == root && sendbuf != MPI_IN_PLACE && recvtype->size() * recvcount != sendtype->size() * sendcount) {
+    XBT_WARN("MPI_Gather_init : received size at root differs from sent size : %zu vs %zu",
+             recvtype->size() * recvcount, sendtype->size() * sendcount);
+    return MPI_ERR_TRUNCATE;
+  }
+
+  const SmpiBenchGuard suspend_bench;
+  simgrid::smpi::colls::igather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm, request, 1,
+                                true);
+  return MPI_SUCCESS;
+}
+
+int PMPI_Scatter_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                      MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Info, MPI_Request* request)
+{
+  CHECK_COMM(8)
+  SET_BUF2(recvbuf)
+  int rank = comm->rank();
+  if(rank == root){
+    SET_BUF1(sendbuf)
+    CHECK_NOT_IN_PLACE_ROOT(1, sendbuf)
+    CHECK_COUNT(2, sendcount)
+    CHECK_TYPE(3, sendtype)
+    CHECK_BUFFER(1, sendbuf, sendcount, sendtype)
+  } else {
+    CHECK_NOT_IN_PLACE_ROOT(4, recvbuf)
+  }
+  if(recvbuf != MPI_IN_PLACE){
+    CHECK_COUNT(5, recvcount)
+    CHECK_TYPE(6, recvtype)
+    CHECK_BUFFER(4, recvbuf, recvcount, recvtype)
+  }
+  CHECK_ROOT(8)
+  CHECK_REQUEST(10)
+  CHECK_COLLECTIVE(comm, std::string(__func__) + " with root " + std::to_string(root))
+
+  if (rank == root && recvbuf != MPI_IN_PLACE && recvtype->size() * recvcount != sendtype->size() * sendcount) {
+    XBT_WARN("MPI_Scatter_init : sent size to each process differs from receive size");
+    return MPI_ERR_TRUNCATE;
+  }
+
+  const SmpiBenchGuard suspend_bench;
+  simgrid::smpi::colls::iscatter(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, root, comm, request, 1,
+                                 true);
+  return MPI_SUCCESS;
+}
+
+int PMPI_Allgather_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                        MPI_Datatype recvtype, MPI_Comm comm, MPI_Info, MPI_Request* request)
+{
+  CHECK_COMM(7)
+  SET_BUF1(sendbuf)
+  SET_BUF2(recvbuf)
+  int rank = comm->rank();
+  CHECK_NOT_IN_PLACE(4, recvbuf)
+  if(sendbuf != MPI_IN_PLACE){
+    CHECK_COUNT(2, sendcount)
+    CHECK_TYPE(3, sendtype)
+  }
+  CHECK_TYPE(6, recvtype)
+  CHECK_COUNT(5, recvcount)
+  CHECK_BUFFER(1, sendbuf, sendcount, sendtype)
+  CHECK_BUFFER(4, recvbuf, recvcount, recvtype)
+  CHECK_REQUEST(9)
+  CHECK_COLLECTIVE(comm, __func__)
+
+  if (sendbuf == MPI_IN_PLACE) {
+    sendbuf   = static_cast<char*>(recvbuf) + recvtype->get_extent() * recvcount * rank;
+    sendcount = recvcount;
+    sendtype  = recvtype;
+  }
+
+  if(recvtype->size() * recvcount !=  sendtype->size() * sendcount){
+    XBT_WARN("MPI_Allgather_init : received size from each process differs from sent size : %zu vs %zu",
+             recvtype->size() * recvcount, sendtype->size() * sendcount);
+    return MPI_ERR_TRUNCATE;
+  }
+
+  const SmpiBenchGuard suspend_bench;
+  simgrid::smpi::colls::iallgather(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm, request, 1, true);
+  return MPI_SUCCESS;
+}
+
+int PMPI_Alltoall_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
+                       MPI_Datatype recvtype, MPI_Comm comm, MPI_Info, MPI_Request* request)
+{
+  CHECK_COMM(7)
+  SET_BUF1(sendbuf)
+  SET_BUF2(recvbuf)
+  if(sendbuf != MPI_IN_PLACE){
+    CHECK_TYPE(3, sendtype)
+    CHECK_COUNT(2, sendcount)
+    CHECK_BUFFER(1, sendbuf, sendcount, sendtype)
+  }
+  CHECK_TYPE(6, recvtype)
+  CHECK_COUNT(5, recvcount)
+  CHECK_BUFFER(4, recvbuf, recvcount, recvtype)
+  CHECK_REQUEST(9)
+  CHECK_COLLECTIVE(comm, __func__)
+
+  if (sendbuf != MPI_IN_PLACE && recvtype->size() * recvcount != sendtype->size() * sendcount) {
+    XBT_WARN("MPI_Alltoall_init : receive size from each process differs from sent size : %zu vs %zu",
+             recvtype->size() * recvcount, sendtype->size() * sendcount);
+    return MPI_ERR_TRUNCATE;
+  }
+
+  const SmpiBenchGuard suspend_bench;
+  // MPI_IN_PLACE is given to the collective, which copies the data to send at each start
+  return simgrid::smpi::colls::ialltoall(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype, comm, request, 1,
+                                         true);
+}
+
+int PMPI_Reduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+                     MPI_Comm comm, MPI_Info, MPI_Request* request)
+{
+  CHECK_COMM(7)
+  SET_BUF1(sendbuf)
+  int rank = comm->rank();
+  CHECK_TYPE(4, datatype)
+  CHECK_COUNT(3, count)
+  CHECK_BUFFER(1, sendbuf, count, datatype)
+  if(rank == root){
+    SET_BUF2(recvbuf)
+    CHECK_NOT_IN_PLACE(2, recvbuf)
+    CHECK_BUFFER(5, recvbuf, count, datatype)
+  }
+  CHECK_OP(5, op, datatype)
+  CHECK_ROOT(7)
+  CHECK_REQUEST(9)
+  CHECK_COLLECTIVE(comm, std::string(__func__) + " with op " + op->name() + " and root " + std::to_string(root))
+
+  const SmpiBenchGuard suspend_bench;
+  return simgrid::smpi::colls::ireduce(sendbuf, recvbuf, count, datatype, op, root, comm, request, 1, true);
+}
+
+int PMPI_Allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
+                        MPI_Comm comm, MPI_Info, MPI_Request* request)
+{
+  CHECK_COMM(6)
+  SET_BUF1(sendbuf)
+  SET_BUF2(recvbuf)
+  int rank = comm->rank();
+  CHECK_NOT_IN_PLACE(2, recvbuf)
+  CHECK_TYPE(4, datatype)
+  CHECK_OP(5, op, datatype)
+  CHECK_COUNT(3, count)
+  CHECK_BUFFER(1, sendbuf, count, datatype)
+  CHECK_BUFFER(2, recvbuf, count, datatype)
+  CHECK_REQUEST(8)
+  CHECK_COLLECTIVE(comm, std::string(__func__) + " with op " + op->name())
+
+  const SmpiBenchGuard suspend_bench;
+  // MPI_IN_PLACE is given to the collective, which sends the content of recvbuf at each start
+  simgrid::smpi::colls::iallreduce(sendbuf, recvbuf, count, datatype, op, comm, request, 1, true);
+  return MPI_SUCCESS;
+}
@@ -0,0 +1,18 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "../coll_netzone_topo.hpp"
+
+namespace simgrid::smpi {
+
+/* Hierarchical reduction to the rank 0 then hierarchical broadcast, both following the platform description */
+int allreduce__topo(const void* sbuf, void* rbuf, int rcount, MPI_Datatype dtype, MPI_Op op, MPI_Comm comm)
+{
+  if (sbuf == MPI_IN_PLACE && comm->rank() != 0)
+    sbuf = rbuf;
+  reduce__topo(sbuf, rbuf, rcount, dtype, op, 0, comm);
+  return bcast__topo(rbuf, rcount, dtype, 0, comm);
+}
+} // namespace simgrid::smpi
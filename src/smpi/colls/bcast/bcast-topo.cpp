@@ -0,0 +1,82 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "../coll_netzone_topo.hpp"
+
+#include <algorithm>
+
+namespace simgrid::smpi {
+
+constexpr size_t bcast_topo_chain_threshold = 128 * 1024; // Messages over this size are pipelined between leaders
+constexpr size_t bcast_topo_segment_size    = 32 * 1024;
+
+/* Flat tree between the ranks of a host, where the copies are cheap */
+static void bcast_topo_flat(void* buf, int count, MPI_Datatype datatype, const std::vector<int>& ranks, size_t index,
+                            MPI_Comm comm)
+{
+  if (index != 0) {
+    Request::recv(buf, count, datatype, ranks[0], COLL_TAG_BCAST, comm, MPI_STATUS_IGNORE);
+    return;
+  }
+  std::vector<MPI_Request> requests;
+  for (size_t i = 1; i < ranks.size(); i++)
+    requests.push_back(Request::isend(buf, count, datatype, ranks[i], COLL_TAG_BCAST, comm));
+  Request::waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/* Binomial tree between the leaders of the subtrees, for the small messages */
+static void bcast_topo_binomial(void* buf, int count, MPI_Datatype datatype, const std::vector<int>& ranks,
+                                size_t index, MPI_Comm comm)
+{
+  size_t mask = 1;
+  while (mask < ranks.size()) {
+    if (index & mask) {
+      Request::recv(buf, count, datatype, ranks[index - mask], COLL_TAG_BCAST, comm, MPI_STATUS_IGNORE);
+      break;
+    }
+    mask <<= 1;
+  }
+  for (mask >>= 1; mask > 0; mask >>= 1)
+    if (index + mask < ranks.size())
+      Request::send(buf, count, datatype, ranks[index + mask], COLL_TAG_BCAST, comm);
+}
+
+/* Pipelined chain between the leaders of the subtrees, for the large messages */
+static void bcast_topo_chain(void* buf, int count, MPI_Datatype datatype, const std::vector<int>& ranks, size_t index,
+                             MPI_Comm comm)
+{
+  int segment = std::max(1, static_cast<int>(bcast_topo_segment_size / datatype->size()));
+  std::vector<MPI_Request> requests;
+  for (int offset = 0; offset < count; offset += segment) {
+    void* pos  = static_cast<char*>(buf) + offset * datatype->get_extent();
+    int length = std::min(segment, count - offset);
+    if (index > 0)
+      Request::recv(pos, length, datatype, ranks[index - 1], COLL_TAG_BCAST, comm, MPI_STATUS_IGNORE);
+    if (index + 1 < ranks.size())
+      requests.push_back(Request::isend(pos, length, datatype, ranks[index + 1], COLL_TAG_BCAST, comm));
+  }
+  Request::waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+}
+
+/* Hierarchical broadcast following the platform description: from the top of the hierarchy, each level broadcasts
+ * between the leaders of its subtrees (flat tree within a host, binomial tree or pipelined chain over the network) */
+int bcast__topo(void* buf, int count, MPI_Datatype datatype, int root, MPI_Comm comm)
+{
+  if (count == 0)
+    return MPI_SUCCESS;
+  int rank     = comm->rank();
+  size_t bytes = static_cast<size_t>(count) * datatype->size();
+  for (auto const& level : TopoHierarchy::get(comm).get_levels(root, rank)) {
+    auto index = static_cast<size_t>(std::find(level.ranks.begin(), level.ranks.end(), rank) - level.ranks.begin());
+    if (level.intra_host)
+      bcast_topo_flat(buf, count, datatype, level.ranks, index, comm);
+    else if (bytes >= bcast_topo_chain_threshold && datatype->size() > 0)
+      bcast_topo_chain(buf, count, datatype, level.ranks, index, comm);
+    else
+      bcast_topo_binomial(buf, count, datatype, level.ranks, index, comm);
+  }
+  return MPI_SUCCESS;
+}
+} // namespace simgrid::smpi
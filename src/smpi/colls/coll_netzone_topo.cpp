@@ -0,0 +1,116 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "coll_netzone_topo.hpp"
+#include "simgrid/kernel/routing/ClusterZone.hpp"
+#include "simgrid/kernel/routing/NetPoint.hpp"
+#include "simgrid/kernel/routing/NetZoneImpl.hpp"
+#include "simgrid/s4u/Actor.hpp"
+#include "simgrid/s4u/Host.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace simgrid::smpi {
+
+/* Location of a host in the platform, from the root zone to the host itself. The zones and hosts are identified by
+ * their rank in their englobing zone, so that the trees do not depend on the memory layout. */
+static std::vector<unsigned long> host_location(const s4u::Host* host)
+{
+  std::vector<unsigned long> res{host->get_netpoint()->id()};
+  for (const kernel::routing::NetPoint* netpoint = host->get_netpoint(); netpoint->get_englobing_zone() != nullptr;) {
+    const kernel::routing::NetZoneImpl* zone = netpoint->get_englobing_zone();
+    if (const auto* cluster = dynamic_cast<const kernel::routing::ClusterBase*>(zone)) {
+      auto coords = cluster->get_hierarchical_coords(netpoint->id());
+      res.insert(res.end(), coords.rbegin(), coords.rend());
+    }
+    res.push_back(zone->get_netpoint()->id());
+    if (zone->get_parent() == nullptr)
+      break;
+    netpoint = zone->get_netpoint();
+  }
+  std::reverse(res.begin(), res.end());
+  return res;
+}
+
+TopoHierarchy::TopoHierarchy(MPI_Comm comm)
+{
+  int size = comm->size();
+  std::vector<std::vector<unsigned long>> keys(size);
+  for (int rank = 0; rank < size; rank++) {
+    auto actor = s4u::Actor::by_pid(comm->group()->actor(rank));
+    xbt_assert(actor != nullptr, "Rank %d of the communicator is not running anymore", rank);
+    keys[rank] = host_location(actor->get_host());
+    keys[rank].push_back(rank);
+  }
+  std::vector<int> ranks(size);
+  std::iota(ranks.begin(), ranks.end(), 0);
+  std::stable_sort(ranks.begin(), ranks.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+
+  paths_.resize(size);
+  build(keys, ranks, 0, ranks.size(), 0);
+  for (auto& path : paths_)
+    std::reverse(path.begin(), path.end());
+}
+
+/* Builds the subtree of the ranks[begin:end], which share the first depth elements of their keys */
+int TopoHierarchy::build(const std::vector<std::vector<unsigned long>>& keys, std::vector<int>& ranks, size_t begin,
+                         size_t end, size_t depth)
+{
+  int id = static_cast<int>(nodes_.size());
+  if (end - begin == 1) {
+    nodes_.push_back({ranks[begin], false, {}});
+    paths_[ranks[begin]].push_back(id);
+    return id;
+  }
+  // Skip the levels where the ranks do not split
+  while (keys[ranks[begin]][depth] == keys[ranks[end - 1]][depth])
+    depth++;
+  nodes_.push_back({*std::min_element(ranks.begin() + begin, ranks.begin() + end),
+                    depth == keys[ranks[begin]].size() - 1,
+                    {}});
+  for (size_t first = begin; first < end;) {
+    size_t last = first + 1;
+    while (last < end && keys[ranks[last]][depth] == keys[ranks[first]][depth])
+      last++;
+    int child = build(keys, ranks, first, last, depth + 1);
+    nodes_[id].children.push_back(child);
+    first = last;
+  }
+  for (size_t i = begin; i < end; i++)
+    paths_[ranks[i]].push_back(id);
+  return id;
+}
+
+const TopoHierarchy& TopoHierarchy::get(MPI_Comm comm)
+{
+  if (comm->get_topo_hierarchy() == nullptr)
+    comm->set_topo_hierarchy(std::make_shared<TopoHierarchy>(comm));
+  return *comm->get_topo_hierarchy();
+}
+
+std::vector<TopoHierarchy::Level> TopoHierarchy::get_levels(int root, int rank) const
+{
+  const std::vector<int>& path      = paths_[rank];
+  const std::vector<int>& root_path = paths_[root];
+  std::vector<Level> levels;
+  for (size_t depth = 0; depth + 1 < path.size(); depth++) {
+    auto leader = [this, &root_path, root, depth](int node) {
+      return depth + 1 < root_path.size() && root_path[depth + 1] == node ? root : nodes_[node].min_rank;
+    };
+    if (leader(path[depth + 1]) != rank)
+      continue;
+    const Node& node = nodes_[path[depth]];
+    Level level{{}, node.intra_host};
+    int level_root = depth < root_path.size() && root_path[depth] == path[depth] ? root : node.min_rank;
+    level.ranks.push_back(level_root);
+    for (int child : node.children)
+      if (int child_leader = leader(child); child_leader != level_root)
+        level.ranks.push_back(child_leader);
+    levels.push_back(std::move(level));
+  }
+  return levels;
+}
+} // namespace simgrid::smpi
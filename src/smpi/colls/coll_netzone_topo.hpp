@@ -0,0 +1,53 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SMPI_COLL_NETZONE_TOPO_HPP
+#define SMPI_COLL_NETZONE_TOPO_HPP
+
+#include "colls_private.hpp"
+
+#include <vector>
+
+namespace simgrid::smpi {
+
+/** @brief Hierarchy of the ranks of a communicator, as given by the platform description
+ *
+ * The ranks are grouped by NetZone (from the root zone of the platform to the leaf zones), then by position in the
+ * cluster zones that have an internal hierarchy (group, chassis and blade of a Dragonfly, subtrees of a Fat-Tree), and
+ * finally by host. The levels where the ranks do not split are collapsed.
+ *
+ * The hierarchical collectives run one algorithm per level of this tree, between the leaders of its subtrees. The
+ * leader of a subtree is the root of the collective if it belongs to the subtree, or its smallest rank otherwise.
+ * Every actor computes the tree by itself from the platform, without any communication.
+ */
+class TopoHierarchy {
+  struct Node {
+    int min_rank;
+    bool intra_host; // whether the children of this node are ranks of the same host
+    std::vector<int> children;
+  };
+  std::vector<Node> nodes_;            // nodes_[0] is the root of the tree
+  std::vector<std::vector<int>> paths_; // for each rank, the nodes from the root of the tree to its leaf
+
+  int build(const std::vector<std::vector<unsigned long>>& keys, std::vector<int>& ranks, size_t begin, size_t end,
+            size_t depth);
+
+public:
+  /** One step of a hierarchical collective, between the leaders of the subtrees of a node */
+  struct Level {
+    std::vector<int> ranks; // ranks[0] is the root of this level
+    bool intra_host;
+  };
+
+  explicit TopoHierarchy(MPI_Comm comm);
+  /** Returns the hierarchy of that communicator, computed on first use */
+  static const TopoHierarchy& get(MPI_Comm comm);
+
+  /** Levels in which the given rank takes part when the collective is rooted at root, from the top of the tree */
+  std::vector<Level> get_levels(int root, int rank) const;
+};
+
+} // namespace simgrid::smpi
+#endif
@@ -0,0 +1,73 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "../coll_netzone_topo.hpp"
+
+#include <algorithm>
+
+namespace simgrid::smpi {
+
+/* Hierarchical reduction following the platform description: from the bottom of the hierarchy, each level reduces the
+ * partial results of the leaders of its subtrees (flat tree within a host, binomial tree over the network).
+ * The operands are combined in the order of the hierarchy, so this is only used for commutative operations. */
+int reduce__topo(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
+                 MPI_Comm comm)
+{
+  if (op != MPI_OP_NULL && not op->is_commutative())
+    return reduce__binomial(sendbuf, recvbuf, count, datatype, op, root, comm);
+  if (count == 0)
+    return MPI_SUCCESS;
+
+  int rank = comm->rank();
+  MPI_Aint true_lb;
+  MPI_Aint true_extent;
+  datatype->extent(&true_lb, &true_extent);
+  size_t buffer_size = count * std::max(datatype->get_extent(), true_extent);
+
+  /* The partial result is built in recvbuf on the root, and in a temporary buffer on the other ranks */
+  unsigned char* tmp_result = rank == root ? nullptr : smpi_get_tmp_recvbuffer(buffer_size);
+  void* result              = rank == root ? recvbuf : tmp_result - true_lb;
+  if (rank != root || sendbuf != MPI_IN_PLACE)
+    Datatype::copy(sendbuf, count, datatype, result, count, datatype);
+  unsigned char* tmp_incoming = smpi_get_tmp_sendbuffer(buffer_size);
+  void* incoming              = tmp_incoming - true_lb;
+
+  auto levels = TopoHierarchy::get(comm).get_levels(root, rank);
+  for (auto level = levels.rbegin(); level != levels.rend(); ++level) {
+    const std::vector<int>& ranks = level->ranks;
+    auto index = static_cast<size_t>(std::find(ranks.begin(), ranks.end(), rank) - ranks.begin());
+    if (level->intra_host) {
+      if (index != 0) {
+        Request::send(result, count, datatype, ranks[0], COLL_TAG_REDUCE, comm);
+        break;
+      }
+      for (size_t i = 1; i < ranks.size(); i++) {
+        Request::recv(incoming, count, datatype, ranks[i], COLL_TAG_REDUCE, comm, MPI_STATUS_IGNORE);
+        if (op != MPI_OP_NULL)
+          op->apply(incoming, result, &count, datatype);
+      }
+    } else {
+      size_t mask = 1;
+      while (mask < ranks.size() && (index & mask) == 0) {
+        if ((index | mask) < ranks.size()) {
+          Request::recv(incoming, count, datatype, ranks[index | mask], COLL_TAG_REDUCE, comm, MPI_STATUS_IGNORE);
+          if (op != MPI_OP_NULL)
+            op->apply(incoming, result, &count, datatype);
+        }
+        mask <<= 1;
+      }
+      if (mask < ranks.size()) {
+        Request::send(result, count, datatype, ranks[index & ~mask], COLL_TAG_REDUCE, comm);
+        break;
+      }
+    }
+  }
+
+  smpi_free_tmp_buffer(tmp_incoming);
+  if (tmp_result != nullptr)
+    smpi_free_tmp_buffer(tmp_result);
+  return MPI_SUCCESS;
+}
+} // namespace simgrid::smpi
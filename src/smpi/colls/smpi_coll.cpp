@@ -97,6 +97,7 @@ std::map<std::string, std::vector<s_mpi_coll_description_t>, std::less<>> smpi_c
        {"mvapich2_two_level", "allreduce mvapich2_two_level collective", (void*)allreduce__mvapich2_two_level},
        {"impi", "allreduce impi collective", (void*)allreduce__impi},
        {"rab", "allreduce rab collective", (void*)allreduce__rab},
+       {"topo", "allreduce topo collective", (void*)allreduce__topo},
        {"automatic", "allreduce automatic collective", (void*)allreduce__automatic}}},
 
      {"reduce_scatter",
@@ -213,6 +214,7 @@ std::map<std::string, std::vector<s_mpi_coll_description_t>, std::less<>> smpi_c
        {"mvapich2_knomial_intra_node", "bcast mvapich2_knomial_intra_node collective",
         (void*)bcast__mvapich2_knomial_intra_node},
        {"impi", "bcast impi collective", (void*)bcast__impi},
+       {"topo", "bcast topo collective", (void*)bcast__topo},
        {"automatic", "bcast automatic collective", (void*)bcast__automatic}}},
 
      {"reduce",
@@ -235,6 +237,7 @@ std::map<std::string, std::vector<s_mpi_coll_description_t>, std::less<>> smpi_c
        {"mvapich2_two_level", "reduce mvapich2_two_level collective", (void*)reduce__mvapich2_two_level},
        {"impi", "reduce impi collective", (void*)reduce__impi},
        {"rab", "reduce rab collective", (void*)reduce__rab},
+       {"topo", "reduce topo collective", (void*)reduce__topo},
        {"automatic", "reduce automatic collective", (void*)reduce__automatic}}}});
 
 // Needed by the automatic selector weird implementation
@@ -76,12 +76,7 @@ int allgatherv__default(const void *sendbuf, int sendcount, MPI_Datatype sendtyp
 {
   MPI_Request request;
   colls::iallgatherv(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, comm, &request, 0);
-  auto requests = request->get_nbc_requests();
-  Request::waitall(requests.size(), requests.data(), MPI_STATUS_IGNORE);
-  for(auto& req: requests)
-    Request::unref(&req);
-  Request::unref(&request);
-  return MPI_SUCCESS;
+  return Request::wait(&request, MPI_STATUS_IGNORE);
 }
 
 int scatter__default(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
@@ -6,64 +6,73 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "colls_private.hpp"
+#include "smpi_nbc_schedule.hpp"
 #include "src/smpi/include/smpi_actor.hpp"
 
 namespace simgrid::smpi {
 
-int colls::ibarrier(MPI_Comm comm, MPI_Request* request, int external)
+/* The requests of a collective are built once per set of arguments, then restarted from the cache of schedules. The
+ * persistent collectives get their own schedule, started by each MPI_Start. */
+static void start_schedule(MPI_Request request, bool persistent, NbcSchedule::Key&& key,
+                           const std::function<void(NbcSchedule&)>& build)
+{
+  if (persistent)
+    request->prepare_nbc_schedule(NbcSchedule::create(std::move(key), build));
+  else
+    request->start_nbc_schedule(NbcSchedule::get(std::move(key), build));
+}
+
+int colls::ibarrier(MPI_Comm comm, MPI_Request* request, int external, bool persistent)
 {
   int size = comm->size();
   int rank = comm->rank();
   int system_tag=COLL_TAG_BARRIER-external;
   (*request) = new Request( nullptr, 0, MPI_BYTE,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC);
-  std::vector<MPI_Request> requests;
 
-  if (rank > 0) {
-    requests.push_back(Request::isend_init (nullptr, 0, MPI_BYTE, 0, system_tag, comm));
-    requests.push_back(Request::irecv_init(nullptr, 0, MPI_BYTE, 0, system_tag, comm));
-  }
-  else {
-    for (int i = 1; i < 2 * size - 1; i += 2) {
-      requests.push_back(Request::irecv_init(nullptr, 0, MPI_BYTE, MPI_ANY_SOURCE, system_tag, comm));
-      requests.push_back(Request::isend_init(nullptr, 0, MPI_BYTE, (i + 1) / 2, system_tag, comm));
+  start_schedule(*request, persistent, {"ibarrier", comm, system_tag, {}, {}}, [&](NbcSchedule& schedule) {
+    if (rank > 0) {
+      schedule.add(Request::isend_init(nullptr, 0, MPI_BYTE, 0, system_tag, comm));
+      schedule.add(Request::irecv_init(nullptr, 0, MPI_BYTE, 0, system_tag, comm));
+    } else {
+      for (int i = 1; i < 2 * size - 1; i += 2) {
+        schedule.add(Request::irecv_init(nullptr, 0, MPI_BYTE, MPI_ANY_SOURCE, system_tag, comm));
+        schedule.add(Request::isend_init(nullptr, 0, MPI_BYTE, (i + 1) / 2, system_tag, comm));
+      }
     }
-  }
-  (*request)->start_nbc_requests(requests);
+  });
   return MPI_SUCCESS;
 }
 
 int colls::ibcast(void* buf, int count, MPI_Datatype datatype, int root, MPI_Comm comm, MPI_Request* request,
-                  int external)
+                  int external, bool persistent)
 {
   int size = comm->size();
   int rank = comm->rank();
   int system_tag=COLL_TAG_BCAST-external;
-  std::vector<MPI_Request> requests;
   (*request) = new Request( nullptr, 0, MPI_BYTE,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC);
-  if (rank != root) {
-    requests.push_back(Request::irecv_init(buf, count, datatype, root, system_tag, comm));
-  }
-  else {
-    for (int i = 0; i < size; i++) {
-      if(i!=root){
-        requests.push_back(Request::isend_init(buf, count, datatype, i, system_tag, comm));
-      }
-    }
-  }
-  (*request)->start_nbc_requests(requests);
+  start_schedule(*request, persistent, {"ibcast", comm, system_tag, {buf, datatype}, {count, root}},
+                 [&](NbcSchedule& schedule) {
+                   if (rank != root) {
+                     schedule.add(Request::irecv_init(buf, count, datatype, root, system_tag, comm));
+                   } else {
+                     for (int i = 0; i < size; i++) {
+                       if (i != root)
+                         schedule.add(Request::isend_init(buf, count, datatype, i, system_tag, comm));
+                     }
+                   }
+                 });
   return MPI_SUCCESS;
 }
 
 int colls::iallgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
-                      MPI_Datatype recvtype, MPI_Comm comm, MPI_Request* request, int external)
+                      MPI_Datatype recvtype, MPI_Comm comm, MPI_Request* request, int external, bool persistent)
 {
 
   const int system_tag = COLL_TAG_ALLGATHER-external;
   MPI_Aint lb = 0;
   MPI_Aint recvext = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
@@ -71,52 +80,63 @@ int colls::iallgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC);
   // FIXME: check for errors
   recvtype->extent(&lb, &recvext);
-  // Local copy from self
-  Datatype::copy(sendbuf, sendcount, sendtype, static_cast<char *>(recvbuf) + rank * recvcount * recvext, recvcount,
-                     recvtype);
-  // Send/Recv buffers to/from others;
-  for (int other = 0; other < size; other++) {
-    if(other != rank) {
-      requests.push_back(Request::isend_init(sendbuf, sendcount, sendtype, other, system_tag, comm));
-      requests.push_back(Request::irecv_init(static_cast<char*>(recvbuf) + other * recvcount * recvext, recvcount,
+  start_schedule(
+      *request, persistent,
+      {"iallgather", comm, system_tag, {sendbuf, sendtype, recvbuf, recvtype}, {sendcount, recvcount}},
+      [&](NbcSchedule& schedule) {
+        // Local copy from self
+        schedule.set_prologue([=] {
+          Datatype::copy(sendbuf, sendcount, sendtype, static_cast<char*>(recvbuf) + rank * recvcount * recvext,
+                         recvcount, recvtype);
+        });
+        // Send/Recv buffers to/from others;
+        for (int other = 0; other < size; other++) {
+          if (other != rank) {
+            schedule.add(Request::isend_init(sendbuf, sendcount, sendtype, other, system_tag, comm));
+            schedule.add(Request::irecv_init(static_cast<char*>(recvbuf) + other * recvcount * recvext, recvcount,
                                              recvtype, other, system_tag, comm));
-    }
-  }
-  (*request)->start_nbc_requests(requests);
+          }
+        }
+      });
   return MPI_SUCCESS;
 }
 
 int colls::iscatter(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
-                    MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request* request, int external)
+                    MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request* request, int external,
+                    bool persistent)
 {
   const int system_tag = COLL_TAG_SCATTER-external;
   MPI_Aint lb = 0;
   MPI_Aint sendext = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
   (*request) = new Request( nullptr, 0, MPI_BYTE,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC);
-  if(rank != root) {
-    // Recv buffer from root
-    requests.push_back(Request::irecv_init(recvbuf, recvcount, recvtype, root, system_tag, comm));
-  } else {
-    sendtype->extent(&lb, &sendext);
-    // Local copy from root
-    if(recvbuf!=MPI_IN_PLACE){
-        Datatype::copy(static_cast<const char *>(sendbuf) + root * sendcount * sendext,
-                           sendcount, sendtype, recvbuf, recvcount, recvtype);
-    }
-    // Send buffers to receivers
-    for(int dst = 0; dst < size; dst++) {
-      if(dst != root) {
-        requests.push_back(Request::isend_init(static_cast<const char *>(sendbuf) + dst * sendcount * sendext, sendcount, sendtype,
-                                          dst, system_tag, comm));
-      }
-    }
-  }
-  (*request)->start_nbc_requests(requests);
+  start_schedule(
+      *request, persistent,
+      {"iscatter", comm, system_tag, {sendbuf, sendtype, recvbuf, recvtype}, {sendcount, recvcount, root}},
+      [&](NbcSchedule& schedule) {
+        if (rank != root) {
+          // Recv buffer from root
+          schedule.add(Request::irecv_init(recvbuf, recvcount, recvtype, root, system_tag, comm));
+          return;
+        }
+        sendtype->extent(&lb, &sendext);
+        // Local copy from root
+        if (recvbuf != MPI_IN_PLACE) {
+          schedule.set_prologue([=] {
+            Datatype::copy(static_cast<const char*>(sendbuf) + root * sendcount * sendext, sendcount, sendtype,
+                           recvbuf, recvcount, recvtype);
+          });
+        }
+        // Send buffers to receivers
+        for (int dst = 0; dst < size; dst++) {
+          if (dst != root)
+            schedule.add(Request::isend_init(static_cast<const char*>(sendbuf) + dst * sendcount * sendext, sendcount,
+                                             sendtype, dst, system_tag, comm));
+        }
+      });
   return MPI_SUCCESS;
 }
 
@@ -126,7 +146,6 @@ int colls::iallgatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype
   const int system_tag = COLL_TAG_ALLGATHERV-external;
   MPI_Aint lb = 0;
   MPI_Aint recvext = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
@@ -136,27 +155,30 @@ int colls::iallgatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype
   // Local copy from self
   Datatype::copy(sendbuf, sendcount, sendtype,
                      static_cast<char *>(recvbuf) + displs[rank] * recvext,recvcounts[rank], recvtype);
-  // Send buffers to others;
-  for (int other = 0; other < size; other++) {
-    if(other != rank) {
-      requests.push_back(Request::isend_init(sendbuf, sendcount, sendtype, other, system_tag, comm));
-      requests.push_back(Request::irecv_init(static_cast<char *>(recvbuf) + displs[other] * recvext, recvcounts[other],
-                         recvtype, other, system_tag, comm));
-    }
-  }
-  // Wait for completion of all comms.
-  (*request)->start_nbc_requests(requests);
+  std::vector<int> values(recvcounts, recvcounts + size);
+  values.insert(values.end(), displs, displs + size);
+  values.push_back(sendcount);
+  start_schedule(*request, false, {"iallgatherv", comm, system_tag, {sendbuf, sendtype, recvbuf, recvtype}, values},
+                 [&](NbcSchedule& schedule) {
+                   // Send buffers to others;
+                   for (int other = 0; other < size; other++) {
+                     if (other != rank) {
+                       schedule.add(Request::isend_init(sendbuf, sendcount, sendtype, other, system_tag, comm));
+                       schedule.add(Request::irecv_init(static_cast<char*>(recvbuf) + displs[other] * recvext,
+                                                        recvcounts[other], recvtype, other, system_tag, comm));
+                     }
+                   }
+                 });
   return MPI_SUCCESS;
 }
 
 int colls::ialltoall(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
-                     MPI_Datatype recvtype, MPI_Comm comm, MPI_Request* request, int external)
+                     MPI_Datatype recvtype, MPI_Comm comm, MPI_Request* request, int external, bool persistent)
 {
   int system_tag   = COLL_TAG_ALLTOALL-external;
   MPI_Aint lb      = 0;
   MPI_Aint sendext = 0;
   MPI_Aint recvext = 0;
-  std::vector<MPI_Request> requests;
 
   /* Initialize. */
   int rank = comm->rank();
@@ -165,28 +187,42 @@ int colls::ialltoall(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC);
   sendtype->extent(&lb, &sendext);
   recvtype->extent(&lb, &recvext);
-  /* simple optimization */
-  int err = Datatype::copy(static_cast<const char *>(sendbuf) + rank * sendcount * sendext, sendcount, sendtype,
-                               static_cast<char *>(recvbuf) + rank * recvcount * recvext, recvcount, recvtype);
-  if (err == MPI_SUCCESS && size > 1) {
-    /* Initiate all send/recv to/from others. */
-    /* Post all receives first -- a simple optimization */
-    for (int i = (rank + 1) % size; i != rank; i = (i + 1) % size) {
-      requests.push_back(Request::irecv_init(static_cast<char *>(recvbuf) + i * recvcount * recvext, recvcount,
-                                        recvtype, i, system_tag, comm));
-    }
-    /* Now post all sends in reverse order
-     *   - We would like to minimize the search time through message queue
-     *     when messages actually arrive in the order in which they were posted.
-     * TODO: check the previous assertion
-     */
-    for (int i = (rank + size - 1) % size; i != rank; i = (i + size - 1) % size) {
-      requests.push_back(Request::isend_init(static_cast<const char *>(sendbuf) + i * sendcount * sendext, sendcount,
-                                        sendtype, i, system_tag, comm));
-    }
-    /* Wait for them all. */
-    (*request)->start_nbc_requests(requests);
-  }
+  start_schedule(
+      *request, persistent,
+      {"ialltoall", comm, system_tag, {sendbuf, sendtype, recvbuf, recvtype}, {sendcount, recvcount}},
+      [&](NbcSchedule& schedule) {
+        if (sendbuf == MPI_IN_PLACE) { // Send a copy of the data, as they are overwritten by the receptions
+          unsigned char* tmp_sendbuf = schedule.tmp_buffer(size * recvcount * recvext);
+          schedule.set_prologue([=] {
+            Datatype::copy(recvbuf, size * recvcount, recvtype, tmp_sendbuf, size * recvcount, recvtype);
+          });
+          sendbuf   = tmp_sendbuf;
+          sendcount = recvcount;
+          sendtype  = recvtype;
+          sendext   = recvext;
+        } else {
+          /* simple optimization */
+          schedule.set_prologue([=] {
+            Datatype::copy(static_cast<const char*>(sendbuf) + rank * sendcount * sendext, sendcount, sendtype,
+                           static_cast<char*>(recvbuf) + rank * recvcount * recvext, recvcount, recvtype);
+          });
+        }
+        /* Initiate all send/recv to/from others. */
+        /* Post all receives first -- a simple optimization */
+        for (int i = (rank + 1) % size; i != rank; i = (i + 1) % size) {
+          schedule.add(Request::irecv_init(static_cast<char*>(recvbuf) + i * recvcount * recvext, recvcount, recvtype,
+                                           i, system_tag, comm));
+        }
+        /* Now post all sends in reverse order
+         *   - We would like to minimize the search time through message queue
+         *     when messages actually arrive in the order in which they were posted.
+         * TODO: check the previous assertion
+         */
+        for (int i = (rank + size - 1) % size; i != rank; i = (i + size - 1) % size) {
+          schedule.add(Request::isend_init(static_cast<const char*>(sendbuf) + i * sendcount * sendext, sendcount,
+                                           sendtype, i, system_tag, comm));
+        }
+      });
   return MPI_SUCCESS;
 }
 
@@ -198,7 +234,6 @@ int colls::ialltoallv(const void* sendbuf, const int* sendcounts, const int* sen
   MPI_Aint lb = 0;
   MPI_Aint sendext = 0;
   MPI_Aint recvext = 0;
-  std::vector<MPI_Request> requests;
 
   /* Initialize. */
   int rank = comm->rank();
@@ -211,27 +246,32 @@ int colls::ialltoallv(const void* sendbuf, const int* sendcounts, const int* sen
   int err = Datatype::copy(static_cast<const char *>(sendbuf) + senddisps[rank] * sendext, sendcounts[rank], sendtype,
                                static_cast<char *>(recvbuf) + recvdisps[rank] * recvext, recvcounts[rank], recvtype);
   if (err == MPI_SUCCESS && size > 1) {
-    /* Initiate all send/recv to/from others. */
-    /* Create all receives that will be posted first */
-    for (int i = 0; i < size; ++i) {
-      if (i != rank) {
-        requests.push_back(Request::irecv_init(static_cast<char *>(recvbuf) + recvdisps[i] * recvext,
-                                          recvcounts[i], recvtype, i, system_tag, comm));
-      }else{
-        XBT_DEBUG("<%d> skip request creation [src = %d, recvcounts[src] = %d]", rank, i, recvcounts[i]);
-      }
-    }
-    /* Now create all sends  */
-    for (int i = 0; i < size; ++i) {
-      if (i != rank) {
-      requests.push_back(Request::isend_init(static_cast<const char *>(sendbuf) + senddisps[i] * sendext,
-                                        sendcounts[i], sendtype, i, system_tag, comm));
-      }else{
-        XBT_DEBUG("<%d> skip request creation [dst = %d, sendcounts[dst] = %d]", rank, i, sendcounts[i]);
-      }
-    }
-    /* Wait for them all. */
-    (*request)->start_nbc_requests(requests);
+    std::vector<int> values(sendcounts, sendcounts + size);
+    for (const int* array : {senddisps, recvcounts, recvdisps})
+      values.insert(values.end(), array, array + size);
+    start_schedule(
+        *request, false, {"ialltoallv", comm, system_tag, {sendbuf, sendtype, recvbuf, recvtype}, values},
+        [&](NbcSchedule& schedule) {
+          /* Initiate all send/recv to/from others. */
+          /* Create all receives that will be posted first */
+          for (int i = 0; i < size; ++i) {
+            if (i != rank) {
+              schedule.add(Request::irecv_init(static_cast<char*>(recvbuf) + recvdisps[i] * recvext, recvcounts[i],
+                                               recvtype, i, system_tag, comm));
+            } else {
+              XBT_DEBUG("<%d> skip request creation [src = %d, recvcounts[src] = %d]", rank, i, recvcounts[i]);
+            }
+          }
+          /* Now create all sends  */
+          for (int i = 0; i < size; ++i) {
+            if (i != rank) {
+              schedule.add(Request::isend_init(static_cast<const char*>(sendbuf) + senddisps[i] * sendext,
+                                               sendcounts[i], sendtype, i, system_tag, comm));
+            } else {
+              XBT_DEBUG("<%d> skip request creation [dst = %d, sendcounts[dst] = %d]", rank, i, sendcounts[i]);
+            }
+          }
+        });
   }
   return err;
 }
@@ -241,7 +281,6 @@ int colls::ialltoallw(const void* sendbuf, const int* sendcounts, const int* sen
                       MPI_Comm comm, MPI_Request* request, int external)
 {
   const int system_tag = COLL_TAG_ALLTOALLW-external;
-  std::vector<MPI_Request> requests;
 
   /* Initialize. */
   int rank = comm->rank();
@@ -252,60 +291,71 @@ int colls::ialltoallw(const void* sendbuf, const int* sendcounts, const int* sen
   int err = (sendcounts[rank]>0 && recvcounts[rank]) ? Datatype::copy(static_cast<const char *>(sendbuf) + senddisps[rank], sendcounts[rank], sendtypes[rank],
                                static_cast<char *>(recvbuf) + recvdisps[rank], recvcounts[rank], recvtypes[rank]): MPI_SUCCESS;
   if (err == MPI_SUCCESS && size > 1) {
-    /* Initiate all send/recv to/from others. */
-    /* Create all receives that will be posted first */
-    for (int i = 0; i < size; ++i) {
-      if (i != rank) {
-        requests.push_back(Request::irecv_init(static_cast<char *>(recvbuf) + recvdisps[i],
-                                          recvcounts[i], recvtypes[i], i, system_tag, comm));
-      }else{
-        XBT_DEBUG("<%d> skip request creation [src = %d, recvcounts[src] = %d]", rank, i, recvcounts[i]);
+    std::vector<const void*> handles{sendbuf, recvbuf};
+    handles.insert(handles.end(), sendtypes, sendtypes + size);
+    handles.insert(handles.end(), recvtypes, recvtypes + size);
+    std::vector<int> values(sendcounts, sendcounts + size);
+    for (const int* array : {senddisps, recvcounts, recvdisps})
+      values.insert(values.end(), array, array + size);
+    start_schedule(*request, false, {"ialltoallw", comm, system_tag, handles, values}, [&](NbcSchedule& schedule) {
+      /* Initiate all send/recv to/from others. */
+      /* Create all receives that will be posted first */
+      for (int i = 0; i < size; ++i) {
+        if (i != rank) {
+          schedule.add(Request::irecv_init(static_cast<char*>(recvbuf) + recvdisps[i], recvcounts[i], recvtypes[i], i,
+                                           system_tag, comm));
+        } else {
+          XBT_DEBUG("<%d> skip request creation [src = %d, recvcounts[src] = %d]", rank, i, recvcounts[i]);
+        }
       }
-    }
-    /* Now create all sends  */
-    for (int i = 0; i < size; ++i) {
-      if (i != rank) {
-      requests.push_back(Request::isend_init(static_cast<const char *>(sendbuf) + senddisps[i] ,
-                                        sendcounts[i], sendtypes[i], i, system_tag, comm));
-      }else{
-        XBT_DEBUG("<%d> skip request creation [dst = %d, sendcounts[dst] = %d]", rank, i, sendcounts[i]);
+      /* Now create all sends  */
+      for (int i = 0; i < size; ++i) {
+        if (i != rank) {
+          schedule.add(Request::isend_init(static_cast<const char*>(sendbuf) + senddisps[i], sendcounts[i],
+                                           sendtypes[i], i, system_tag, comm));
+        } else {
+          XBT_DEBUG("<%d> skip request creation [dst = %d, sendcounts[dst] = %d]", rank, i, sendcounts[i]);
+        }
       }
-    }
-    /* Wait for them all. */
-    (*request)->start_nbc_requests(requests);
+    });
   }
   return err;
 }
 
 int colls::igather(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
-                   MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request* request, int external)
+                   MPI_Datatype recvtype, int root, MPI_Comm comm, MPI_Request* request, int external, bool persistent)
 {
   const int system_tag = COLL_TAG_GATHER-external;
   MPI_Aint lb = 0;
   MPI_Aint recvext = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
   (*request) = new Request( nullptr, 0, MPI_BYTE,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC);
-  if(rank != root) {
-    // Send buffer to root
-    requests.push_back(Request::isend_init(sendbuf, sendcount, sendtype, root, system_tag, comm));
-  } else {
-    recvtype->extent(&lb, &recvext);
-    // Local copy from root
-    Datatype::copy(sendbuf, sendcount, sendtype, static_cast<char*>(recvbuf) + root * recvcount * recvext,
-                       recvcount, recvtype);
-    // Receive buffers from senders
-    for (int src = 0; src < size; src++) {
-      if(src != root) {
-        requests.push_back(Request::irecv_init(static_cast<char*>(recvbuf) + src * recvcount * recvext, recvcount, recvtype,
-                                          src, system_tag, comm));
-      }
-    }
-  }
-  (*request)->start_nbc_requests(requests);
+  start_schedule(
+      *request, persistent,
+      {"igather", comm, system_tag, {sendbuf, sendtype, recvbuf, recvtype}, {sendcount, recvcount, root}},
+      [&](NbcSchedule& schedule) {
+        if (rank != root) {
+          // Send buffer to root
+          schedule.add(Request::isend_init(sendbuf, sendcount, sendtype, root, system_tag, comm));
+          return;
+        }
+        recvtype->extent(&lb, &recvext);
+        // Local copy from root
+        if (sendbuf != MPI_IN_PLACE)
+          schedule.set_prologue([=] {
+            Datatype::copy(sendbuf, sendcount, sendtype, static_cast<char*>(recvbuf) + root * recvcount * recvext,
+                           recvcount, recvtype);
+          });
+        // Receive buffers from senders
+        for (int src = 0; src < size; src++) {
+          if (src != root)
+            schedule.add(Request::irecv_init(static_cast<char*>(recvbuf) + src * recvcount * recvext, recvcount,
+                                             recvtype, src, system_tag, comm));
+        }
+      });
   return MPI_SUCCESS;
 }
 
@@ -316,30 +366,34 @@ int colls::igatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype, v
   int system_tag = COLL_TAG_GATHERV-external;
   MPI_Aint lb = 0;
   MPI_Aint recvext = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
   (*request) = new Request( nullptr, 0, MPI_BYTE,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC);
-  if (rank != root) {
-    // Send buffer to root
-    requests.push_back(Request::isend_init(sendbuf, sendcount, sendtype, root, system_tag, comm));
-  } else {
+  std::vector<int> values{sendcount, root};
+  if (rank == root) { // The counts and displacements are only significant at root
+    values.insert(values.end(), recvcounts, recvcounts + size);
+    values.insert(values.end(), displs, displs + size);
     recvtype->extent(&lb, &recvext);
     // Local copy from root
     Datatype::copy(sendbuf, sendcount, sendtype, static_cast<char*>(recvbuf) + displs[root] * recvext,
                        recvcounts[root], recvtype);
-    // Receive buffers from senders
-    for (int src = 0; src < size; src++) {
-      if(src != root) {
-        requests.push_back(Request::irecv_init(static_cast<char*>(recvbuf) + displs[src] * recvext,
-                          recvcounts[src], recvtype, src, system_tag, comm));
-      }
-    }
   }
-  // Wait for completion of irecv's.
-  (*request)->start_nbc_requests(requests);
+  start_schedule(*request, false, {"igatherv", comm, system_tag, {sendbuf, sendtype, recvbuf, recvtype}, values},
+                 [&](NbcSchedule& schedule) {
+                   if (rank != root) {
+                     // Send buffer to root
+                     schedule.add(Request::isend_init(sendbuf, sendcount, sendtype, root, system_tag, comm));
+                     return;
+                   }
+                   // Receive buffers from senders
+                   for (int src = 0; src < size; src++) {
+                     if (src != root)
+                       schedule.add(Request::irecv_init(static_cast<char*>(recvbuf) + displs[src] * recvext,
+                                                        recvcounts[src], recvtype, src, system_tag, comm));
+                   }
+                 });
   return MPI_SUCCESS;
 }
 int colls::iscatterv(const void* sendbuf, const int* sendcounts, const int* displs, MPI_Datatype sendtype,
@@ -349,43 +403,45 @@ int colls::iscatterv(const void* sendbuf, const int* sendcounts, const int* disp
   int system_tag = COLL_TAG_SCATTERV-external;
   MPI_Aint lb = 0;
   MPI_Aint sendext = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
   (*request) = new Request( nullptr, 0, MPI_BYTE,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC);
-  if(rank != root) {
-    // Recv buffer from root
-    requests.push_back(Request::irecv_init(recvbuf, recvcount, recvtype, root, system_tag, comm));
-  } else {
+  std::vector<int> values{recvcount, root};
+  if (rank == root) { // The counts and displacements are only significant at root
+    values.insert(values.end(), sendcounts, sendcounts + size);
+    values.insert(values.end(), displs, displs + size);
     sendtype->extent(&lb, &sendext);
     // Local copy from root
     if(recvbuf!=MPI_IN_PLACE){
       Datatype::copy(static_cast<const char *>(sendbuf) + displs[root] * sendext, sendcounts[root],
                        sendtype, recvbuf, recvcount, recvtype);
     }
-    // Send buffers to receivers
-    for (int dst = 0; dst < size; dst++) {
-      if (dst != root) {
-        requests.push_back(Request::isend_init(static_cast<const char *>(sendbuf) + displs[dst] * sendext, sendcounts[dst],
-                            sendtype, dst, system_tag, comm));
-      }
-    }
   }
-  (*request)->start_nbc_requests(requests);
+  start_schedule(*request, false, {"iscatterv", comm, system_tag, {sendbuf, sendtype, recvbuf, recvtype}, values},
+                 [&](NbcSchedule& schedule) {
+                   if (rank != root) {
+                     // Recv buffer from root
+                     schedule.add(Request::irecv_init(recvbuf, recvcount, recvtype, root, system_tag, comm));
+                     return;
+                   }
+                   // Send buffers to receivers
+                   for (int dst = 0; dst < size; dst++) {
+                     if (dst != root)
+                       schedule.add(Request::isend_init(static_cast<const char*>(sendbuf) + displs[dst] * sendext,
+                                                        sendcounts[dst], sendtype, dst, system_tag, comm));
+                   }
+                 });
   return MPI_SUCCESS;
 }
 
 int colls::ireduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, int root,
-                   MPI_Comm comm, MPI_Request* request, int external)
+                   MPI_Comm comm, MPI_Request* request, int external, bool persistent)
 {
   const int system_tag = COLL_TAG_REDUCE-external;
   MPI_Aint lb = 0;
   MPI_Aint dataext = 0;
-  std::vector<MPI_Request> requests;
-
-  const void* real_sendbuf = sendbuf;
 
   int rank = comm->rank();
   int size = comm->size();
@@ -393,13 +449,6 @@ int colls::ireduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype d
   if (size <= 0)
     return MPI_ERR_COMM;
 
-  unsigned char* tmp_sendbuf = nullptr;
-  if( sendbuf == MPI_IN_PLACE ) {
-    tmp_sendbuf = smpi_get_tmp_sendbuffer(count * datatype->get_extent());
-    Datatype::copy(recvbuf, count, datatype, tmp_sendbuf, count, datatype);
-    real_sendbuf = tmp_sendbuf;
-  }
-
   if(rank == root){
     (*request) =  new Request( recvbuf, count, datatype,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC, op);
@@ -408,36 +457,36 @@ int colls::ireduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype d
     (*request) = new Request( nullptr, count, datatype,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC);
 
-  if(rank != root) {
-    // Send buffer to root
-    requests.push_back(Request::isend_init(real_sendbuf, count, datatype, root, system_tag, comm));
-  } else {
-    datatype->extent(&lb, &dataext);
-    // Local copy from root
-    if (real_sendbuf != nullptr && recvbuf != nullptr)
-      Datatype::copy(real_sendbuf, count, datatype, recvbuf, count, datatype);
-    // Receive buffers from senders
-    for (int src = 0; src < size; src++) {
-      if (src != root) {
-        requests.push_back(Request::irecv_init(smpi_get_tmp_sendbuffer(count * dataext), count, datatype, src, system_tag, comm));
-      }
-    }
-  }
-  (*request)->start_nbc_requests(requests);
-  if( sendbuf == MPI_IN_PLACE ) {
-    smpi_free_tmp_buffer(tmp_sendbuf);
-  }
+  start_schedule(
+      *request, persistent, {"ireduce", comm, system_tag, {sendbuf, recvbuf, datatype, op}, {count, root}},
+      [&](NbcSchedule& schedule) {
+        if (rank != root) {
+          // Send buffer to root (MPI_IN_PLACE is only valid at root, but some codes use it everywhere)
+          schedule.add(Request::isend_init(sendbuf == MPI_IN_PLACE ? recvbuf : sendbuf, count, datatype, root,
+                                           system_tag, comm));
+          return;
+        }
+        datatype->extent(&lb, &dataext);
+        // Local copy from root
+        if (sendbuf != MPI_IN_PLACE && sendbuf != nullptr && recvbuf != nullptr)
+          schedule.set_prologue([=] { Datatype::copy(sendbuf, count, datatype, recvbuf, count, datatype); });
+        // Receive buffers from senders
+        for (int src = 0; src < size; src++) {
+          if (src != root)
+            schedule.add(Request::irecv_init(schedule.tmp_buffer(count * dataext), count, datatype, src, system_tag,
+                                             comm));
+        }
+      });
   return MPI_SUCCESS;
 }
 
 int colls::iallreduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op, MPI_Comm comm,
-                      MPI_Request* request, int external)
+                      MPI_Request* request, int external, bool persistent)
 {
 
   const int system_tag = COLL_TAG_ALLREDUCE-external;
   MPI_Aint lb = 0;
   MPI_Aint dataext = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
@@ -445,17 +494,22 @@ int colls::iallreduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatyp
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC, op);
   // FIXME: check for errors
   datatype->extent(&lb, &dataext);
-  // Local copy from self
-  Datatype::copy(sendbuf, count, datatype, recvbuf, count, datatype);
-  // Send/Recv buffers to/from others;
-  for (int other = 0; other < size; other++) {
-    if(other != rank) {
-      requests.push_back(Request::isend_init(sendbuf, count, datatype, other, system_tag,comm));
-      requests.push_back(Request::irecv_init(smpi_get_tmp_sendbuffer(count * dataext), count, datatype,
-                                        other, system_tag, comm));
-    }
-  }
-  (*request)->start_nbc_requests(requests);
+  start_schedule(
+      *request, persistent, {"iallreduce", comm, system_tag, {sendbuf, recvbuf, datatype, op}, {count}},
+      [&](NbcSchedule& schedule) {
+        // Local copy from self
+        if (sendbuf != MPI_IN_PLACE)
+          schedule.set_prologue([=] { Datatype::copy(sendbuf, count, datatype, recvbuf, count, datatype); });
+        // Send/Recv buffers to/from others;
+        for (int other = 0; other < size; other++) {
+          if (other != rank) {
+            schedule.add(Request::isend_init(sendbuf == MPI_IN_PLACE ? recvbuf : sendbuf, count, datatype, other,
+                                             system_tag, comm));
+            schedule.add(Request::irecv_init(schedule.tmp_buffer(count * dataext), count, datatype, other, system_tag,
+                                             comm));
+          }
+        }
+      });
   return MPI_SUCCESS;
 }
 
@@ -465,7 +519,6 @@ int colls::iscan(const void* sendbuf, void* recvbuf, int count, MPI_Datatype dat
   int system_tag = -888-external;
   MPI_Aint lb      = 0;
   MPI_Aint dataext = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
@@ -473,18 +526,20 @@ int colls::iscan(const void* sendbuf, void* recvbuf, int count, MPI_Datatype dat
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC, op);
   datatype->extent(&lb, &dataext);
 
-  // Local copy from self
-  Datatype::copy(sendbuf, count, datatype, recvbuf, count, datatype);
-
-  // Send/Recv buffers to/from others
-  for (int other = 0; other < rank; other++) {
-    requests.push_back(Request::irecv_init(smpi_get_tmp_sendbuffer(count * dataext), count, datatype, other, system_tag, comm));
-  }
-  for (int other = rank + 1; other < size; other++) {
-    requests.push_back(Request::isend_init(sendbuf, count, datatype, other, system_tag, comm));
-  }
-  // Wait for completion of all comms.
-  (*request)->start_nbc_requests(requests);
+  start_schedule(*request, false, {"iscan", comm, system_tag, {sendbuf, recvbuf, datatype, op}, {count}},
+                 [&](NbcSchedule& schedule) {
+                   // Local copy from self
+                   schedule.set_prologue([=] { Datatype::copy(sendbuf, count, datatype, recvbuf, count, datatype); });
+
+                   // Send/Recv buffers to/from others
+                   for (int other = 0; other < rank; other++) {
+                     schedule.add(Request::irecv_init(schedule.tmp_buffer(count * dataext), count, datatype, other,
+                                                      system_tag, comm));
+                   }
+                   for (int other = rank + 1; other < size; other++) {
+                     schedule.add(Request::isend_init(sendbuf, count, datatype, other, system_tag, comm));
+                   }
+                 });
   return MPI_SUCCESS;
 }
 
@@ -494,25 +549,27 @@ int colls::iexscan(const void* sendbuf, void* recvbuf, int count, MPI_Datatype d
   int system_tag = -888-external;
   MPI_Aint lb         = 0;
   MPI_Aint dataext    = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
   (*request) = new Request( recvbuf, count, datatype,
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC, op);
   datatype->extent(&lb, &dataext);
-  if(rank != 0)
-    memset(recvbuf, 0, count*dataext);
 
-  // Send/Recv buffers to/from others
-  for (int other = 0; other < rank; other++) {
-    requests.push_back(Request::irecv_init(smpi_get_tmp_sendbuffer(count * dataext), count, datatype, other, system_tag, comm));
-  }
-  for (int other = rank + 1; other < size; other++) {
-    requests.push_back(Request::isend_init(sendbuf, count, datatype, other, system_tag, comm));
-  }
-  // Wait for completion of all comms.
-  (*request)->start_nbc_requests(requests);
+  start_schedule(*request, false, {"iexscan", comm, system_tag, {sendbuf, recvbuf, datatype, op}, {count}},
+                 [&](NbcSchedule& schedule) {
+                   if (rank != 0)
+                     schedule.set_prologue([=] { memset(recvbuf, 0, count * dataext); });
+
+                   // Send/Recv buffers to/from others
+                   for (int other = 0; other < rank; other++) {
+                     schedule.add(Request::irecv_init(schedule.tmp_buffer(count * dataext), count, datatype, other,
+                                                      system_tag, comm));
+                   }
+                   for (int other = rank + 1; other < size; other++) {
+                     schedule.add(Request::isend_init(sendbuf, count, datatype, other, system_tag, comm));
+                   }
+                 });
   return MPI_SUCCESS;
 }
 
@@ -523,7 +580,6 @@ int colls::ireduce_scatter(const void* sendbuf, void* recvbuf, const int* recvco
   const int system_tag = COLL_TAG_REDUCE_SCATTER-external;
   MPI_Aint lb = 0;
   MPI_Aint dataext = 0;
-  std::vector<MPI_Request> requests;
 
   int rank = comm->rank();
   int size = comm->size();
@@ -532,20 +588,28 @@ int colls::ireduce_scatter(const void* sendbuf, void* recvbuf, const int* recvco
                          rank,rank, system_tag, comm, MPI_REQ_PERSISTENT|MPI_REQ_NBC, op);
   datatype->extent(&lb, &dataext);
 
-  // Send/Recv buffers to/from others;
-  int recvdisp=0;
-  for (int other = 0; other < size; other++) {
-    if(other != rank) {
-      requests.push_back(Request::isend_init(static_cast<const char *>(sendbuf) + recvdisp * dataext, recvcounts[other], datatype, other, system_tag,comm));
-      XBT_VERB("sending with recvdisp %d", recvdisp);
-      requests.push_back(Request::irecv_init(smpi_get_tmp_sendbuffer(count * dataext), count, datatype,
-                                        other, system_tag, comm));
-    }else{
-      Datatype::copy(static_cast<const char *>(sendbuf) + recvdisp * dataext, count, datatype, recvbuf, count, datatype);
-    }
-    recvdisp+=recvcounts[other];
-  }
-  (*request)->start_nbc_requests(requests);
+  start_schedule(*request, false,
+                 {"ireduce_scatter", comm, system_tag, {sendbuf, recvbuf, datatype, op},
+                  std::vector<int>(recvcounts, recvcounts + size)},
+                 [&](NbcSchedule& schedule) {
+                   // Send/Recv buffers to/from others;
+                   int recvdisp = 0;
+                   for (int other = 0; other < size; other++) {
+                     if (other != rank) {
+                       schedule.add(Request::isend_init(static_cast<const char*>(sendbuf) + recvdisp * dataext,
+                                                        recvcounts[other], datatype, other, system_tag, comm));
+                       XBT_VERB("sending with recvdisp %d", recvdisp);
+                       schedule.add(Request::irecv_init(schedule.tmp_buffer(count * dataext), count, datatype, other,
+                                                        system_tag, comm));
+                     } else {
+                       schedule.set_prologue([=] {
+                         Datatype::copy(static_cast<const char*>(sendbuf) + recvdisp * dataext, count, datatype,
+                                        recvbuf, count, datatype);
+                       });
+                     }
+                     recvdisp += recvcounts[other];
+                   }
+                 });
   return MPI_SUCCESS;
 }
 
@@ -0,0 +1,86 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#include "smpi_nbc_schedule.hpp"
+#include "private.hpp"
+#include "smpi_actor.hpp"
+#include "smpi_request.hpp"
+#include "xbt/config.hpp"
+
+#include <algorithm>
+
+XBT_LOG_NEW_DEFAULT_SUBCATEGORY(smpi_nbc, smpi, "Logging specific to SMPI (schedules of nonblocking collectives)");
+
+static simgrid::config::Flag<int> smpi_nbc_schedule_cache(
+    "smpi/nbc-schedule-cache", "Number of schedules of nonblocking collectives kept by each rank for reuse (0: none)",
+    16, [](int value) { xbt_assert(value >= 0, "smpi/nbc-schedule-cache cannot be negative"); });
+
+namespace simgrid::smpi {
+
+bool NbcSchedule::Key::operator==(const Key& other) const
+{
+  return collective == other.collective && comm == other.comm && tag == other.tag && handles == other.handles &&
+         values == other.values;
+}
+
+NbcSchedule::~NbcSchedule()
+{
+  for (auto& request : requests_)
+    Request::unref(&request);
+  for (auto* buffer : tmp_buffers_)
+    smpi_free_tmp_buffer(buffer);
+}
+
+unsigned char* NbcSchedule::tmp_buffer(size_t size)
+{
+  tmp_buffers_.push_back(smpi_get_tmp_sendbuffer(size));
+  return tmp_buffers_.back();
+}
+
+void NbcSchedule::start()
+{
+  xbt_assert(not active_, "Cannot restart the unfinished collective %s", key_.collective.data());
+  active_ = true;
+  if (prologue_)
+    prologue_();
+  Request::startall(static_cast<int>(requests_.size()), requests_.data());
+}
+
+std::shared_ptr<NbcSchedule> NbcSchedule::get(Key key, const std::function<void(NbcSchedule&)>& build)
+{
+  auto& cache = smpi_process()->nbc_schedules();
+  auto cached = std::find_if(cache.begin(), cache.end(), [&key](auto const& schedule) {
+    return not schedule->active_ && schedule->key_ == key;
+  });
+  if (cached != cache.end()) {
+    XBT_DEBUG("Reuse the schedule of %s with %zu requests", key.collective.data(), (*cached)->requests_.size());
+    cache.splice(cache.begin(), cache, cached); // Keep the most recently used first
+    return cache.front();
+  }
+
+  auto schedule = create(std::move(key), build);
+  if (smpi_nbc_schedule_cache > 0) {
+    cache.push_front(schedule);
+    // The evicted schedule may still be running: its requests are freed when it completes
+    if (cache.size() > static_cast<size_t>(smpi_nbc_schedule_cache.get()))
+      cache.pop_back();
+  }
+  return schedule;
+}
+
+std::shared_ptr<NbcSchedule> NbcSchedule::create(Key key, const std::function<void(NbcSchedule&)>& build)
+{
+  auto schedule = std::make_shared<NbcSchedule>(std::move(key));
+  build(*schedule);
+  XBT_DEBUG("New schedule of %s with %zu requests", schedule->key_.collective.data(), schedule->requests_.size());
+  return schedule;
+}
+
+void NbcSchedule::forget(MPI_Comm comm)
+{
+  if (ActorExt* process = smpi_process())
+    process->nbc_schedules().remove_if([comm](auto const& schedule) { return schedule->key_.comm == comm; });
+}
+} // namespace simgrid::smpi
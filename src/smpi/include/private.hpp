@@ -11,6 +11,7 @@
 #include "smpi_utils.hpp"
 #include "src/instr/instr_smpi.hpp"
 #include "xbt/base.h"
+#include <algorithm>
 #include <unordered_map>
 #include <vector>
 
@@ -48,6 +49,7 @@ constexpr int COLL_TAG_ALLTOALL       = -1112;
 constexpr int COLL_TAG_GATHERV        = -2223;
 constexpr int COLL_TAG_BCAST          = -3334;
 constexpr int COLL_TAG_ALLREDUCE      = -4445;
+constexpr int COLL_TAG_FILE           = -5556;
 
 // SMPI_RMA_TAG has to be the smallest one, as it will be decremented for accumulate ordering.
 constexpr int SMPI_RMA_TAG            = -6666;
@@ -100,7 +102,7 @@ XBT_PRIVATE double smpi_mpi_wtime();
 XBT_PRIVATE void smpi_mpi_init();
 
 enum class SharedMallocType { NONE, LOCAL, GLOBAL };
-enum class SmpiPrivStrategies { NONE = 0, MMAP = 1, DLOPEN = 2, DEFAULT = DLOPEN };
+enum class SmpiPrivStrategies { NONE = 0, MMAP = 1, DLOPEN = 2, MEMFD = 3, DEFAULT = DLOPEN };
 
 XBT_PRIVATE double smpi_cfg_host_speed();
 XBT_PRIVATE bool smpi_cfg_simulate_computation();
@@ -122,11 +124,13 @@ XBT_PRIVATE bool smpi_cfg_display_alloc();
 XBT_PRIVATE void smpi_init_options_internal(bool called_by_smpi_main);
 
 XBT_PRIVATE bool smpi_switch_data_segment(simgrid::s4u::ActorPtr actor, const void* addr = nullptr);
+XBT_PRIVATE void* smpi_privatized_address(simgrid::s4u::ActorPtr actor, void* addr, size_t size);
 
 XBT_PRIVATE void smpi_prepare_global_memory_segment();
 XBT_PRIVATE void smpi_backup_global_memory_segment();
 XBT_PRIVATE void smpi_destroy_global_memory_segments();
 XBT_PRIVATE void smpi_bench_destroy();
+XBT_PRIVATE void smpi_bench_register_binary(const std::string& executable);
 XBT_PRIVATE void smpi_shared_destroy();
 XBT_PRIVATE double smpi_adjust_comp_speed();
 XBT_PRIVATE double smpi_autobench();
@@ -141,10 +145,71 @@ public:
   ~SmpiBenchGuard() { smpi_bench_begin(); }
 };
 
+/** Finds the SMPI_SHARED_MALLOC allocation containing ptr, without copying its metadata.
+ *
+ * Returns the private blocks of that allocation (sorted [begin, end) offsets from its start), and sets offset to the
+ * position of ptr in it. Returns nullptr if ptr is not in a shared allocation.
+ */
+XBT_PRIVATE const std::vector<std::pair<size_t, size_t>>* smpi_shared_private_blocks(const void* ptr, size_t* offset);
+
+namespace simgrid::smpi {
+/** @brief Cursor over the private blocks of a buffer of a given size, relative to the start of this buffer
+ *
+ * This frames the blocks of the allocation containing the buffer (as returned by smpi_shared_private_blocks) on the
+ * fly, without building a new list. A buffer that is not in a shared allocation is a single private block.
+ */
+class XBT_PRIVATE PrivateBlockCursor {
+  using block_t = std::pair<size_t, size_t>;
+  const block_t* cur_;
+  const block_t* end_;
+  size_t offset_;
+  size_t size_;
+  block_t whole_{0, 0};
+
+public:
+  PrivateBlockCursor(const std::vector<block_t>* blocks, size_t offset, size_t size) : offset_(offset), size_(size)
+  {
+    if (blocks == nullptr) {
+      whole_ = {offset, offset + size};
+      cur_   = &whole_;
+      end_   = cur_ + 1;
+    } else {
+      end_ = blocks->data() + blocks->size();
+      cur_ = std::partition_point(blocks->data(), end_, [offset](const block_t& b) { return b.second <= offset; });
+    }
+  }
+  PrivateBlockCursor(const PrivateBlockCursor&)            = delete;
+  PrivateBlockCursor& operator=(const PrivateBlockCursor&) = delete;
+
+  /** Whether all the private blocks of the buffer were visited (i.e., no more data to copy) */
+  bool done() const { return cur_ == end_ || cur_->first >= offset_ + size_ || size_ == 0; }
+  size_t begin() const { return std::max(cur_->first, offset_) - offset_; }
+  size_t end() const { return std::min(cur_->second, offset_ + size_) - offset_; }
+  void next() { ++cur_; }
+};
+
+/** Calls f(begin, end) on each range of the buffers that is private on both sides, in increasing order */
+template <class F> void for_each_private_range(PrivateBlockCursor& src, PrivateBlockCursor& dst, F f)
+{
+  while (not src.done() && not dst.done()) {
+    size_t begin = std::max(src.begin(), dst.begin());
+    size_t end   = std::min(src.end(), dst.end());
+    if (begin < end)
+      f(begin, end);
+    if (src.end() < dst.end())
+      src.next();
+    else
+      dst.next();
+  }
+}
+} // namespace simgrid::smpi
+
 XBT_PRIVATE unsigned char* smpi_get_tmp_sendbuffer(size_t size);
 XBT_PRIVATE unsigned char* smpi_get_tmp_recvbuffer(size_t size);
 XBT_PRIVATE void smpi_free_tmp_buffer(const unsigned char* buf);
 XBT_PRIVATE void smpi_free_replay_tmp_buffers();
+XBT_PRIVATE void* smpi_get_eager_buffer(size_t size);
+XBT_PRIVATE void smpi_free_eager_buffer(void* buf);
 
 extern "C" {
 // f77 wrappers
@@ -10,16 +10,20 @@
 #include "simgrid/s4u/Mailbox.hpp"
 #include "src/instr/instr_smpi.hpp"
 #include "xbt/xbt_os_time.h"
+#include <list>
+#include <memory>
 #include <string_view>
 
 namespace simgrid::smpi {
 
+class NbcSchedule;
+
 class ActorExt {
   double simulated_ = 0 /* Used to time with simulated_start/elapsed */;
   s4u::Mailbox* mailbox_;
   s4u::Mailbox* mailbox_small_;
   s4u::MutexPtr mailboxes_mutex_;
-  xbt_os_timer_t timer_;
+  xbt_os_timer_t timer_ = nullptr;
   MPI_Comm comm_self_   = MPI_COMM_NULL;
   MPI_Comm comm_intra_  = MPI_COMM_NULL;
   MPI_Comm* comm_world_ = nullptr;
@@ -39,6 +43,7 @@ class ActorExt {
   MPI_Info info_env_;
   void* bsend_buffer_    = nullptr;
   int bsend_buffer_size_ = 0;
+  std::list<std::shared_ptr<NbcSchedule>> nbc_schedules_; // most recently used first
 
 #if HAVE_PAPI
   /** Contains hardware data as read by PAPI **/
@@ -50,6 +55,8 @@ public:
   static simgrid::xbt::Extension<simgrid::s4u::Actor, ActorExt> EXTENSION_ID;
 
   explicit ActorExt(s4u::Actor* actor);
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr);
   ActorExt(const ActorExt&) = delete;
   ActorExt& operator=(const ActorExt&) = delete;
   ~ActorExt();
@@ -92,6 +99,7 @@ public:
   MPI_Info info_env();
   void bsend_buffer(void** buf, int* size);
   int set_bsend_buffer(void* buf, int size);
+  std::list<std::shared_ptr<NbcSchedule>>& nbc_schedules() { return nbc_schedules_; }
 };
 
 } // namespace simgrid::smpi
@@ -17,6 +17,8 @@
 
 namespace simgrid::smpi {
 
+class TopoHierarchy;
+
 class Comm : public F2C, public Keyval{
   friend Topo;
   MPI_Group group_         = MPI_GROUP_NULL;
@@ -32,6 +34,7 @@ class Comm : public F2C, public Keyval{
   bool is_blocked_      = false;   // are ranks allocated on the same smp node contiguous?
   bool is_smp_comm_     = false;   // set to false in case this is already an intra-comm or a leader-comm to avoid
                                    // recursion
+  std::shared_ptr<TopoHierarchy> topo_hierarchy_; // for the hierarchical collectives, computed on first use
   std::list<MPI_Win> rma_wins_; // attached windows for synchronization.
   std::string name_;
   MPI_Info info_ = MPI_INFO_NULL;
@@ -81,6 +84,8 @@ public:
   static void unref(MPI_Comm comm);
   static void destroy(MPI_Comm comm);
   void init_smp();
+  std::shared_ptr<TopoHierarchy> get_topo_hierarchy() const { return topo_hierarchy_; }
+  void set_topo_hierarchy(std::shared_ptr<TopoHierarchy> hierarchy) { topo_hierarchy_ = std::move(hierarchy); }
 
   static void free_f(int id);
   static Comm* f2c(int);
@@ -8,7 +8,7 @@
 
 #include "smpi_f2c.hpp"
 #include <smpi/smpi.h>
-#include <map>
+#include <unordered_map>
 #include <vector>
 
 namespace simgrid::smpi {
@@ -18,16 +18,28 @@ class Group : public F2C{
    * O(log(n)). For a vector, this costs O(1). We hence go with the vector.
    */
   std::vector<aid_t> rank_to_pid_map_;
+
+  /* The reverse map is sized after the group instead of after the largest pid: a vector indexed by pid would cost
+   * O(P) to each of the MPI_COMM_SELF of P ranks. Most groups (MPI_COMM_WORLD included) map their ranks to consecutive
+   * pids and need no reverse map at all. The others use a vector offset by the smallest pid when their pids are dense
+   * enough, and a hash map otherwise.
+   */
+  enum class Index { EMPTY, IDENTITY, DENSE, SPARSE };
+  Index index_     = Index::EMPTY;
+  aid_t first_pid_ = 0; // pid of rank 0 for IDENTITY, pid of pid_to_rank_map_[0] for DENSE
   std::vector<int> pid_to_rank_map_;
+  std::unordered_map<aid_t, int> pid_to_rank_sparse_;
 
   int refcount_ = 1; /* refcount_: start > 0 so that this group never gets freed */
 
   int incl(const std::vector<int>& ranks, MPI_Group* newgroup) const;
   int excl(const std::vector<bool>& excl_map, MPI_Group* newgroup) const;
+  void build_index(aid_t min_pid, aid_t max_pid);
+  int lookup(aid_t pid) const;
 
 public:
   Group() = default;
-  explicit Group(int size) : rank_to_pid_map_(size, -1), pid_to_rank_map_(size, MPI_UNDEFINED) {}
+  explicit Group(int size) : rank_to_pid_map_(size, -1) {}
   explicit Group(const Group* origin);
 
   void set_mapping(aid_t pid, int rank);
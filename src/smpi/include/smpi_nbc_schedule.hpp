@@ -0,0 +1,72 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+#ifndef SMPI_NBC_SCHEDULE_HPP
+#define SMPI_NBC_SCHEDULE_HPP
+
+#include "smpi/smpi.h"
+
+#include <functional>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace simgrid::smpi {
+
+/** @brief Prebuilt communications of a nonblocking collective, restarted as a whole
+ *
+ * A schedule holds the persistent requests of one collective call, the temporary buffers in which the partial results
+ * of the reductions are received, and the local copies to redo at each start. Each rank keeps the schedules of its
+ * last calls in a small cache (--cfg=smpi/nbc-schedule-cache), so that calling the same collective again with the same
+ * arguments only restarts the requests. The persistent collectives (MPI_Allreduce_init and friends) own a schedule
+ * that is started by each MPI_Start.
+ */
+class NbcSchedule {
+public:
+  /** Arguments of the collective call. Two calls with the same key build the same requests. */
+  struct Key {
+    std::string_view collective;
+    MPI_Comm comm;
+    int tag;
+    std::vector<const void*> handles; // buffers, datatypes and operation
+    std::vector<int> values;          // counts, displacements and root
+    bool operator==(const Key& other) const;
+  };
+
+private:
+  Key key_;
+  std::vector<MPI_Request> requests_;
+  std::vector<unsigned char*> tmp_buffers_;
+  std::function<void()> prologue_;
+  bool active_ = false;
+
+public:
+  explicit NbcSchedule(Key key) : key_(std::move(key)) {}
+  NbcSchedule(const NbcSchedule&) = delete;
+  NbcSchedule& operator=(const NbcSchedule&) = delete;
+  ~NbcSchedule();
+
+  /** Adds a persistent request, freed with the schedule */
+  void add(MPI_Request request) { requests_.push_back(request); }
+  /** Allocates a temporary buffer, freed with the schedule */
+  unsigned char* tmp_buffer(size_t size);
+  /** Sets the local work done at each start, before the communications */
+  void set_prologue(std::function<void()> prologue) { prologue_ = std::move(prologue); }
+
+  const std::vector<MPI_Request>& requests() const { return requests_; }
+  bool is_active() const { return active_; }
+  void start();
+  void complete() { active_ = false; }
+
+  /** Returns an inactive schedule of that collective from the cache of the calling rank, or builds it */
+  static std::shared_ptr<NbcSchedule> get(Key key, const std::function<void(NbcSchedule&)>& build);
+  /** Builds a schedule that is not shared through the cache, for the persistent collectives */
+  static std::shared_ptr<NbcSchedule> create(Key key, const std::function<void(NbcSchedule&)>& build);
+  /** Drops the schedules of that communicator from the cache of the calling rank */
+  static void forget(MPI_Comm comm);
+};
+
+} // namespace simgrid::smpi
+#endif
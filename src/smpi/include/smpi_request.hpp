@@ -13,6 +13,8 @@
 
 namespace simgrid::smpi {
 
+class NbcSchedule;
+
 struct smpi_mpi_generalized_request_funcs_t {
   MPI_Grequest_query_function *query_fn;
   MPI_Grequest_free_function *free_fn;
@@ -51,6 +53,7 @@ class Request : public F2C {
   MPI_Op op_;
   std::unique_ptr<smpi_mpi_generalized_request_funcs_t> generalized_funcs;
   std::vector<MPI_Request> nbc_requests_;
+  std::shared_ptr<NbcSchedule> nbc_schedule_; // owns the nbc_requests_ when set
   s4u::Host* src_host_ = nullptr; //!< save SimGrid's source host since it can finished before the recv
   static bool match_common(MPI_Request req, MPI_Request sender, MPI_Request receiver);
   static bool match_types(MPI_Datatype stype, MPI_Datatype rtype);
@@ -75,6 +78,8 @@ public:
   void init_buffer(int count);
   void ref();
   void start_nbc_requests(std::vector<MPI_Request> reqs);
+  void start_nbc_schedule(std::shared_ptr<NbcSchedule> schedule);
+  void prepare_nbc_schedule(std::shared_ptr<NbcSchedule> schedule);
   static int finish_nbc_requests(MPI_Request* req, int test);
   std::vector<MPI_Request> get_nbc_requests() const;
   static void finish_wait(MPI_Request* request, MPI_Status* status);
@@ -12,8 +12,9 @@
 #include "smpi_keyvals.hpp"
 #include "smpi_config.hpp"
 
-#include <vector>
 #include <list>
+#include <map>
+#include <vector>
 
 namespace simgrid::smpi {
 
@@ -42,6 +43,32 @@ class Win : public F2C, public Keyval {
   bool dynamic_;
   MPI_Errhandler errhandler_ = _smpi_cfg_default_errhandler_is_error ? MPI_ERRORS_ARE_FATAL : MPI_ERRORS_RETURN;
 
+  /* Batched mode (info key "smpi_batch_rma"): the puts, gets and accumulates without request are queued per target,
+   * and each queue becomes one simulated transfer per direction at the next synchronization. The queues are only
+   * accessed by the owner of the window, so they need no lock. */
+  struct BatchedOp {
+    void* origin_addr; // Where to write the result of a get
+    int origin_count;
+    MPI_Datatype origin_datatype;
+    void* target_addr;
+    int target_count;
+    MPI_Datatype target_datatype;
+    MPI_Op op;     // MPI_REPLACE for a put, MPI_OP_NULL for a get
+    size_t offset; // Of the packed origin data in the payload (puts and accumulates only)
+    size_t size;   // Amount of bytes to transfer
+  };
+  struct Batch {
+    std::vector<BatchedOp> ops;
+    std::vector<unsigned char> payload; // Origin data of the puts and accumulates, packed when they are called
+    size_t get_size = 0;                // Amount of bytes to bring back for the gets
+  };
+  bool batched_ = false;
+  std::map<int, Batch> batches_; // By target rank. Emptied but kept between epochs to reuse the buffers
+
+  void batch_op(int target_rank, const void* origin_addr, int origin_count, MPI_Datatype origin_datatype,
+                void* target_addr, int target_count, MPI_Datatype target_datatype, MPI_Op op);
+  int flush_batches(int rank); // MPI_ANY_SOURCE for all targets
+
 public:
   static std::unordered_map<int, smpi_key_elem> keyvals_;
   static int keyval_id_;
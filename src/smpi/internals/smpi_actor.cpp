@@ -12,6 +12,10 @@
 #include "src/mc/mc_replay.hpp"
 #include "xbt/str.h"
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #if HAVE_PAPI
 #include <papi.h>
 #endif
@@ -21,6 +25,54 @@ XBT_LOG_NEW_DEFAULT_SUBCATEGORY(smpi_process, smpi, "Logging specific to SMPI (k
 namespace simgrid::smpi {
 simgrid::xbt::Extension<simgrid::s4u::Actor, ActorExt> ActorExt::EXTENSION_ID;
 
+namespace {
+/* The ActorExt of the ranks are allocated by slabs instead of one by one, and the slots of the terminated ranks are
+ * reused by the next ones. The slabs are never given back, as the ranks of the next instances will need them too. */
+class ActorExtArena {
+  static constexpr size_t slab_size = 1024;
+  std::vector<std::unique_ptr<unsigned char[]>> slabs_;
+  std::vector<void*> free_slots_;
+  std::mutex mutex_; // With parallel contexts, actors may be created or destroyed concurrently
+
+public:
+  void* allocate()
+  {
+    const std::scoped_lock lock(mutex_);
+    if (free_slots_.empty()) {
+      const auto& slab = slabs_.emplace_back(std::make_unique<unsigned char[]>(slab_size * sizeof(ActorExt)));
+      for (size_t i = slab_size; i > 0; i--)
+        free_slots_.push_back(slab.get() + (i - 1) * sizeof(ActorExt));
+    }
+    void* slot = free_slots_.back();
+    free_slots_.pop_back();
+    return slot;
+  }
+  void release(void* slot)
+  {
+    const std::scoped_lock lock(mutex_);
+    free_slots_.push_back(slot);
+  }
+};
+
+ActorExtArena& actor_ext_arena()
+{
+  static auto* arena = new ActorExtArena(); // Never destroyed: some actors may be destroyed after the static objects
+  return *arena;
+}
+} // namespace
+
+void* ActorExt::operator new(size_t size)
+{
+  xbt_assert(size == sizeof(ActorExt));
+  return actor_ext_arena().allocate();
+}
+
+void ActorExt::operator delete(void* ptr)
+{
+  if (ptr != nullptr)
+    actor_ext_arena().release(ptr);
+}
+
 ActorExt::ActorExt(s4u::Actor* actor) : actor_(actor)
 {
   if (not simgrid::smpi::ActorExt::EXTENSION_ID.valid())
@@ -29,7 +81,6 @@ ActorExt::ActorExt(s4u::Actor* actor) : actor_(actor)
   mailbox_         = nullptr;
   mailbox_small_   = nullptr;
   mailboxes_mutex_ = s4u::Mutex::create();
-  timer_           = xbt_os_timer_new();
   state_           = SmpiProcessState::UNINITIALIZED;
   info_env_        = MPI_INFO_NULL;
 
@@ -53,7 +104,8 @@ ActorExt::ActorExt(s4u::Actor* actor) : actor_(actor)
 
 ActorExt::~ActorExt()
 {
-  xbt_os_timer_free(timer_);
+  if (timer_ != nullptr)
+    xbt_os_timer_free(timer_);
 }
 
 /** @brief Prepares the current process for termination. */
@@ -61,6 +113,7 @@ void ActorExt::finalize()
 {
   state_ = SmpiProcessState::FINALIZED;
   XBT_DEBUG("<%ld> Process left the game", actor_->get_pid());
+  nbc_schedules_.clear(); // Release the requests that they hold on the communicators
   if (info_env_ != MPI_INFO_NULL)
     simgrid::smpi::Info::unref(info_env_);
   if (comm_self_ != MPI_COMM_NULL)
@@ -186,6 +239,8 @@ papi_counter_t& ActorExt::papi_counters()
 
 xbt_os_timer_t ActorExt::timer()
 {
+  if (timer_ == nullptr) // Only the ranks that benchmark their computations need a timer
+    timer_ = xbt_os_timer_new();
   return timer_;
 }
 
@@ -21,9 +21,14 @@
 #include "xbt/log.h"
 #include "xbt/xbt_os_time.h"
 
+#include <algorithm>
 #include <cerrno>
+#include <cinttypes>
 #include <cmath>
+#include <cstdio>
+#include <fstream>
 #include <sys/mman.h>
+#include <unistd.h>
 #include <unordered_map>
 
 #if HAVE_PAPI
@@ -37,6 +42,12 @@ static simgrid::config::Flag<double>
                      "Minimum time to inject inside a call to MPI_Wtime(), gettimeofday() and clock_gettime()",
                      1e-8 /* Documented to be 10 ns */);
 
+static simgrid::config::Flag<std::string>
+    smpi_sample_db("smpi/sample-db",
+                   "File where the SMPI_SAMPLE_* benchmarks are saved, to be reused by the next simulations of the same "
+                   "binary on the same CPU model",
+                   "");
+
 // Private execute_flops used by smpi_execute and smpi_execute_benched
 void private_execute_flops(double flops) {
   xbt_assert(flops >= 0, "You're trying to execute a negative amount of flops (%f)!", flops);
@@ -291,6 +302,138 @@ bool LocalData::need_more_benchs() const
 }
 
 std::unordered_map<SampleLocation, LocalData, std::hash<std::string>> samples;
+std::vector<std::string> sampled_binaries;
+
+/* FNV-1a, which is stable across runs (unlike std::hash) */
+uint64_t fnv1a(uint64_t hash, const char* data, size_t size)
+{
+  for (size_t i = 0; i < size; i++)
+    hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ULL;
+  return hash;
+}
+
+/** @brief On-disk database of the samples (--cfg=smpi/sample-db), to skip the benchmarks already done by previous runs
+ *
+ * Each line holds, separated by tabs: the fingerprint of the binaries, the CPU model, the location of the sample, its
+ * settings (iters and threshold) and its statistics (count, sum and sum_pow2). A sample is only reused by a simulation
+ * with the same fingerprint, CPU model, location and settings. The lines of other binaries or CPUs are kept untouched.
+ */
+class SampleDatabase {
+  std::string key_; // fingerprint and CPU model of this run, or empty if the database is not used
+  std::unordered_map<std::string, LocalData> stored_;
+  std::vector<std::string> foreign_lines_;
+  bool loaded_ = false;
+
+  static std::string binaries_fingerprint();
+  static std::string cpu_model();
+
+public:
+  const LocalData* find(const std::string& location);
+  void save();
+};
+
+std::string SampleDatabase::binaries_fingerprint()
+{
+  std::vector<std::string> binaries = sampled_binaries;
+  if (binaries.empty()) // SMPI was started by the application itself
+    binaries.emplace_back("/proc/self/exe");
+  std::sort(binaries.begin(), binaries.end());
+  binaries.erase(std::unique(binaries.begin(), binaries.end()), binaries.end());
+
+  uint64_t hash = 0xcbf29ce484222325ULL;
+  std::vector<char> buffer(1 << 20);
+  for (auto const& binary : binaries) {
+    std::ifstream in(binary, std::ios::binary);
+    if (not in.good()) {
+      XBT_WARN("Cannot read %s: the samples will not be saved in %s.", binary.c_str(), smpi_sample_db.get().c_str());
+      return "";
+    }
+    while (in.read(buffer.data(), static_cast<std::streamsize>(buffer.size())) || in.gcount() > 0)
+      hash = fnv1a(hash, buffer.data(), static_cast<size_t>(in.gcount()));
+  }
+  return simgrid::xbt::string_printf("%016" PRIx64, hash);
+}
+
+std::string SampleDatabase::cpu_model()
+{
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line))
+    if (line.rfind("model name", 0) == 0)
+      if (auto model = line.find_first_not_of(" \t:", line.find(':')); model != std::string::npos)
+        return line.substr(model);
+  return "unknown";
+}
+
+const LocalData* SampleDatabase::find(const std::string& location)
+{
+  if (not loaded_) {
+    loaded_ = true;
+    std::string fingerprint = binaries_fingerprint();
+    if (fingerprint.empty())
+      return nullptr;
+    key_ = fingerprint + '\t' + cpu_model() + '\t';
+
+    std::ifstream in(smpi_sample_db.get());
+    std::string line;
+    while (std::getline(in, line)) {
+      if (line.compare(0, key_.size(), key_) != 0) {
+        foreign_lines_.push_back(line);
+        continue;
+      }
+      auto tab = line.find('\t', key_.size());
+      LocalData data{};
+      if (tab == std::string::npos || sscanf(line.c_str() + tab, "\t%d\t%lf\t%d\t%lf\t%lf", &data.iters, &data.threshold,
+                                             &data.count, &data.sum, &data.sum_pow2) != 5 ||
+          data.count <= 0) {
+        XBT_WARN("Ignoring the malformed line of %s: %s", smpi_sample_db.get().c_str(), line.c_str());
+        continue;
+      }
+      data.mean      = data.sum / data.count;
+      data.relstderr = sqrt((data.sum_pow2 / data.count) - (data.mean * data.mean)) / data.mean;
+      stored_.insert_or_assign(line.substr(key_.size(), tab - key_.size()), data);
+    }
+    XBT_DEBUG("Loaded %zu samples from %s", stored_.size(), smpi_sample_db.get().c_str());
+  }
+  auto stored = stored_.find(location);
+  return stored == stored_.end() ? nullptr : &stored->second;
+}
+
+void SampleDatabase::save()
+{
+  if (key_.empty())
+    return;
+  for (auto const& [location, data] : samples)
+    if (data.count > 0 && location.find_first_of("\t\n") == std::string::npos)
+      stored_.insert_or_assign(location, data);
+
+  // Write a new file and rename it, so that concurrent simulations never see a partial database
+  std::string tmp_name = smpi_sample_db.get() + ".tmp" + std::to_string(getpid());
+  std::ofstream out(tmp_name);
+  for (auto const& line : foreign_lines_)
+    out << line << '\n';
+  for (auto const& [location, data] : stored_)
+    out << key_ << location
+        << simgrid::xbt::string_printf("\t%d\t%.17g\t%d\t%.17g\t%.17g\n", data.iters, data.threshold, data.count,
+                                       data.sum, data.sum_pow2);
+  out.close();
+  if (out.fail() || rename(tmp_name.c_str(), smpi_sample_db.get().c_str()) != 0) {
+    XBT_WARN("Cannot save the samples into %s", smpi_sample_db.get().c_str());
+    remove(tmp_name.c_str());
+  }
+}
+
+SampleDatabase sample_db;
+
+bool sample_db_enabled()
+{
+  return not smpi_sample_db.get().empty() && not MC_is_active() && not MC_record_replay_is_active();
+}
+} // namespace
+
+void smpi_bench_register_binary(const std::string& executable)
+{
+  sampled_binaries.push_back(executable);
 }
 
 int smpi_sample_cond(int global, const char* file, const char* tag, int iters, double threshold, int iter_count)
@@ -318,6 +461,14 @@ int smpi_sample_cond(int global, const char* file, const char* tag, int iters, d
     XBT_DEBUG("XXXXX First time ever on benched nest %s.", loc.c_str());
     xbt_assert(threshold > 0 || iters > 0,
         "You should provide either a positive amount of iterations to bench, or a positive maximal stderr (or both)");
+    if (sample_db_enabled()) {
+      const LocalData* stored = sample_db.find(loc);
+      if (stored != nullptr && stored->iters == iters && stored->threshold == threshold) {
+        data          = *stored;
+        data.benching = data.need_more_benchs();
+        XBT_DEBUG("Reusing the %d benchmarks of %s from %s", data.count, loc.c_str(), smpi_sample_db.get().c_str());
+      }
+    }
   } else {
     if (data.iters != iters || data.threshold != threshold) {
       XBT_ERROR("Asked to bench block %s with different settings %d, %f is not %d, %f. "
@@ -440,6 +591,8 @@ void smpi_trace_set_call_location__(const char* file, const int* line, const cha
 
 void smpi_bench_destroy()
 {
+  if (sample_db_enabled())
+    sample_db.save();
   samples.clear();
 }
 
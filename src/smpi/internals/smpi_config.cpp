@@ -238,7 +238,7 @@ void smpi_init_options_internal(bool called_by_smpi_main)
     default_privatization = "no";
 
   simgrid::config::declare_flag<std::string>(
-      "smpi/privatization", "How we should privatize global variable at runtime (no, yes, mmap, dlopen).",
+      "smpi/privatization", "How we should privatize global variable at runtime (no, yes, mmap, dlopen, memfd).",
       default_privatization, [](const std::string& smpi_privatize_option) {
         if (smpi_privatize_option == "no" || smpi_privatize_option == "0" || smpi_privatize_option == "OFF")
           _smpi_cfg_privatization = SmpiPrivStrategies::NONE;
@@ -248,6 +248,8 @@ void smpi_init_options_internal(bool called_by_smpi_main)
           _smpi_cfg_privatization = SmpiPrivStrategies::MMAP;
         else if (smpi_privatize_option == "dlopen")
           _smpi_cfg_privatization = SmpiPrivStrategies::DLOPEN;
+        else if (smpi_privatize_option == "memfd")
+          _smpi_cfg_privatization = SmpiPrivStrategies::MEMFD;
         else
           xbt_die("Invalid value for smpi/privatization: '%s'", smpi_privatize_option.c_str());
 
@@ -259,6 +261,10 @@ void smpi_init_options_internal(bool called_by_smpi_main)
           XBT_INFO("mmap privatization is broken on this platform, switching to dlopen privatization instead.");
           _smpi_cfg_privatization = SmpiPrivStrategies::DLOPEN;
         }
+        if (not HAVE_MEMFD_CREATE && _smpi_cfg_privatization == SmpiPrivStrategies::MEMFD) {
+          XBT_INFO("memfd privatization is not available on this platform, switching to dlopen privatization instead.");
+          _smpi_cfg_privatization = SmpiPrivStrategies::DLOPEN;
+        }
       });
 
   simgrid::config::declare_flag<std::string>(
@@ -29,7 +29,9 @@
 #include <dlfcn.h>
 #include <fcntl.h>
 #include <fstream>
+#include <sys/mman.h>
 #include <sys/stat.h>
+#include <vector>
 
 #if SG_HAVE_SENDFILE
 #include <sys/sendfile.h>
@@ -135,23 +137,14 @@ void smpi_comm_set_copy_data_callback(void (*callback) (smx_activity_t, void*, s
   smpi_comm_copy_data_callback = callback;
 }
 
-static void memcpy_private(void* dest, const void* src, const std::vector<std::pair<size_t, size_t>>& private_blocks)
-{
-  for (auto const& [block_begin, block_end] : private_blocks)
-    memcpy((uint8_t*)dest + block_begin, (uint8_t*)src + block_begin, block_end - block_begin);
-}
-
-static void check_blocks(const std::vector<std::pair<size_t, size_t>>& private_blocks, size_t buff_size)
-{
-  for (auto const& [block_begin, block_end] : private_blocks)
-    xbt_assert(block_begin <= block_end && block_end <= buff_size, "Oops, bug in shared malloc.");
-}
-
 static void smpi_cleanup_comm_after_copy(simgrid::kernel::activity::CommImpl* comm, void* buff){
   if (comm->is_detached()) {
     // if this is a detached send, the source buffer was duplicated by SMPI
     // sender to make the original buffer available to the application ASAP
-    xbt_free(buff);
+    if (comm->clean_fun)
+      comm->clean_fun(buff);
+    else
+      xbt_free(buff);
     //It seems that the request is used after the call there this should be free somewhere else but where???
     //xbt_free(comm->comm.src_data);// inside SMPI the request is kept inside the user data and should be free
     comm->src_buff_ = nullptr;
@@ -160,55 +153,54 @@ static void smpi_cleanup_comm_after_copy(simgrid::kernel::activity::CommImpl* co
 
 void smpi_comm_copy_buffer_callback(simgrid::kernel::activity::CommImpl* comm, void* buff, size_t buff_size)
 {
-  size_t src_offset                     = 0;
-  size_t dst_offset                     = 0;
-  std::vector<std::pair<size_t, size_t>> src_private_blocks;
-  std::vector<std::pair<size_t, size_t>> dst_private_blocks;
+  size_t src_offset = 0;
+  size_t dst_offset = 0;
   XBT_DEBUG("Copy the data over");
-  if(smpi_is_shared(buff, src_private_blocks, &src_offset)) {
-    src_private_blocks = shift_and_frame_private_blocks(src_private_blocks, src_offset, buff_size);
-    if (src_private_blocks.empty()) { // simple shared malloc ... return.
-      XBT_VERB("Sender is shared. Let's ignore it.");
-      smpi_cleanup_comm_after_copy(comm, buff);
-      return;
-    }
-  }
-  else {
-    src_private_blocks.clear();
-    src_private_blocks.emplace_back(0, buff_size);
-  }
-  if (smpi_is_shared((char*)comm->dst_buff_, dst_private_blocks, &dst_offset)) {
-    dst_private_blocks = shift_and_frame_private_blocks(dst_private_blocks, dst_offset, buff_size);
-    if (dst_private_blocks.empty()) { // simple shared malloc ... return.
-      XBT_VERB("Receiver is shared. Let's ignore it.");
-      smpi_cleanup_comm_after_copy(comm, buff);
-      return;
-    }
+  const auto* src_private_blocks = smpi_shared_private_blocks(buff, &src_offset);
+  simgrid::smpi::PrivateBlockCursor src_blocks(src_private_blocks, src_offset, buff_size);
+  if (src_blocks.done()) { // simple shared malloc ... return.
+    XBT_VERB("Sender is shared. Let's ignore it.");
+    smpi_cleanup_comm_after_copy(comm, buff);
+    return;
   }
-  else {
-    dst_private_blocks.clear();
-    dst_private_blocks.emplace_back(0, buff_size);
+  const auto* dst_private_blocks = smpi_shared_private_blocks(comm->dst_buff_, &dst_offset);
+  simgrid::smpi::PrivateBlockCursor dst_blocks(dst_private_blocks, dst_offset, buff_size);
+  if (dst_blocks.done()) { // simple shared malloc ... return.
+    XBT_VERB("Receiver is shared. Let's ignore it.");
+    smpi_cleanup_comm_after_copy(comm, buff);
+    return;
   }
-  check_blocks(src_private_blocks, buff_size);
-  check_blocks(dst_private_blocks, buff_size);
-  auto private_blocks = merge_private_blocks(src_private_blocks, dst_private_blocks);
-  check_blocks(private_blocks, buff_size);
-  void* tmpbuff=buff;
-  if (smpi_switch_data_segment(comm->src_actor_->get_iface(), buff)) {
-    XBT_DEBUG("Privatization : We are copying from a zone inside global memory... Saving data to temp buffer !");
-    tmpbuff = xbt_malloc(buff_size);
-    memcpy_private(tmpbuff, buff, private_blocks);
+  // With mmap privatization, access the buffers located in the global memory through the private mappings of their
+  // actors, without switching the data segment
+  auto src_actor = comm->src_actor_->get_iface();
+  auto dst_actor = comm->dst_actor_->get_iface();
+  auto* src_buff = static_cast<uint8_t*>(smpi_privatized_address(src_actor, buff, buff_size));
+  auto* dst_buff = static_cast<uint8_t*>(smpi_privatized_address(dst_actor, comm->dst_buff_, buff_size));
+  // The buffers that straddle the data segment are only reachable once the segment of their actor is switched in.
+  // Switch it unconditionally: such a buffer may start before the segment, where the switch would be skipped
+  std::vector<uint8_t> tmpbuff;
+  if (src_buff == nullptr && dst_buff == nullptr) {
+    XBT_DEBUG("Privatization: both buffers straddle the global memory. Copying through a temp buffer");
+    smpi_switch_data_segment(src_actor);
+    tmpbuff.assign(static_cast<uint8_t*>(buff), static_cast<uint8_t*>(buff) + buff_size);
+    src_buff = tmpbuff.data();
+    smpi_switch_data_segment(dst_actor);
+    dst_buff = static_cast<uint8_t*>(comm->dst_buff_);
+  } else if (src_buff == nullptr) {
+    smpi_switch_data_segment(src_actor);
+    src_buff = static_cast<uint8_t*>(buff);
+  } else if (dst_buff == nullptr) {
+    smpi_switch_data_segment(dst_actor);
+    dst_buff = static_cast<uint8_t*>(comm->dst_buff_);
   }
 
-  if (smpi_switch_data_segment(comm->dst_actor_->get_iface(), comm->dst_buff_))
-    XBT_DEBUG("Privatization : We are copying to a zone inside global memory - Switch data segment");
-
-  XBT_DEBUG("Copying %zu bytes from %p to %p", buff_size, tmpbuff, comm->dst_buff_);
-  memcpy_private(comm->dst_buff_, tmpbuff, private_blocks);
+  XBT_DEBUG("Copying %zu bytes from %p to %p", buff_size, src_buff, dst_buff);
+  simgrid::smpi::for_each_private_range(src_blocks, dst_blocks, [=](size_t begin, size_t end) {
+    xbt_assert(begin < end && end <= buff_size, "Oops, bug in shared malloc.");
+    memcpy(dst_buff + begin, src_buff + begin, end - begin);
+  });
 
   smpi_cleanup_comm_after_copy(comm,buff);
-  if (tmpbuff != buff)
-    xbt_free(tmpbuff);
 }
 
 void smpi_comm_null_copy_buffer_callback(simgrid::kernel::activity::CommImpl*, void*, size_t)
@@ -394,6 +386,176 @@ static int visit_libs(struct dl_phdr_info* info, size_t, void* data)
 }
 #endif
 
+#if HAVE_MEMFD_CREATE
+/** The parts of an executable that the dynamic loader needs, read once for all ranks */
+struct SharedTextImage {
+  off_t size = 0;
+  std::vector<ElfW(Phdr)> segments;                    // PT_LOAD entries
+  std::vector<std::pair<off_t, std::string>> contents; // ELF headers and content of each segment
+  int fd = -1;                                         // Memory file holding these contents, cloned for each rank
+};
+
+static const SharedTextImage& smpi_read_shared_text_image(const std::string& executable)
+{
+  static std::unordered_map<std::string, SharedTextImage> images;
+  if (auto known = images.find(executable); known != images.end())
+    return known->second;
+
+  int fd = open(executable.c_str(), O_RDONLY | O_CLOEXEC);
+  xbt_assert(fd >= 0, "Cannot read from %s. Please make sure that the file exists and is executable.",
+             executable.c_str());
+  auto read_at = [fd, &executable](off_t offset, size_t size) {
+    std::string data(size, '\0');
+    for (size_t done = 0; done < size;) {
+      ssize_t got = pread(fd, data.data() + done, size - done, offset + static_cast<off_t>(done));
+      xbt_assert(got > 0 || (got == -1 && errno == EINTR), "Cannot read from %s", executable.c_str());
+      if (got > 0)
+        done += static_cast<size_t>(got);
+    }
+    return data;
+  };
+
+  SharedTextImage image;
+  struct stat st;
+  xbt_assert(fstat(fd, &st) == 0, "Cannot stat %s", executable.c_str());
+  image.size = st.st_size;
+
+  std::string header = read_at(0, sizeof(ElfW(Ehdr)));
+  ElfW(Ehdr) ehdr;
+  memcpy(&ehdr, header.data(), sizeof ehdr);
+  xbt_assert(memcmp(ehdr.e_ident, ELFMAG, SELFMAG) == 0 &&
+                 ehdr.e_ident[EI_CLASS] == (__ELF_NATIVE_CLASS == 64 ? ELFCLASS64 : ELFCLASS32) &&
+                 ehdr.e_phentsize == sizeof(ElfW(Phdr)),
+             "%s is not an ELF file for this architecture: cannot use the memfd privatization.", executable.c_str());
+  size_t headers_size = ehdr.e_phoff + ehdr.e_phnum * sizeof(ElfW(Phdr));
+  image.contents.emplace_back(0, read_at(0, headers_size));
+
+  std::string phdrs = image.contents.back().second.substr(ehdr.e_phoff);
+  for (int i = 0; i < ehdr.e_phnum; i++) {
+    ElfW(Phdr) phdr;
+    memcpy(&phdr, phdrs.data() + i * sizeof(ElfW(Phdr)), sizeof phdr);
+    if (phdr.p_type != PT_LOAD)
+      continue;
+    image.segments.push_back(phdr);
+    image.contents.emplace_back(phdr.p_offset, read_at(phdr.p_offset, phdr.p_filesz));
+  }
+  close(fd);
+  XBT_DEBUG("%s has %zu loadable segments", executable.c_str(), image.segments.size());
+
+  image.fd = memfd_create(simgrid::xbt::Path(executable).get_base_name().c_str(), MFD_CLOEXEC);
+  xbt_assert(image.fd >= 0, "Cannot create a memory file: %s", strerror(errno));
+  xbt_assert(ftruncate(image.fd, image.size) == 0, "Cannot resize the memory file: %s", strerror(errno));
+  for (auto const& [offset, content] : image.contents)
+    xbt_assert(pwrite(image.fd, content.data(), content.size(), offset) == static_cast<ssize_t>(content.size()),
+               "Cannot fill the memory file: %s", strerror(errno));
+  return images.emplace(executable, std::move(image)).first->second;
+}
+
+/** Copies a part of the image into the memory file of a rank, within the kernel when it can */
+static void smpi_clone_shared_text_part(const SharedTextImage& image, int fd, off_t offset, const std::string& content)
+{
+  loff_t from = offset;
+  loff_t to   = offset;
+  for (size_t left = content.size(); left > 0;) {
+    ssize_t done = copy_file_range(image.fd, &from, fd, &to, left, 0);
+    if (done > 0) {
+      left -= static_cast<size_t>(done);
+    } else if (done != -1 || errno != EINTR) { // Not supported by this kernel: write it from memory
+      const char* data = content.data() + (content.size() - left);
+      xbt_assert(pwrite(fd, data, left, to) == static_cast<ssize_t>(left), "Cannot fill the memory file: %s",
+                 strerror(errno));
+      return;
+    }
+  }
+}
+
+/** Loads a private instance of the executable whose read-only segments (code and constants) are shared by all ranks.
+ *
+ * The loadable parts of the executable (but not its debug information) are copied into an anonymous memory file,
+ * which is loaded through a symbolic link that gives it a unique name. The read-only segments of the loaded instance
+ * are then remapped from the original executable, so that they are shared through the page cache. The copy is trimmed
+ * down to the writable segments, so the only private pages of each rank are its data segment, its bss, and the pages
+ * written in copy-on-write.
+ */
+static void* smpi_dlopen_shared_text(const std::string& executable, const std::string& target_executable,
+                                     const std::vector<std::pair<std::string, std::string>>& renamed_libs)
+{
+  const SharedTextImage& image = smpi_read_shared_text_image(executable);
+  const auto page_size         = static_cast<off_t>(xbt_pagesize);
+  auto page_start              = [page_size](off_t offset) { return offset - offset % page_size; };
+  auto page_end                = [page_size](off_t offset) { return (offset + page_size - 1) / page_size * page_size; };
+
+  int fd = memfd_create(simgrid::xbt::Path(executable).get_base_name().c_str(), MFD_CLOEXEC);
+  xbt_assert(fd >= 0, "Cannot create a memory file: %s", strerror(errno));
+  xbt_assert(ftruncate(fd, image.size) == 0, "Cannot resize the memory file: %s", strerror(errno));
+
+  // Clone the image written once for all ranks, and only overwrite the names of the privatized libraries
+  std::vector<std::pair<off_t, off_t>> modified; // Page ranges modified to link to the privatized libraries
+  for (auto const& [offset, content] : image.contents) {
+    smpi_clone_shared_text_part(image, fd, offset, content);
+    for (auto const& [libname, target_libname] : renamed_libs)
+      for (size_t pos = content.find(libname); pos != std::string::npos;
+           pos = content.find(libname, pos + libname.size())) {
+        off_t at = offset + static_cast<off_t>(pos);
+        xbt_assert(pwrite(fd, target_libname.data(), target_libname.size(), at) ==
+                       static_cast<ssize_t>(target_libname.size()),
+                   "Cannot rename %s in the memory file: %s", libname.c_str(), strerror(errno));
+        modified.emplace_back(page_start(at), page_end(at + static_cast<off_t>(libname.size())));
+      }
+  }
+
+  xbt_assert(unlink(target_executable.c_str()) == 0 || errno == ENOENT, "Failed to unlink file %s: %s",
+             target_executable.c_str(), strerror(errno));
+  xbt_assert(symlink(("/proc/self/fd/" + std::to_string(fd)).c_str(), target_executable.c_str()) == 0,
+             "Cannot create the symbolic link %s: %s", target_executable.c_str(), strerror(errno));
+
+  void* handle = dlopen(target_executable.c_str(), RTLD_LAZY | RTLD_LOCAL | WANT_RTLD_DEEPBIND);
+  if (handle == nullptr) {
+    int saved_errno = errno;
+    close(fd);
+    errno = saved_errno;
+    return nullptr;
+  }
+
+  const struct link_map* map = nullptr;
+  xbt_assert(dlinfo(handle, RTLD_DI_LINKMAP, &map) == 0, "dlinfo failed: %s", dlerror());
+  int exe_fd = open(executable.c_str(), O_RDONLY | O_CLOEXEC);
+  xbt_assert(exe_fd >= 0, "Cannot read from %s", executable.c_str());
+
+  std::vector<std::pair<off_t, off_t>> kept; // Page ranges of the memory file that are still mapped
+  for (auto const& segment : image.segments) {
+    off_t start = page_start(segment.p_offset);
+    off_t end   = page_end(segment.p_offset + segment.p_filesz);
+    bool shared = (segment.p_flags & PF_W) == 0 && segment.p_memsz == segment.p_filesz &&
+                  std::none_of(modified.begin(), modified.end(), [start, end](auto const& range) {
+                    return range.first < end && start < range.second;
+                  });
+    if (not shared) {
+      kept.emplace_back(start, end);
+      continue;
+    }
+    auto* addr = reinterpret_cast<void*>(map->l_addr + segment.p_vaddr - segment.p_offset % page_size);
+    int prot   = PROT_READ | ((segment.p_flags & PF_X) ? PROT_EXEC : 0);
+    xbt_assert(mmap(addr, end - start, prot, MAP_PRIVATE | MAP_FIXED, exe_fd, start) == addr,
+               "Cannot share the segment at offset %" PRIdMAX " of %s: %s", static_cast<intmax_t>(start),
+               executable.c_str(), strerror(errno));
+  }
+  close(exe_fd);
+
+  // Release the pages of the memory file that are not mapped anymore (or that were never mapped)
+  std::sort(kept.begin(), kept.end());
+  off_t hole_start = 0;
+  kept.emplace_back(image.size, image.size);
+  for (auto const& [start, end] : kept) {
+    if (start > hole_start && fallocate(fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, hole_start, start - hole_start))
+      XBT_DEBUG("Cannot release the unused pages of the memory file: %s", strerror(errno));
+    hole_start = std::max(hole_start, end);
+  }
+  close(fd);
+  return handle;
+}
+#endif
+
 static void smpi_init_privatization_dlopen(const std::string& executable, bool use_default = true)
 {
   // Prepare the copy of the binary (get its size)
@@ -442,9 +604,9 @@ static void smpi_init_privatization_dlopen(const std::string& executable, bool u
                                           path.get_base_name() + "_" + std::to_string(getpid()) + "_" +
                                           std::to_string(rank) + ".so";
 
-          smpi_copy_file(executable, target_executable, fdin_size);
           // if smpi/privatize-libs is set, duplicate pointed lib and link each executable copy to a different one.
           std::vector<std::string> target_libs;
+          std::vector<std::pair<std::string, std::string>> renamed_libs;
           for (auto const& libpath : privatize_libs_paths) {
             // if we were given a full path, strip it
             size_t index = libpath.find_last_of("/\\");
@@ -468,16 +630,27 @@ static void smpi_init_privatization_dlopen(const std::string& executable, bool u
               XBT_DEBUG("copy lib %s to %s, with size %lld", libpath.c_str(), target_lib.c_str(),
                         (long long)fdin_size2);
               smpi_copy_file(libpath, target_lib, fdin_size2);
+              renamed_libs.emplace_back(libname, target_libname);
+            }
+          }
 
+          rank++;
+          // Load the copy and resolve the entry point:
+          void* handle = nullptr;
+#if HAVE_MEMFD_CREATE
+          if (smpi_cfg_privatization() == SmpiPrivStrategies::MEMFD)
+            handle = smpi_dlopen_shared_text(executable, target_executable, renamed_libs);
+          else
+#endif
+          {
+            smpi_copy_file(executable, target_executable, fdin_size);
+            for (auto const& [libname, target_libname] : renamed_libs) {
               std::string sedcommand = "sed -i -e 's/" + libname + "/" + target_libname + "/g' " + target_executable;
               int status             = system(sedcommand.c_str());
               xbt_assert(status == 0, "error while applying sed command %s \n", sedcommand.c_str());
             }
+            handle = dlopen(target_executable.c_str(), RTLD_LAZY | RTLD_LOCAL | WANT_RTLD_DEEPBIND);
           }
-
-          rank++;
-          // Load the copy and resolve the entry point:
-          void* handle    = dlopen(target_executable.c_str(), RTLD_LAZY | RTLD_LOCAL | WANT_RTLD_DEEPBIND);
           int saved_errno = errno;
           if (not simgrid::config::get_value<bool>("smpi/keep-temps")) {
             unlink(target_executable.c_str());
@@ -557,7 +730,8 @@ int smpi_main(const char* executable, int argc, char* argv[])
   xbt_assert(not MC_is_active() || smpi_cfg_privatization() != SmpiPrivStrategies::MMAP,
              "Please use the dlopen privatization schema when model-checking SMPI code");
 
-  if (smpi_cfg_privatization() == SmpiPrivStrategies::DLOPEN)
+  smpi_bench_register_binary(executable);
+  if (smpi_cfg_privatization() == SmpiPrivStrategies::DLOPEN || smpi_cfg_privatization() == SmpiPrivStrategies::MEMFD)
     smpi_init_privatization_dlopen(executable);
   else
     smpi_init_privatization_no_dlopen(executable);
@@ -696,7 +870,8 @@ void SMPI_executable_init(const std::string& executable)
   xbt_assert(not MC_is_active() || smpi_cfg_privatization() != SmpiPrivStrategies::MMAP,
              "Please use the dlopen privatization schema when model-checking SMPI code");
 
-  if (smpi_cfg_privatization() == SmpiPrivStrategies::DLOPEN)
+  smpi_bench_register_binary(executable);
+  if (smpi_cfg_privatization() == SmpiPrivStrategies::DLOPEN || smpi_cfg_privatization() == SmpiPrivStrategies::MEMFD)
     smpi_init_privatization_dlopen(executable, false);
   else if (smpi_cfg_privatization() == SmpiPrivStrategies::MMAP)
     xbt_die("Privatization with MMAP is not supported");
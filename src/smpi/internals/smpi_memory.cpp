@@ -10,6 +10,7 @@
 #include "src/xbt/memory_map.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cerrno>
 #include <climits>
 #include <cstdint>
@@ -206,6 +207,29 @@ bool smpi_switch_data_segment(simgrid::s4u::ActorPtr actor, const void* addr)
   return true;
 }
 
+/** Get an address at which the given buffer of an actor can be accessed, whatever the data segment currently mapped
+ *
+ *  With mmap privatization, the data segment of each actor is also mapped at a distinct address. The buffers located
+ *  in the data segment are accessed through this mapping, so that copying data between actors does not require to
+ *  switch the data segment (which costs a mmap and page faults on the next accesses). Other buffers are returned
+ *  unchanged. Returns nullptr for the buffers that only partly overlap the data segment: the data segment of the actor
+ *  must then be switched in to access them at their own address.
+ */
+void* smpi_privatized_address(simgrid::s4u::ActorPtr actor, void* addr, size_t size)
+{
+  if (smpi_cfg_privatization() != SmpiPrivStrategies::MMAP || smpi_data_exe_size == 0)
+    return addr;
+
+  auto* start = static_cast<char*>(addr);
+  if (start + size <= smpi_data_exe_start || start >= smpi_data_exe_start + smpi_data_exe_size)
+    return addr; // not in the data segment
+
+  if (start < smpi_data_exe_start || start + size > smpi_data_exe_start + smpi_data_exe_size)
+    return nullptr; // Only partially in the data segment
+  const auto* region = smpi_process_remote(actor)->privatized_region();
+  return static_cast<char*>(region->address) + (start - smpi_data_exe_start);
+}
+
 /**
  * @brief Makes a backup of the segment in memory that stores the global variables of a process.
  *        This backup is then used to initialize the global variables for every single
@@ -301,3 +325,61 @@ void smpi_free_replay_tmp_buffers()
   std::vector<unsigned char>().swap(sendbuffer);
   std::vector<unsigned char>().swap(recvbuffer);
 }
+
+/* Pool of the buffers holding the data of the detached sends until their receiver gets it, sorted in classes of
+ * power-of-two sizes. They are only taken and given back by the maestro (when posting the sends and when copying their
+ * data), so no locking is needed. */
+namespace {
+struct alignas(std::max_align_t) EagerBufferHeader {
+  unsigned size_class;
+};
+constexpr unsigned eager_min_class_log2 = 6;           // 64 bytes
+constexpr unsigned eager_classes        = 11;          // Up to 64 KiB, the larger buffers are not cached
+constexpr size_t eager_cached_bytes     = 1024 * 1024; // Per class
+
+class EagerBufferPool {
+  std::array<std::vector<EagerBufferHeader*>, eager_classes> free_lists_;
+
+public:
+  void* get(size_t size)
+  {
+    unsigned size_class = 0;
+    while (size_class < eager_classes && size > (size_t{1} << (eager_min_class_log2 + size_class)))
+      size_class++;
+    EagerBufferHeader* header;
+    if (size_class < eager_classes && not free_lists_[size_class].empty()) {
+      header = free_lists_[size_class].back();
+      free_lists_[size_class].pop_back();
+    } else {
+      size_t capacity = size_class < eager_classes ? size_t{1} << (eager_min_class_log2 + size_class) : size;
+      header          = static_cast<EagerBufferHeader*>(::operator new(sizeof(EagerBufferHeader) + capacity));
+      header->size_class = size_class;
+    }
+    return header + 1;
+  }
+
+  void release(void* buf)
+  {
+    auto* header        = static_cast<EagerBufferHeader*>(buf) - 1;
+    unsigned size_class = header->size_class;
+    if (size_class < eager_classes &&
+        free_lists_[size_class].size() < (eager_cached_bytes >> (eager_min_class_log2 + size_class)))
+      free_lists_[size_class].push_back(header);
+    else
+      ::operator delete(header);
+  }
+};
+// Never destroyed, as the detached comms still alive at exit give their buffers back after the static destructors
+EagerBufferPool& eager_buffer_pool = *new EagerBufferPool();
+} // namespace
+
+void* smpi_get_eager_buffer(size_t size)
+{
+  return eager_buffer_pool.get(size);
+}
+
+void smpi_free_eager_buffer(void* buf)
+{
+  if (buf != nullptr)
+    eager_buffer_pool.release(buf);
+}
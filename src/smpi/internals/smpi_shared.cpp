@@ -90,6 +90,7 @@ struct shared_metadata_t {
 };
 
 std::map<const void*, shared_metadata_t> allocs_metadata;
+const decltype(allocs_metadata)::value_type* last_lookup = nullptr; // Cache of smpi_shared_private_blocks()
 std::map<std::string, void*, std::less<>> calls;
 
 int smpi_shared_malloc_bogusfile           = -1;
@@ -101,6 +102,7 @@ void smpi_shared_destroy()
 {
   allocs.clear();
   allocs_metadata.clear();
+  last_lookup = nullptr;
   calls.clear();
 }
 
@@ -371,30 +373,34 @@ void* smpi_shared_malloc(size_t size, const char* file, int line)
   return xbt_malloc(size);
 }
 
+const std::vector<std::pair<size_t, size_t>>* smpi_shared_private_blocks(const void* ptr, size_t* offset)
+{
+  if (allocs_metadata.empty() ||
+      (smpi_cfg_shared_malloc() != SharedMallocType::LOCAL && smpi_cfg_shared_malloc() != SharedMallocType::GLOBAL))
+    return nullptr;
+
+  auto contains = [ptr](const decltype(allocs_metadata)::value_type& alloc) {
+    return ptr >= alloc.first && ptr < static_cast<const char*>(alloc.first) + alloc.second.size;
+  };
+  // Consecutive messages often use the same allocation
+  if (last_lookup == nullptr || not contains(*last_lookup)) {
+    auto next = allocs_metadata.upper_bound(ptr);
+    if (next == allocs_metadata.begin() || not contains(*std::prev(next)))
+      return nullptr;
+    last_lookup = &*std::prev(next);
+  }
+  *offset = static_cast<const uint8_t*>(ptr) - static_cast<const uint8_t*>(last_lookup->first);
+  return &last_lookup->second.private_blocks;
+}
+
 int smpi_is_shared(const void* ptr, std::vector<std::pair<size_t, size_t>> &private_blocks, size_t *offset){
-  private_blocks.clear(); // being paranoid
-  if (allocs_metadata.empty())
-    return 0;
-  if (smpi_cfg_shared_malloc() == SharedMallocType::LOCAL || smpi_cfg_shared_malloc() == SharedMallocType::GLOBAL) {
-    auto low = allocs_metadata.lower_bound(ptr);
-    if (low != allocs_metadata.end() && low->first == ptr) {
-      private_blocks = low->second.private_blocks;
-      *offset = 0;
-      return 1;
-    }
-    if (low == allocs_metadata.begin())
-      return 0;
-    low --;
-    if (ptr < (char*)low->first + low->second.size) {
-      xbt_assert(ptr > (char*)low->first, "Oops, there seems to be a bug in the shared memory metadata.");
-      *offset = ((uint8_t*)ptr) - ((uint8_t*) low->first);
-      private_blocks = low->second.private_blocks;
-      return 1;
-    }
-    return 0;
-  } else {
+  const auto* blocks = smpi_shared_private_blocks(ptr, offset);
+  if (blocks == nullptr) {
+    private_blocks.clear();
     return 0;
   }
+  private_blocks = *blocks;
+  return 1;
 }
 
 std::vector<std::pair<size_t, size_t>> shift_and_frame_private_blocks(const std::vector<std::pair<size_t, size_t>>& vec,
@@ -454,6 +460,7 @@ void smpi_shared_free(void *ptr)
     if (data->count <= 0) {
       close(data->fd);
       allocs.erase(allocs.find(meta->second.data->first));
+      last_lookup = nullptr;
       allocs_metadata.erase(meta);
       XBT_DEBUG("Shared free - Local - with removal - of %p", ptr);
     } else {
@@ -468,6 +475,7 @@ void smpi_shared_free(void *ptr)
       munmap(ptr, meta->second.size);
       if(meta->second.data->second.count==0){
         delete meta->second.data;
+        last_lookup = nullptr;
         allocs_metadata.erase(meta);
       }
     }else{
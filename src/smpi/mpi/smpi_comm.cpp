@@ -8,6 +8,7 @@
 #include "smpi_coll.hpp"
 #include "smpi_datatype.hpp"
 #include "smpi_info.hpp"
+#include "smpi_nbc_schedule.hpp"
 #include "smpi_request.hpp"
 #include "smpi_win.hpp"
 #include "src/kernel/resource/HostImpl.hpp"
@@ -68,6 +69,7 @@ void Comm::destroy(Comm* comm)
     comm->cleanup_attr<Comm>();
     comm->mark_as_deleted();
   }
+  NbcSchedule::forget(comm); // The cached requests hold references on the communicator
   Comm::unref(comm);
 }
 
@@ -75,8 +77,10 @@ int Comm::dup(MPI_Comm* newcomm){
   // we need to switch as the called function may silently touch global variables
   smpi_switch_data_segment(s4u::Actor::self());
 
-  auto* cp     = new Group(this->group());
-  (*newcomm)   = new  Comm(cp, this->topo());
+  // Groups are never modified once built, so the new communicator shares it instead of copying O(size) maps per rank
+  MPI_Group cp = this->group();
+  cp->ref();
+  (*newcomm) = new Comm(cp, this->topo());
 
   for (auto const& [key, value] : attributes()) {
     auto elem_it = keyvals_.find(key);
@@ -305,7 +309,8 @@ MPI_Comm Comm::split(int color, int key)
         int reqs              = 0;
         for (auto const& [_, rank] : rankmap) {
           if (rank != 0) {
-            group_snd[reqs]=new  Group(group_out);
+            group_snd[reqs] = group_out; // Shared by all members instead of one O(size) copy each
+            group_out->ref();
             requests[reqs] = Request::isend(&(group_snd[reqs]), 1, MPI_PTR, rank, system_tag, this);
             reqs++;
           }
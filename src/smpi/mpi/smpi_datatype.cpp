@@ -321,16 +321,16 @@ int Datatype::copy(const void* sendbuf, int sendcount, MPI_Datatype sendtype, vo
 
   /* First check if we really have something to do */
   size_t offset = 0;
-  std::vector<std::pair<size_t, size_t>> private_blocks;
-  if(smpi_is_shared(sendbuf,private_blocks,&offset)
-       && (private_blocks.size()==1
-       && (private_blocks[0].second - private_blocks[0].first)==(unsigned long)(sendcount * sendtype->get_extent()))){
+  auto is_shared = [&offset](const void* buf, size_t size) {
+    const auto* private_blocks = smpi_shared_private_blocks(buf, &offset);
+    return private_blocks != nullptr && private_blocks->size() == 1 &&
+           ((*private_blocks)[0].second - (*private_blocks)[0].first) == size;
+  };
+  if (is_shared(sendbuf, sendcount * sendtype->get_extent())) {
     XBT_VERB("sendbuf is shared. Ignoring copies");
     return 0;
   }
-  if(smpi_is_shared(recvbuf,private_blocks,&offset)
-       && (private_blocks.size()==1
-       && (private_blocks[0].second - private_blocks[0].first)==(unsigned long)(recvcount * recvtype->get_extent()))){
+  if (is_shared(recvbuf, recvcount * recvtype->get_extent())) {
     XBT_VERB("recvbuf is shared. Ignoring copies");
     return 0;
   }
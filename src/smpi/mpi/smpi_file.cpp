@@ -17,6 +17,8 @@
 #include "simgrid/s4u/Host.hpp"
 #include "simgrid/plugins/file_system.h"
 
+#include <array>
+#include <charconv>
 #include <mutex> // std::scoped_lock
 
 #define FP_SIZE sizeof(MPI_Offset)
@@ -274,6 +276,219 @@ int File::write_ordered(MPI_File fh, const void* buf, int count, const Datatype*
   return ret;
 }
 
+/* Read_all, Write_all: two-phase I/O, loosely based on */
+/* @article{Thakur:1996:ETM:245875.245879,*/
+/* author = {Thakur, Rajeev and Choudhary, Alok},*/
+/* title = {An Extended Two-phase Method for Accessing Sections of Out-of-core Arrays},*/
+/* journal = {Sci. Program.},*/
+/* issue_date = {Winter 1996},*/
+/* pages = {301--317},*/
+/* }*/
+/* and on the collective buffering of ROMIO, whose hints are honored: romio_cb_read and romio_cb_write ("enable",
+ * "disable" or "automatic"), cb_nodes and cb_buffer_size.
+ *
+ * The ranks accessing the same storage node (the host of the disk holding their file) work together. One aggregator
+ * is picked per compute host, the ones running on the storage node first, and the file range accessed on this storage
+ * node is split evenly between them. Each aggregator then handles its part in rounds of cb_buffer_size bytes: the
+ * other ranks send it their data for this part before it writes, or receive it after it reads, and it accesses the
+ * disk with a single contiguous operation. */
+namespace {
+struct Access {
+  MPI_Offset start;
+  MPI_Offset end;
+  MPI_Offset bytes;   // Less than end - start if the datatype has holes
+  MPI_Offset storage; // Host of the disk, the ranks share their address space
+};
+
+/* Amount of data of the given access within [lo, hi) */
+MPI_Offset data_in(const Access& access, MPI_Offset lo, MPI_Offset hi)
+{
+  MPI_Offset overlap = std::min(access.end, hi) - std::max(access.start, lo);
+  if (overlap <= 0)
+    return 0;
+  return overlap * access.bytes / (access.end - access.start);
+}
+
+std::string get_hint(const Info* info, const char* key, const char* default_value)
+{
+  std::array<char, MPI_MAX_INFO_VAL + 1> value{};
+  int flag = 0;
+  if (info != MPI_INFO_NULL)
+    info->get(key, MPI_MAX_INFO_VAL, value.data(), &flag);
+  return flag ? value.data() : default_value;
+}
+
+/* Numerical hints that cannot be parsed are ignored, as ROMIO does */
+long long get_hint(const Info* info, const char* key, long long default_value)
+{
+  std::string value = get_hint(info, key, "");
+  long long res;
+  if (auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), res);
+      ec != std::errc() || end != value.data() + value.size())
+    return default_value;
+  return res;
+}
+} // namespace
+
+int File::collective_io(int (*op)(MPI_File, void*, int, const Datatype*, MPI_Status*), void* buf, int count,
+                        const Datatype* datatype, MPI_Status* status)
+{
+  const bool is_write = (op == &File::write);
+  int size            = comm_->size();
+  int rank            = comm_->rank();
+  // The files that are not on a disk of a host are aggregated together, with no preference for local accesses
+  const s4u::Disk* disk         = file_->get_disk();
+  const s4u::Host* storage_host = disk != nullptr ? disk->get_host() : nullptr;
+  auto position = static_cast<MPI_Offset>(file_->tell());
+  Access mine{position, position + count * datatype->get_extent(), static_cast<MPI_Offset>(count * datatype->size()),
+              static_cast<MPI_Offset>(reinterpret_cast<intptr_t>(storage_host))};
+  std::vector<Access> accesses(size);
+  static_assert(sizeof(Access) == 4 * sizeof(MPI_Offset));
+  simgrid::smpi::colls::allgather(&mine, 4, MPI_OFFSET, accesses.data(), 4, MPI_OFFSET, comm_);
+
+  // The ranks on my storage node, and whether their accesses are interleaved
+  std::vector<int> group;
+  std::vector<std::pair<MPI_Offset, MPI_Offset>> ranges;
+  bool dense = true;
+  for (int i = 0; i < size; i++) {
+    if (accesses[i].storage != mine.storage)
+      continue;
+    group.push_back(i);
+    if (accesses[i].bytes > 0) {
+      ranges.emplace_back(accesses[i].start, accesses[i].end);
+      dense = dense && accesses[i].bytes == accesses[i].end - accesses[i].start;
+    }
+  }
+  std::sort(ranges.begin(), ranges.end());
+  for (unsigned i = 1; i < ranges.size(); i++)
+    dense = dense && ranges[i].first >= ranges[i - 1].second;
+
+  XBT_DEBUG("my offsets to access : %lld:%lld, %zu accesses on my storage node %s", mine.start, mine.end,
+            ranges.size(), storage_host != nullptr ? storage_host->get_cname() : "(none)");
+  if (status != MPI_STATUS_IGNORE)
+    status->count = count * datatype->size();
+  if (ranges.empty())
+    return MPI_SUCCESS;
+
+  std::string mode = get_hint(info_, is_write ? "romio_cb_write" : "romio_cb_read", "automatic");
+  if (mode == "disable" || (mode != "enable" && (group.size() == 1 || dense))) {
+    // Each rank accesses its own contiguous part of the file, just have each proc perform its access
+    int ret = op(this, buf, count, datatype, status);
+    seek(mine.end, MPI_SEEK_SET);
+    return ret;
+  }
+
+  // Pick one aggregator per compute host, starting with the ones that can access the disk locally
+  std::vector<std::pair<const s4u::Host*, int>> candidates;
+  for (int i : group) {
+    const s4u::Host* host = s4u::Actor::by_pid(comm_->group()->actor(i))->get_host();
+    if (std::none_of(candidates.begin(), candidates.end(), [host](auto const& c) { return c.first == host; }))
+      candidates.emplace_back(host, i);
+  }
+  std::stable_partition(candidates.begin(), candidates.end(),
+                        [storage_host](auto const& c) { return c.first == storage_host; });
+  std::vector<int> aggregators;
+  for (auto const& [host, i] : candidates)
+    aggregators.push_back(i);
+  if (long long cb_nodes = get_hint(info_, "cb_nodes", 0LL);
+      cb_nodes > 0 && aggregators.size() > static_cast<size_t>(cb_nodes))
+    aggregators.resize(cb_nodes);
+  MPI_Offset buffer_size = std::max<MPI_Offset>(1, get_hint(info_, "cb_buffer_size", 16777216LL));
+
+  // Split the accessed range between the aggregators
+  MPI_Offset min = ranges.front().first;
+  MPI_Offset max = std::max_element(ranges.begin(), ranges.end(), [](auto const& a, auto const& b) {
+                     return a.second < b.second;
+                   })->second;
+  auto nb_aggregators = static_cast<MPI_Offset>(aggregators.size());
+  MPI_Offset domain_size = (max - min + nb_aggregators - 1) / nb_aggregators;
+  MPI_Offset nb_rounds   = (domain_size + buffer_size - 1) / buffer_size;
+  auto me                = std::find(aggregators.begin(), aggregators.end(), rank);
+  XBT_DEBUG("%zu aggregators for %lld:%lld, %lld rounds", aggregators.size(), min, max, nb_rounds);
+
+  for (MPI_Offset round = 0; round < nb_rounds; round++) {
+    // The part of the file handled by each aggregator in this round
+    std::vector<std::pair<MPI_Offset, MPI_Offset>> windows;
+    for (MPI_Offset a = 0; a < nb_aggregators; a++) {
+      MPI_Offset lo = std::min(max, min + a * domain_size + round * buffer_size);
+      windows.emplace_back(lo, std::min({max, min + (a + 1) * domain_size, lo + buffer_size}));
+    }
+
+    // What I exchange with the aggregators, and what they exchange with me if I'm one of them
+    std::vector<std::pair<int, int>> mine_to_aggregators;
+    for (size_t a = 0; a < aggregators.size(); a++)
+      if (MPI_Offset c = data_in(mine, windows[a].first, windows[a].second); c > 0 && aggregators[a] != rank)
+        mine_to_aggregators.emplace_back(aggregators[a], static_cast<int>(c));
+    std::vector<std::pair<int, int>> others_to_me;
+    MPI_Offset first = max;
+    MPI_Offset last  = min;
+    MPI_Offset covered = 0;
+    if (me != aggregators.end()) {
+      auto [lo, hi] = windows[me - aggregators.begin()];
+      for (int i : group) {
+        if (MPI_Offset c = data_in(accesses[i], lo, hi); c > 0) {
+          if (i != rank)
+            others_to_me.emplace_back(i, static_cast<int>(c));
+          first = std::min(first, std::max(accesses[i].start, lo));
+          last  = std::max(last, std::min(accesses[i].end, hi));
+        }
+      }
+      MPI_Offset position = first;
+      for (auto const& [start, end] : ranges) { // Sorted by start, and may overlap
+        MPI_Offset from = std::max(start, position);
+        MPI_Offset to   = std::min(end, last);
+        if (to > from) {
+          covered += to - from;
+          position = to;
+        }
+      }
+    }
+
+    auto disk_access = [this, is_write, &first, &last, &covered]() {
+      if (last <= first)
+        return;
+      seek(first, MPI_SEEK_SET);
+      // Read the holes too with a single access, and write them back if needed (data sieving)
+      if (not is_write || covered < last - first) {
+        sg_size_t read = file_->read(last - first);
+        XBT_VERB("Aggregated read in MPI_File %s, %llu bytes read at offset %lld", file_->get_path(), read, first);
+        seek(first, MPI_SEEK_SET);
+      }
+      if (is_write) {
+        sg_size_t written = file_->write(last - first, true);
+        XBT_VERB("Aggregated write in MPI_File %s, %llu bytes written at offset %lld", file_->get_path(), written,
+                 first);
+      }
+    };
+
+    if (not is_write)
+      disk_access();
+    size_t send_size = 0;
+    size_t recv_size = 0;
+    for (auto const& [peer, c] : is_write ? mine_to_aggregators : others_to_me)
+      send_size = std::max<size_t>(send_size, c);
+    for (auto const& [peer, c] : is_write ? others_to_me : mine_to_aggregators)
+      recv_size += c;
+    unsigned char* sendbuf = smpi_get_tmp_sendbuffer(send_size);
+    unsigned char* recvbuf = smpi_get_tmp_recvbuffer(recv_size);
+    std::vector<MPI_Request> requests;
+    size_t offset = 0;
+    for (auto const& [peer, c] : is_write ? others_to_me : mine_to_aggregators) {
+      requests.push_back(Request::irecv(recvbuf + offset, c, MPI_BYTE, peer, COLL_TAG_FILE, comm_));
+      offset += c;
+    }
+    for (auto const& [peer, c] : is_write ? mine_to_aggregators : others_to_me)
+      requests.push_back(Request::isend(sendbuf, c, MPI_BYTE, peer, COLL_TAG_FILE, comm_));
+    Request::waitall(static_cast<int>(requests.size()), requests.data(), MPI_STATUSES_IGNORE);
+    smpi_free_tmp_buffer(sendbuf);
+    smpi_free_tmp_buffer(recvbuf);
+    if (is_write)
+      disk_access();
+  }
+  seek(mine.end, MPI_SEEK_SET);
+  return MPI_SUCCESS;
+}
+
 int File::set_view(MPI_Offset disp, MPI_Datatype etype, MPI_Datatype filetype, const char* datarep, const Info*)
 {
   etype_    = etype;
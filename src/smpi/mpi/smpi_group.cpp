@@ -6,6 +6,9 @@
 #include "simgrid/s4u/Actor.hpp"
 #include "smpi_group.hpp"
 #include "smpi_comm.hpp"
+
+#include <algorithm>
+#include <limits>
 #include <string>
 
 simgrid::smpi::Group smpi_MPI_GROUP_EMPTY;
@@ -15,30 +18,110 @@ namespace simgrid::smpi {
 Group::Group(const Group* origin)
 {
   if (origin != MPI_GROUP_NULL && origin != MPI_GROUP_EMPTY) {
-    rank_to_pid_map_ = origin->rank_to_pid_map_;
-    pid_to_rank_map_ = origin->pid_to_rank_map_;
+    rank_to_pid_map_    = origin->rank_to_pid_map_;
+    index_              = origin->index_;
+    first_pid_          = origin->first_pid_;
+    pid_to_rank_map_    = origin->pid_to_rank_map_;
+    pid_to_rank_sparse_ = origin->pid_to_rank_sparse_;
   }
 }
 
+/* Rebuilds the reverse map from rank_to_pid_map_, leaving room down to min_pid and up to max_pid when it can stay dense
+ * with it, so that the next mappings do not rebuild it again. */
+void Group::build_index(aid_t min_pid, aid_t max_pid)
+{
+  aid_t lo = std::numeric_limits<aid_t>::max();
+  aid_t hi = -1;
+  for (aid_t pid : rank_to_pid_map_)
+    if (pid >= 0) {
+      lo = std::min(lo, pid);
+      hi = std::max(hi, pid);
+    }
+  pid_to_rank_map_.clear();
+  pid_to_rank_sparse_.clear();
+
+  if (const aid_t max_span = 2 * static_cast<aid_t>(size()) + 64; hi - lo + 1 > max_span) {
+    index_ = Index::SPARSE;
+    pid_to_rank_map_.shrink_to_fit();
+    pid_to_rank_sparse_.reserve(rank_to_pid_map_.size());
+    for (int rank = 0; rank < size(); rank++)
+      if (rank_to_pid_map_[rank] >= 0)
+        pid_to_rank_sparse_[rank_to_pid_map_[rank]] = rank;
+    return;
+  } else if (std::max(hi, max_pid) - std::min(lo, std::max<aid_t>(min_pid, 0)) + 1 <= max_span) {
+    lo = std::min(lo, std::max<aid_t>(min_pid, 0));
+    hi = std::max(hi, max_pid);
+  }
+
+  index_     = Index::DENSE;
+  first_pid_ = lo;
+  pid_to_rank_map_.assign(hi - lo + 1, MPI_UNDEFINED);
+  for (int rank = 0; rank < size(); rank++)
+    if (rank_to_pid_map_[rank] >= 0)
+      pid_to_rank_map_[rank_to_pid_map_[rank] - first_pid_] = rank;
+}
+
 void Group::set_mapping(aid_t pid, int rank)
 {
-  if (0 <= rank && rank < size()) {
-    if (static_cast<size_t>(pid) >= pid_to_rank_map_.size())
-      pid_to_rank_map_.resize(pid + 1, MPI_UNDEFINED);
-    rank_to_pid_map_[rank] = pid;
-    pid_to_rank_map_[pid]  = rank;
+  if (rank < 0 || rank >= size())
+    return;
+
+  aid_t previous         = rank_to_pid_map_[rank];
+  rank_to_pid_map_[rank] = pid;
+  switch (index_) {
+    case Index::EMPTY:
+      index_     = Index::IDENTITY;
+      first_pid_ = pid - rank;
+      break;
+    case Index::IDENTITY:
+      if (pid != first_pid_ + rank)
+        build_index(pid, pid);
+      break;
+    case Index::DENSE: {
+      auto span = static_cast<aid_t>(pid_to_rank_map_.size());
+      if (previous >= first_pid_ && previous - first_pid_ < span && pid_to_rank_map_[previous - first_pid_] == rank)
+        pid_to_rank_map_[previous - first_pid_] = MPI_UNDEFINED;
+      if (pid >= first_pid_ && pid - first_pid_ < span)
+        pid_to_rank_map_[pid - first_pid_] = rank;
+      else // Grow geometrically, as the next pids are likely to be on the same side
+        build_index(std::min(pid, first_pid_ - span), std::max(pid, first_pid_ + 2 * span - 1));
+      break;
+    }
+    case Index::SPARSE:
+      if (auto it = pid_to_rank_sparse_.find(previous); it != pid_to_rank_sparse_.end() && it->second == rank)
+        pid_to_rank_sparse_.erase(it);
+      pid_to_rank_sparse_[pid] = rank;
+      break;
+  }
+}
+
+int Group::lookup(aid_t pid) const
+{
+  switch (index_) {
+    case Index::IDENTITY: {
+      aid_t rank = pid - first_pid_;
+      return (0 <= rank && rank < size() && rank_to_pid_map_[rank] == pid) ? static_cast<int>(rank) : MPI_UNDEFINED;
+    }
+    case Index::DENSE:
+      return (pid >= first_pid_ && pid - first_pid_ < static_cast<aid_t>(pid_to_rank_map_.size()))
+                 ? pid_to_rank_map_[pid - first_pid_]
+                 : MPI_UNDEFINED;
+    case Index::SPARSE: {
+      auto it = pid_to_rank_sparse_.find(pid);
+      return it == pid_to_rank_sparse_.end() ? MPI_UNDEFINED : it->second;
+    }
+    default:
+      return MPI_UNDEFINED;
   }
 }
 
 int Group::rank(aid_t pid) const
 {
-  int res = static_cast<size_t>(pid) < pid_to_rank_map_.size() ? pid_to_rank_map_[pid] : MPI_UNDEFINED;
+  int res = lookup(pid);
   if (res == MPI_UNDEFINED) {
     // I'm not in the communicator ... but maybe my parent is?
-    if (auto parent = s4u::Actor::by_pid(pid)) {
-      aid_t ppid = parent->get_ppid();
-      res        = static_cast<size_t>(ppid) < pid_to_rank_map_.size() ? pid_to_rank_map_[ppid] : MPI_UNDEFINED;
-    }
+    if (auto parent = s4u::Actor::by_pid(pid))
+      res = lookup(parent->get_ppid());
   }
   return res;
 }
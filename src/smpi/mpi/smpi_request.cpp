@@ -14,6 +14,7 @@
 #include "smpi_comm.hpp"
 #include "smpi_datatype.hpp"
 #include "smpi_host.hpp"
+#include "smpi_nbc_schedule.hpp"
 #include "smpi_op.hpp"
 #include "src/kernel/EngineImpl.hpp"
 #include "src/kernel/activity/CommImpl.hpp"
@@ -467,6 +468,13 @@ void Request::start()
 {
   s4u::Mailbox* mailbox;
 
+  if ((flags_ & MPI_REQ_NBC) != 0) { // Persistent collective
+    xbt_assert(nbc_schedule_ != nullptr, "Cannot (re-)start this nonblocking collective");
+    flags_ &= ~(MPI_REQ_PREPARED | MPI_REQ_FINISHED);
+    this->ref();
+    start_nbc_schedule(nbc_schedule_);
+    return;
+  }
   xbt_assert(action_ == nullptr, "Cannot (re-)start unfinished communication");
   //reinitialize temporary buffer for persistent requests
   if(real_size_ > 0 && flags_ & MPI_REQ_FINISHED){
@@ -554,25 +562,16 @@ void Request::start()
     message_id_.push_back(comm_->get_sent_messages_count(comm_->group()->rank(src_), comm_->group()->rank(dst_), tag_));
     comm_->increment_sent_messages_count(comm_->group()->rank(src_), comm_->group()->rank(dst_), tag_);
 
-    void* buf = buf_;
+    bool copy_on_post = false;
     if ((flags_ & MPI_REQ_SSEND) == 0 && ((flags_ & MPI_REQ_RMA) != 0 || (flags_ & MPI_REQ_BSEND) != 0 ||
                                           static_cast<int>(size_) < smpi_cfg_detached_send_thresh())) {
       detached_    = true;
       XBT_DEBUG("Send request %p is detached", this);
       this->ref();
-      if (not(type_->flags() & DT_FLAG_DERIVED)) {
-        void* oldbuf = buf_;
-        if (not process->replaying() && oldbuf != nullptr && size_ != 0) {
-          if (smpi_switch_data_segment(simgrid::s4u::Actor::by_pid(src_), buf_))
-            XBT_DEBUG("Privatization : We are sending from a zone inside global memory. Switch data segment ");
-
-          //we need this temporary buffer even for bsend, as it will be released in the copy callback and we don't have a way to differentiate it
-          //so actually ... don't use manually attached buffer space.
-          buf = xbt_malloc(size_);
-          memcpy(buf,oldbuf,size_);
-          XBT_DEBUG("buf %p copied into %p",oldbuf,buf);
-        }
-      }
+      // The data of derived datatypes was already serialized in a temporary buffer. The other ones are copied when
+      // posting the send, so that the application can reuse its buffer. This also covers bsend: the manually attached
+      // buffer space is not used.
+      copy_on_post = not(type_->flags() & DT_FLAG_DERIVED) && not process->replaying() && buf_ != nullptr && size_ != 0;
     }
 
     //if we are giving back the control to the user without waiting for completion, we have to inject timings
@@ -632,14 +631,42 @@ void Request::start()
     size_t payload_size_ = size_ + 16;//MPI enveloppe size (tag+dest+communicator)
     kernel::actor::CommIsendSimcall observer{
         simgrid::kernel::EngineImpl::get_instance()->get_actor_by_pid(src_), mailbox->get_impl(),
-        static_cast<double>(payload_size_), -1, static_cast<unsigned char*>(buf), real_size_, &match_send,
+        static_cast<double>(payload_size_), -1, static_cast<unsigned char*>(buf_), real_size_, &match_send,
         &xbt_free_f, // how to free the userdata if a detached send fails
         process->replaying() ? &smpi_comm_null_copy_buffer_callback : smpi_comm_copy_data_callback, this,
         // detach if msg size < eager/rdv switch limit
         detached_, process->call_location()->get_call_location()};
     observer.set_tag(tag_);
-    action_ = kernel::actor::simcall_answered([&observer] { return kernel::activity::CommImpl::isend(&observer); },
-                                              &observer);
+    // The RMA and model-checked sends keep their data in flight until the end of the transfer
+    bool zero_copy = copy_on_post && (flags_ & MPI_REQ_RMA) == 0 && not MC_is_active() && not MC_record_replay_is_active();
+    action_ = kernel::actor::simcall_answered(
+        [this, &observer, copy_on_post, zero_copy] {
+          auto comm = kernel::activity::CommImpl::isend(&observer);
+          if (copy_on_post) {
+            kernel::activity::CommImpl* detached_comm = observer.get_comm();
+            if (zero_copy && detached_comm->dst_buff_ != nullptr) {
+              // The receive is already posted: copy straight into its buffer, and leave the application's one alone
+              XBT_DEBUG("Receiver already there, copying the data of %p right now", this);
+              detached_comm->clean_fun = [](void*) { /* Nothing to free */ };
+              detached_comm->copy_data();
+            } else {
+              auto* copy          = static_cast<unsigned char*>(smpi_get_eager_buffer(size_));
+              auto src_actor      = s4u::Actor::by_pid(src_);
+              const void* src_buf = smpi_privatized_address(src_actor, buf_, size_);
+              if (src_buf == nullptr) {
+                // The buffer straddles the data segment: it is only reachable once the segment of the sender is in
+                smpi_switch_data_segment(src_actor);
+                src_buf = buf_;
+              }
+              memcpy(copy, src_buf, size_);
+              XBT_DEBUG("buf %p copied into %p", buf_, copy);
+              detached_comm->set_src_buff(copy, size_);
+              detached_comm->clean_fun = &smpi_free_eager_buffer;
+            }
+          }
+          return comm;
+        },
+        &observer);
     XBT_DEBUG("send simcall posted");
 
     /* FIXME: detached sends are not traceable (action_ == nullptr) */
@@ -954,6 +981,8 @@ int Request::finish_nbc_requests(MPI_Request* request, int test){
     xbt_die("Failure when waiting on non blocking collective sub-requests");
   if(flag == 1){
     XBT_DEBUG("Finishing non blocking collective request with %zu sub-requests", (*request)->nbc_requests_.size());
+    // The requests and buffers of a schedule are kept for its next start
+    bool scheduled = (*request)->nbc_schedule_ != nullptr;
     for(auto& req: (*request)->nbc_requests_){
       if((*request)->buf_!=nullptr && req!=MPI_REQUEST_NULL){//reduce case
         void * buf=req->buf_;
@@ -964,13 +993,16 @@ int Request::finish_nbc_requests(MPI_Request* request, int test){
             int count=(*request)->size_/ (*request)->type_->size();
             (*request)->op_->apply(buf, (*request)->buf_, &count, (*request)->type_);
           }
-          smpi_free_tmp_buffer(static_cast<unsigned char*>(buf));
+          if (not scheduled)
+            smpi_free_tmp_buffer(static_cast<unsigned char*>(buf));
         }
       }
-      if(req!=MPI_REQUEST_NULL)
+      if (req != MPI_REQUEST_NULL && not scheduled)
         Request::unref(&req);
     }
     (*request)->nbc_requests_.clear();
+    if (scheduled)
+      (*request)->nbc_schedule_->complete();
   }
   return flag;
 }
@@ -1365,6 +1397,20 @@ void Request::start_nbc_requests(std::vector<MPI_Request> reqs){
   }
 }
 
+void Request::start_nbc_schedule(std::shared_ptr<NbcSchedule> schedule)
+{
+  nbc_schedule_ = std::move(schedule);
+  nbc_requests_ = nbc_schedule_->requests();
+  nbc_schedule_->start();
+}
+
+/* For the persistent collectives: the schedule is started by each call to start() */
+void Request::prepare_nbc_schedule(std::shared_ptr<NbcSchedule> schedule)
+{
+  nbc_schedule_ = std::move(schedule);
+  flags_ |= MPI_REQ_PREPARED;
+}
+
 std::vector<MPI_Request> Request::get_nbc_requests() const
 {
   return nbc_requests_;
@@ -12,11 +12,14 @@
 #include "smpi_datatype.hpp"
 #include "smpi_info.hpp"
 #include "smpi_keyvals.hpp"
+#include "smpi_op.hpp"
 #include "smpi_request.hpp"
 #include "src/smpi/include/smpi_actor.hpp"
 #include "src/mc/mc_replay.hpp"
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <mutex> // std::scoped_lock
 
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(smpi_rma, smpi, "Logging specific to SMPI (RMA operations)");
@@ -52,8 +55,14 @@ Win::Win(void* base, MPI_Aint size, int disp_unit, MPI_Info info, MPI_Comm comm,
     , dynamic_(dynamic)
 {
   XBT_DEBUG("Creating window");
-  if(info!=MPI_INFO_NULL)
+  if(info!=MPI_INFO_NULL) {
     info->ref();
+    std::array<char, 8> value{};
+    int flag = 0;
+    info->get("smpi_batch_rma", static_cast<int>(value.size()) - 1, value.data(), &flag);
+    // The model checker needs to see each transfer
+    batched_ = flag && strcmp(value.data(), "true") == 0 && not MC_is_active() && not MC_record_replay_is_active();
+  }
   connected_wins_[rank_] = this;
   errhandler_->ref();
   comm->add_rma_win(this);
@@ -226,6 +235,15 @@ int Win::put(const void *origin_addr, int origin_count, MPI_Datatype origin_data
 
   void* recv_addr = static_cast<char*>(recv_win->base_) + target_disp * recv_win->disp_unit_;
 
+  if (batched_ && target_rank != rank_) {
+    if (request == nullptr) {
+      batch_op(target_rank, origin_addr, origin_count, origin_datatype, recv_addr, target_count, target_datatype,
+               MPI_REPLACE);
+      return MPI_SUCCESS;
+    }
+    flush_batches(target_rank); // Keep the order with the operations already queued
+  }
+
   if (target_rank != rank_) { // This is not for myself, so we need to send messages
     XBT_DEBUG("Entering MPI_Put to remote rank %d", target_rank);
     // prepare send_request
@@ -273,6 +291,15 @@ int Win::get( void *origin_addr, int origin_count, MPI_Datatype origin_datatype,
   const void* send_addr = static_cast<void*>(static_cast<char*>(send_win->base_) + target_disp * send_win->disp_unit_);
   XBT_DEBUG("Entering MPI_Get from %d", target_rank);
 
+  if (batched_ && target_rank != rank_) {
+    if (request == nullptr) {
+      batch_op(target_rank, origin_addr, origin_count, origin_datatype, const_cast<void*>(send_addr), target_count,
+               target_datatype, MPI_OP_NULL);
+      return MPI_SUCCESS;
+    }
+    flush_batches(target_rank);
+  }
+
   if (target_rank != rank_) {
     //prepare send_request
     MPI_Request sreq = Request::rma_send_init(send_addr, target_count, target_datatype, target_rank, rank_,
@@ -319,6 +346,15 @@ int Win::accumulate(const void *origin_addr, int origin_count, MPI_Datatype orig
 
   void* recv_addr = static_cast<char*>(recv_win->base_) + target_disp * recv_win->disp_unit_;
   XBT_DEBUG("Entering MPI_Accumulate to %d", target_rank);
+  if (batched_) {
+    if (request == nullptr) { // The queue keeps the accumulates in order, without flushing each of them
+      batch_op(target_rank, origin_addr, origin_count, origin_datatype, recv_addr, target_count, target_datatype, op);
+      if (target_rank == rank_)
+        flush_batches(rank_);
+      return MPI_SUCCESS;
+    }
+    flush_batches(target_rank);
+  }
   // As the tag will be used for ordering of the operations, subtract count from it (to avoid collisions with other
   // SMPI tags, SMPI_RMA_TAG is set below all the other ones we use)
   // prepare send_request
@@ -396,8 +432,10 @@ int Win::compare_and_swap(const void* origin_addr, const void* compare_addr, voi
   if (req != MPI_REQUEST_NULL)
     Request::wait(&req, MPI_STATUS_IGNORE);
   if (not memcmp(result_addr, compare_addr, datatype->get_extent())) {
-    put(origin_addr, 1, datatype, target_rank,
-              target_disp, 1, datatype);
+    // A batched put would only be visible at the next synchronization, letting another swap succeed meanwhile
+    put(origin_addr, 1, datatype, target_rank, target_disp, 1, datatype, batched_ ? &req : nullptr);
+    if (req != MPI_REQUEST_NULL)
+      Request::wait(&req, MPI_STATUS_IGNORE);
   }
   return MPI_SUCCESS;
 }
@@ -468,6 +506,7 @@ int Win::complete(){
   xbt_assert(opened_ != 0, "Complete called on already opened MPI_Win");
 
   XBT_DEBUG("Entering MPI_Win_Complete");
+  flush_batches(MPI_ANY_SOURCE); // The targets may access their window as soon as they get the sync messages
   std::vector<MPI_Request> reqs;
   for (int i = 0; i < dst_group_->size(); i++) {
     int dst = comm_->group()->rank(dst_group_->actor(i));
@@ -547,6 +586,7 @@ int Win::lock_all(int assert){
 }
 
 int Win::unlock(int rank){
+  flush_batches(rank); // Before releasing the lock
   MPI_Win target_win = connected_wins_[rank];
   int target_mode = target_win->mode_;
   target_win->mode_= 0;
@@ -560,6 +600,7 @@ int Win::unlock(int rank){
 }
 
 int Win::unlock_all(){
+  flush_batches(MPI_ANY_SOURCE); // All targets at once
   int retval = MPI_SUCCESS;
   for (int i = 0; i < comm_->size(); i++) {
     int ret = this->unlock(i);
@@ -570,6 +611,7 @@ int Win::unlock_all(){
 }
 
 int Win::flush(int rank){
+  flush_batches(rank);
   int finished = finish_comms(rank);
   XBT_DEBUG("Win_flush on local %d for remote %d - Finished %d RMA calls", rank_, rank, finished);
   if (rank != rank_) {
@@ -580,12 +622,14 @@ int Win::flush(int rank){
 }
 
 int Win::flush_local(int rank){
+  flush_batches(rank);
   int finished = finish_comms(rank);
   XBT_DEBUG("Win_flush_local on local %d for remote %d - Finished %d RMA calls", rank_, rank, finished);
   return MPI_SUCCESS;
 }
 
 int Win::flush_all(){
+  flush_batches(MPI_ANY_SOURCE);
   int finished = finish_comms();
   XBT_DEBUG("Win_flush_all on local %d - Finished %d RMA calls", rank_, finished);
   for (int i = 0; i < comm_->size(); i++) {
@@ -598,11 +642,104 @@ int Win::flush_all(){
 }
 
 int Win::flush_local_all(){
+  flush_batches(MPI_ANY_SOURCE);
   int finished = finish_comms();
   XBT_DEBUG("Win_flush_local_all on local %d - Finished %d RMA calls", rank_, finished);
   return MPI_SUCCESS;
 }
 
+void Win::batch_op(int target_rank, const void* origin_addr, int origin_count, MPI_Datatype origin_datatype,
+                   void* target_addr, int target_count, MPI_Datatype target_datatype, MPI_Op op)
+{
+  Batch& batch = batches_[target_rank];
+  size_t origin_size = static_cast<size_t>(origin_count) * origin_datatype->size();
+  size_t target_size = static_cast<size_t>(target_count) * target_datatype->size();
+  BatchedOp& batched = batch.ops.emplace_back(BatchedOp{nullptr, origin_count, origin_datatype, target_addr, target_count,
+                                                        target_datatype, op, batch.payload.size(),
+                                                        std::min(origin_size, target_size)});
+  target_datatype->ref();
+  if (op == MPI_OP_NULL) { // Get: the origin buffer is written at the synchronization
+    batched.origin_addr = const_cast<void*>(origin_addr);
+    origin_datatype->ref();
+    batch.get_size += batched.size;
+  } else { // Put or accumulate: the origin buffer can be reused as soon as its data is packed
+    op->ref();
+    smpi_switch_data_segment(s4u::Actor::self());
+    batch.payload.resize(batch.payload.size() + origin_size);
+    if (origin_size > 0)
+      origin_datatype->serialize(origin_addr, batch.payload.data() + batched.offset, origin_count);
+  }
+  XBT_DEBUG("Queued RMA operation %zu for %d (%zu bytes)", batch.ops.size(), target_rank, batched.size);
+}
+
+int Win::flush_batches(int rank)
+{
+  std::vector<std::pair<int, Batch*>> pending;
+  for (auto& [target, batch] : batches_)
+    if ((rank == MPI_ANY_SOURCE || rank == target) && not batch.ops.empty())
+      pending.emplace_back(target, &batch);
+  if (pending.empty())
+    return 0;
+
+  /* Simulate the transfers of all targets at once, then apply the operations in the order of their calls */
+  s4u::Host* local_host = s4u::this_actor::get_host();
+  std::vector<s4u::ActorPtr> targets;
+  std::vector<s4u::CommPtr> transfers;
+  for (auto const& [target, batch] : pending) {
+    auto target_actor = s4u::Actor::by_pid(comm_->group()->actor(target));
+    if (target != rank_ && not batch->payload.empty())
+      transfers.push_back(s4u::Comm::sendto_async(local_host, target_actor->get_host(), batch->payload.size()));
+    if (target != rank_ && batch->get_size > 0)
+      transfers.push_back(s4u::Comm::sendto_async(target_actor->get_host(), local_host, batch->get_size));
+    targets.push_back(std::move(target_actor));
+  }
+  for (auto const& transfer : transfers)
+    transfer->wait();
+
+  int finished = 0;
+  smpi_switch_data_segment(s4u::Actor::self());
+  std::vector<unsigned char> buffer;
+  for (size_t i = 0; i < pending.size(); i++) {
+    Batch& batch = *pending[i].second;
+    for (auto& op : batch.ops) {
+      void* target_addr =
+          smpi_privatized_address(targets[i], op.target_addr, op.target_count * op.target_datatype->get_extent());
+      // A target buffer that straddles the data segment is only reachable once the segment of the target is switched in
+      const bool switched = target_addr == nullptr;
+      if (switched) {
+        smpi_switch_data_segment(targets[i]);
+        target_addr = op.target_addr;
+      }
+      if (op.op == MPI_OP_NULL) {
+        buffer.resize(op.size);
+        if (op.size > 0)
+          op.target_datatype->serialize(target_addr, buffer.data(),
+                                        static_cast<int>(op.size / op.target_datatype->size()));
+        if (switched)
+          smpi_switch_data_segment(s4u::Actor::self());
+        if (op.size > 0)
+          op.origin_datatype->unserialize(buffer.data(), op.origin_addr,
+                                          static_cast<int>(op.size / op.origin_datatype->size()), MPI_REPLACE);
+        Datatype::unref(op.origin_datatype);
+      } else {
+        if (op.size > 0)
+          op.target_datatype->unserialize(batch.payload.data() + op.offset, target_addr,
+                                          static_cast<int>(op.size / op.target_datatype->size()), op.op);
+        if (switched)
+          smpi_switch_data_segment(s4u::Actor::self());
+        Op::unref(&op.op);
+      }
+      Datatype::unref(op.target_datatype);
+    }
+    XBT_DEBUG("Flushed %zu batched RMA operations for %d", batch.ops.size(), pending[i].first);
+    finished += static_cast<int>(batch.ops.size());
+    batch.ops.clear();
+    batch.payload.clear();
+    batch.get_size = 0;
+  }
+  return finished;
+}
+
 Win* Win::f2c(int id){
   return static_cast<Win*>(F2C::f2c(id));
 }
@@ -4,52 +4,449 @@
  * under the terms of the license (GNU LGPL) which comes with this package. */
 
 #include "simgrid/Exception.hpp"
+#include "xbt/config.hpp"
 #include "xbt/log.h"
 #include "xbt/replay.hpp"
 
 #include <boost/algorithm/string.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 XBT_LOG_NEW_DEFAULT_SUBCATEGORY(replay,xbt,"Replay trace reader");
 
 namespace simgrid::xbt {
 
-static std::ifstream action_fs;
+/* Binary traces are pre-tokenized versions of the textual ones, produced by xbt_replay_convert_to_binary().
+ * After the magic header, the file is a sequence of records, each starting with a varint N:
+ *  - N == 0 defines the next entry of the string table: a varint length followed by the bytes of the string.
+ *  - N > 0 is an action of N tokens. Each token is a varint T: if T is even, it is the string of index T/2 in the
+ *    table; if T is odd, it is a literal of T/2 bytes stored inline (used once the table is full).
+ */
+static constexpr char binary_magic[]           = {'S', 'G', 'T', 'I', 'B', 'I', 'N', '1'};
+static constexpr size_t binary_max_interned    = 1 << 20;
+static constexpr size_t binary_max_intern_size = 64;
 
-std::unordered_map<std::string, action_fun> action_funs;
+static std::unordered_map<std::string, action_fun> action_funs;
 static std::unordered_map<std::string, std::queue<std::unique_ptr<ReplayAction>>> action_queues;
 
-static void read_and_trim_line(std::ifstream& fs, std::string* line)
-{
-  do {
-    std::getline(fs, *line);
-    boost::trim(*line);
-  } while (not fs.eof() && (line->length() == 0 || line->front() == '#'));
-  XBT_DEBUG("got from trace: %s", line->c_str());
-}
-
 class ReplayReader {
+public:
+  ReplayReader()                               = default;
+  ReplayReader(const ReplayReader&)            = delete;
+  ReplayReader& operator=(const ReplayReader&) = delete;
+  virtual ~ReplayReader()                      = default;
+
+  /** Fills the action with the tokens of the next line. Returns false at the end of the trace. */
+  virtual bool get(ReplayAction* action) = 0;
+  /** Closes the underlying file descriptor (if any) until the next get(), to bound the amount of open files */
+  virtual void release_handle() { /* nothing to release by default */ }
+  virtual bool has_handle() const { return false; }
+
+  /** Opens the given trace, picking the right reader depending on the format of the file */
+  static std::unique_ptr<ReplayReader> open(const std::string& filename);
+};
+
+/* The file is only opened on the first read, as there may be many more traces than available file descriptors. It can
+ * also be closed between two reads: we then remember where to resume, and reopen it on the next read */
+class TextReplayReader : public ReplayReader {
+  std::string filename_;
   std::ifstream fs;
+  std::streampos offset_ = 0;
   std::string line;
 
 public:
-  explicit ReplayReader(const char* filename) : fs(filename, std::ifstream::in)
+  explicit TextReplayReader(const std::string& filename) : filename_(filename)
   {
-    XBT_VERB("Prepare to replay file '%s'", filename);
-    xbt_assert(fs.is_open(), "Cannot read replay file '%s'", filename);
+    XBT_VERB("Prepare to replay file '%s'", filename.c_str());
+    xbt_assert(access(filename.c_str(), R_OK) == 0, "Cannot read replay file '%s': %s", filename.c_str(),
+               strerror(errno));
   }
-  ReplayReader(const ReplayReader&) = delete;
-  ReplayReader& operator=(const ReplayReader&) = delete;
-  bool get(ReplayAction* action);
+  bool get(ReplayAction* action) override;
+  void release_handle() override;
+  bool has_handle() const override { return fs.is_open(); }
 };
 
-bool ReplayReader::get(ReplayAction* action)
+bool TextReplayReader::get(ReplayAction* action)
 {
-  read_and_trim_line(fs, &line);
+  if (not fs.is_open()) {
+    fs.open(filename_, std::ifstream::in);
+    xbt_assert(fs.is_open(), "Cannot read replay file '%s'", filename_.c_str());
+    fs.seekg(offset_);
+  }
+  do {
+    std::getline(fs, line);
+    boost::trim(line);
+  } while (not fs.eof() && (line.length() == 0 || line.front() == '#'));
+  XBT_DEBUG("got from trace: %s", line.c_str());
 
   boost::split(*action, line, boost::is_any_of(" \t"), boost::token_compress_on);
   return not fs.eof();
 }
 
+void TextReplayReader::release_handle()
+{
+  if (fs.is_open() && not fs.eof()) {
+    offset_ = fs.tellg();
+    fs.close();
+  }
+}
+
+/* Memory-maps the whole file and decodes it in place. The tokens are copied into the strings already present in the
+ * action, so that the reader does not allocate anything once the action vector is warm. */
+class BinaryReplayReader : public ReplayReader {
+  std::string filename_;
+  const char* data_ = nullptr;
+  size_t size_      = 0;
+  size_t pos_       = sizeof binary_magic;
+  std::vector<std::string> strings_;
+
+  size_t read_varint();
+  const char* read_bytes(size_t len);
+
+public:
+  explicit BinaryReplayReader(const std::string& filename);
+  ~BinaryReplayReader() override;
+  bool get(ReplayAction* action) override;
+};
+
+BinaryReplayReader::BinaryReplayReader(const std::string& filename) : filename_(filename)
+{
+  XBT_VERB("Prepare to replay binary file '%s'", filename.c_str());
+  int fd = ::open(filename.c_str(), O_RDONLY);
+  xbt_assert(fd >= 0, "Cannot read replay file '%s': %s", filename.c_str(), strerror(errno));
+  struct stat st;
+  xbt_assert(fstat(fd, &st) == 0, "Cannot stat replay file '%s': %s", filename.c_str(), strerror(errno));
+  size_ = static_cast<size_t>(st.st_size);
+  xbt_assert(size_ >= sizeof binary_magic, "Binary replay file '%s' is truncated", filename.c_str());
+  void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  xbt_assert(data != MAP_FAILED, "Cannot map replay file '%s': %s", filename.c_str(), strerror(errno));
+  close(fd);
+  madvise(data, size_, MADV_SEQUENTIAL);
+  data_ = static_cast<const char*>(data);
+}
+
+BinaryReplayReader::~BinaryReplayReader()
+{
+  munmap(const_cast<char*>(data_), size_);
+}
+
+size_t BinaryReplayReader::read_varint()
+{
+  size_t value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    xbt_assert(pos_ < size_, "Binary replay file '%s' is truncated", filename_.c_str());
+    auto byte = static_cast<unsigned char>(data_[pos_++]);
+    value |= static_cast<size_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+      return value;
+  }
+  xbt_die("Binary replay file '%s' is corrupted (overlong varint at offset %zu)", filename_.c_str(), pos_);
+}
+
+const char* BinaryReplayReader::read_bytes(size_t len)
+{
+  xbt_assert(len <= size_ - pos_, "Binary replay file '%s' is truncated", filename_.c_str());
+  const char* bytes = data_ + pos_;
+  pos_ += len;
+  return bytes;
+}
+
+bool BinaryReplayReader::get(ReplayAction* action)
+{
+  while (pos_ < size_) {
+    size_t count = read_varint();
+    if (count == 0) { // Definition of a new interned string
+      size_t len = read_varint();
+      strings_.emplace_back(read_bytes(len), len);
+      continue;
+    }
+    action->resize(count);
+    for (auto& token : *action) {
+      size_t code = read_varint();
+      if (code & 1) {
+        size_t len = code >> 1;
+        token.assign(read_bytes(len), len);
+      } else {
+        xbt_assert((code >> 1) < strings_.size(), "Binary replay file '%s' is corrupted (unknown string %zu)",
+                   filename_.c_str(), code >> 1);
+        token = strings_[code >> 1];
+      }
+    }
+    return true;
+  }
+  action->clear();
+  return false;
+}
+
+std::unique_ptr<ReplayReader> ReplayReader::open(const std::string& filename)
+{
+  std::ifstream probe(filename, std::ifstream::binary);
+  xbt_assert(probe.is_open(), "Cannot read replay file '%s'", filename.c_str());
+  char header[sizeof binary_magic] = {};
+  probe.read(header, sizeof header);
+  if (probe.gcount() == sizeof header && std::memcmp(header, binary_magic, sizeof header) == 0)
+    return std::make_unique<BinaryReplayReader>(filename);
+  return std::make_unique<TextReplayReader>(filename);
+}
+
+/* Read-ahead of the traces, enabled with replay/prefetch-threads.
+ *
+ * Each trace gets a PrefetchedReader wrapping its actual reader. A pool of background threads tokenizes the upcoming
+ * actions of every trace into a bounded single-producer/single-consumer ring, so that the replaying actors only have to
+ * swap the prepared actions out of their ring. At most one thread fills a given ring at any time: the streams to refill
+ * are queued in the pool, and an actor asks for a refill once its ring is half empty. A refill asked while the stream
+ * is being filled is queued again by the filling thread once it is done, so that no request gets lost. To scale to many
+ * traces, the file descriptors of the idle streams are closed in LRU order when there are more than
+ * replay/max-open-files of them.
+ */
+static simgrid::config::Flag<int> cfg_prefetch_threads{
+    "replay/prefetch-threads", "Number of background threads reading the replay traces ahead (0: no read-ahead)", 0};
+static simgrid::config::Flag<int> cfg_prefetch_depth{"replay/prefetch-depth",
+                                                     "Amount of actions read ahead for each replay trace", 128};
+static simgrid::config::Flag<int> cfg_max_open_files{
+    "replay/max-open-files", "Maximal amount of replay traces kept open by the read-ahead threads", 512};
+
+class ActionRing {
+  std::vector<ReplayAction> slots_;
+  size_t mask_ = 1;
+  alignas(64) std::atomic<size_t> head_{0}; // Next slot to consume, only written by the consumer
+  alignas(64) std::atomic<size_t> tail_{0}; // Next slot to produce, only written by the producer
+
+public:
+  explicit ActionRing(size_t capacity)
+  {
+    size_t size = 2;
+    while (size < capacity)
+      size <<= 1;
+    slots_.resize(size);
+    mask_ = size - 1;
+  }
+  size_t capacity() const { return slots_.size(); }
+  size_t size() const { return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire); }
+  bool empty() const { return size() == 0; }
+
+  /** Slot where the producer can write the next action, or nullptr if the ring is full */
+  ReplayAction* producer_slot()
+  {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == slots_.size())
+      return nullptr;
+    return &slots_[tail & mask_];
+  }
+  void publish() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+  /** Swaps the next action with the given one (so that both keep their buffers). Returns false if the ring is empty */
+  bool pop(ReplayAction* action)
+  {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+      return false;
+    std::swap(*action, slots_[head & mask_]);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+};
+
+class PrefetchedReader;
+
+class ReplayPrefetcher {
+  std::mutex mutex_;
+  std::condition_variable work_cv_; // Signaled when a stream needs to be refilled
+  std::condition_variable data_cv_; // Signaled when a stream got refilled
+  std::deque<PrefetchedReader*> pending_;
+  std::list<PrefetchedReader*> idle_open_; // Streams that are not being filled but have an open file, most recent first
+  std::vector<std::thread> workers_;
+  bool stop_ = false;
+
+  void worker_loop();
+
+public:
+  explicit ReplayPrefetcher(int nthreads);
+  ReplayPrefetcher(const ReplayPrefetcher&)            = delete;
+  ReplayPrefetcher& operator=(const ReplayPrefetcher&) = delete;
+  ~ReplayPrefetcher();
+
+  void schedule(PrefetchedReader* stream);
+  void wait_for_data(PrefetchedReader* stream);
+  void forget(PrefetchedReader* stream);
+};
+
+class PrefetchedReader : public ReplayReader {
+  friend ReplayPrefetcher;
+  ReplayPrefetcher& pool_;
+  std::unique_ptr<ReplayReader> reader_; // Only used by the worker currently filling this stream
+  ActionRing ring_;
+  std::atomic<bool> eof_{false};
+  std::atomic<bool> scheduled_{false}; // Queued, or to queue again after the current fill. Only written under the mutex
+  bool filling_ = false;                                     // Protected by the pool mutex
+  std::optional<std::list<PrefetchedReader*>::iterator> lru_; // Protected by the pool mutex
+
+  void fill();
+
+public:
+  PrefetchedReader(ReplayPrefetcher& pool, std::unique_ptr<ReplayReader> reader, size_t depth)
+      : pool_(pool), reader_(std::move(reader)), ring_(depth)
+  {
+    pool_.schedule(this);
+  }
+  ~PrefetchedReader() override { pool_.forget(this); }
+  bool get(ReplayAction* action) override;
+  bool exhausted() const { return eof_.load(std::memory_order_acquire); }
+  bool has_data() const { return not ring_.empty() || exhausted(); }
+};
+
+void PrefetchedReader::fill()
+{
+  while (ReplayAction* slot = ring_.producer_slot()) {
+    if (not reader_->get(slot)) {
+      reader_.reset();
+      eof_.store(true, std::memory_order_release);
+      return;
+    }
+    ring_.publish();
+  }
+}
+
+bool PrefetchedReader::get(ReplayAction* action)
+{
+  while (true) {
+    if (ring_.pop(action)) {
+      if (ring_.size() <= ring_.capacity() / 2)
+        pool_.schedule(this);
+      return true;
+    }
+    if (exhausted()) // The producer may have pushed its last actions right before raising the flag
+      return ring_.pop(action);
+    XBT_DEBUG("Read-ahead ring is empty, waiting for the prefetching threads");
+    pool_.schedule(this);
+    pool_.wait_for_data(this);
+  }
+}
+
+ReplayPrefetcher::ReplayPrefetcher(int nthreads)
+{
+  XBT_VERB("Start %d threads to read the replay traces ahead", nthreads);
+  for (int i = 0; i < nthreads; i++)
+    workers_.emplace_back([this] { worker_loop(); });
+}
+
+ReplayPrefetcher::~ReplayPrefetcher()
+{
+  {
+    std::scoped_lock lock(mutex_);
+    stop_ = true;
+  }
+  work_cv_.notify_all();
+  for (auto& worker : workers_)
+    worker.join();
+}
+
+void ReplayPrefetcher::schedule(PrefetchedReader* stream)
+{
+  if (stream->exhausted() || stream->scheduled_.load()) // Fast path, without locking
+    return;
+  {
+    std::scoped_lock lock(mutex_);
+    if (stream->exhausted() || stream->scheduled_.load())
+      return;
+    stream->scheduled_ = true;
+    if (stream->filling_) // The filling thread queues it again when it is done
+      return;
+    pending_.push_back(stream);
+  }
+  work_cv_.notify_one();
+}
+
+void ReplayPrefetcher::wait_for_data(PrefetchedReader* stream)
+{
+  std::unique_lock lock(mutex_);
+  while (not stream->has_data()) {
+    // A fill that started before we drained the ring may have found it full. Make sure that another one comes.
+    if (not stream->scheduled_.load() && not stream->filling_) {
+      stream->scheduled_ = true;
+      pending_.push_back(stream);
+      work_cv_.notify_one();
+    }
+    data_cv_.wait(lock);
+  }
+}
+
+void ReplayPrefetcher::forget(PrefetchedReader* stream)
+{
+  std::unique_lock lock(mutex_);
+  data_cv_.wait(lock, [stream] { return not stream->filling_; });
+  pending_.erase(std::remove(pending_.begin(), pending_.end(), stream), pending_.end());
+  if (stream->lru_)
+    idle_open_.erase(*stream->lru_);
+}
+
+void ReplayPrefetcher::worker_loop()
+{
+  std::unique_lock lock(mutex_);
+  while (true) {
+    work_cv_.wait(lock, [this] { return stop_ || not pending_.empty(); });
+    if (stop_)
+      return;
+    PrefetchedReader* stream = pending_.front();
+    pending_.pop_front();
+    stream->filling_   = true;
+    stream->scheduled_ = false; // The requests arriving from now on need another fill
+    if (stream->lru_) {
+      idle_open_.erase(*stream->lru_);
+      stream->lru_.reset();
+    }
+
+    lock.unlock();
+    stream->fill();
+    lock.lock();
+
+    stream->filling_ = false;
+    if (stream->scheduled_.load() && not stream->exhausted()) {
+      pending_.push_back(stream);
+      work_cv_.notify_one();
+    } else if (stream->reader_ && stream->reader_->has_handle()) {
+      idle_open_.push_front(stream);
+      stream->lru_ = idle_open_.begin();
+    }
+    while (idle_open_.size() > static_cast<size_t>(std::max(cfg_max_open_files.get(), 1))) {
+      PrefetchedReader* victim = idle_open_.back();
+      idle_open_.pop_back();
+      victim->lru_.reset();
+      victim->reader_->release_handle();
+    }
+    data_cv_.notify_all();
+  }
+}
+
+static std::unique_ptr<ReplayPrefetcher> prefetcher;
+
+/** Opens the given trace, and reads it ahead in the background if requested by the configuration */
+static std::unique_ptr<ReplayReader> open_trace(const std::string& filename)
+{
+  auto reader = ReplayReader::open(filename);
+  if (cfg_prefetch_threads <= 0)
+    return reader;
+  if (not prefetcher)
+    prefetcher = std::make_unique<ReplayPrefetcher>(cfg_prefetch_threads);
+  return std::make_unique<PrefetchedReader>(*prefetcher, std::move(reader), cfg_prefetch_depth);
+}
+
+/** The shared trace, if xbt_replay_set_tracefile() was used */
+static std::unique_ptr<ReplayReader> shared_reader;
+
 static std::unique_ptr<ReplayAction> get_action(const char* name)
 {
   if (auto queue_elt = action_queues.find(name); queue_elt != action_queues.end()) {
@@ -64,16 +461,13 @@ static std::unique_ptr<ReplayAction> get_action(const char* name)
   // Nothing stored for me. Read the file further
   // Read lines until I reach something for me (which breaks in loop body) or end of file reached
   while (true) {
-    std::string action_line;
-    read_and_trim_line(action_fs, &action_line);
-    if (action_fs.eof())
-      break;
-    /* we cannot split in place here because we parse&store several lines for the colleagues... */
+    /* we cannot reuse the same action here because we parse&store several lines for the colleagues... */
     auto action = std::make_unique<ReplayAction>();
-    boost::split(*action, action_line, boost::is_any_of(" \t"), boost::token_compress_on);
+    if (not shared_reader->get(action.get()))
+      break;
 
     // if it's for me, I'm done
-    std::string evtname = action->front();
+    const std::string& evtname = action->front();
     if (evtname == name)
       return action;
 
@@ -109,7 +503,7 @@ static void handle_action(ReplayAction& action)
 int replay_runner(const char* actor_name, const char* trace_filename)
 {
   std::string actor_name_string(actor_name);
-  if (simgrid::xbt::action_fs.is_open()) { // <A unique trace file
+  if (shared_reader) { // <A unique trace file
     xbt_assert(trace_filename == nullptr,
                "Passing nullptr to replay_runner() means that you want to use a shared trace, but you did not provide "
                "any. Please use xbt_replay_set_tracefile().");
@@ -126,14 +520,13 @@ int replay_runner(const char* actor_name, const char* trace_filename)
                "xbt_replay_set_tracefile() if you use actor-specific trace files using the second parameter of "
                "replay_runner().");
     simgrid::xbt::ReplayAction evt;
-    simgrid::xbt::ReplayReader reader(trace_filename);
-    while (reader.get(&evt)) {
+    auto reader = open_trace(trace_filename);
+    while (reader->get(&evt)) {
       if (evt.front() == actor_name) {
         simgrid::xbt::handle_action(evt);
       } else {
         XBT_WARN("Ignore trace element not for me (target='%s', I am '%s')", evt.front().c_str(), actor_name);
       }
-      evt.clear();
     }
   }
   return 0;
@@ -170,7 +563,59 @@ action_fun xbt_replay_action_get(const char* action_name)
 
 void xbt_replay_set_tracefile(const std::string& filename)
 {
-  xbt_assert(not simgrid::xbt::action_fs.is_open(), "Tracefile already set");
-  simgrid::xbt::action_fs.open(filename, std::ifstream::in);
-  xbt_assert(simgrid::xbt::action_fs.is_open(), "Failed to open file: %s", filename.c_str());
+  xbt_assert(not simgrid::xbt::shared_reader, "Tracefile already set");
+  simgrid::xbt::shared_reader = simgrid::xbt::open_trace(filename);
+}
+
+static void write_varint(std::ofstream& out, size_t value)
+{
+  while (value >= 0x80) {
+    out.put(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  out.put(static_cast<char>(value));
+}
+
+/**
+ * @ingroup XBT_replay
+ * @brief Converts a textual trace into the binary format, that is much faster to load
+ *
+ * The replay functions detect the format of the trace files by themselves, so both formats can be mixed freely.
+ * The binary trace produces exactly the same actions as the textual one: comments and empty lines are dropped, and
+ * each line is split on blanks. Short tokens (actor names, action names, datatypes, most sizes) are interned and
+ * stored only once in the file.
+ */
+void xbt_replay_convert_to_binary(const std::string& text_trace, const std::string& binary_trace)
+{
+  simgrid::xbt::TextReplayReader reader(text_trace);
+  std::ofstream out(binary_trace, std::ofstream::binary | std::ofstream::trunc);
+  xbt_assert(out.is_open(), "Cannot write binary replay file '%s'", binary_trace.c_str());
+  out.write(simgrid::xbt::binary_magic, sizeof simgrid::xbt::binary_magic);
+
+  std::unordered_map<std::string, size_t> interned;
+  simgrid::xbt::ReplayAction action;
+  while (reader.get(&action)) {
+    for (auto const& token : action) {
+      if (token.size() > simgrid::xbt::binary_max_intern_size || interned.size() >= simgrid::xbt::binary_max_interned ||
+          interned.find(token) != interned.end())
+        continue;
+      interned.try_emplace(token, interned.size());
+      write_varint(out, 0);
+      write_varint(out, token.size());
+      out.write(token.data(), static_cast<std::streamsize>(token.size()));
+    }
+
+    write_varint(out, action.size());
+    for (auto const& token : action) {
+      if (auto it = interned.find(token); it != interned.end()) {
+        write_varint(out, it->second << 1);
+      } else {
+        write_varint(out, (token.size() << 1) | 1);
+        out.write(token.data(), static_cast<std::streamsize>(token.size()));
+      }
+    }
+  }
+  xbt_assert(out.good(), "Error while writing binary replay file '%s'", binary_trace.c_str());
+  XBT_VERB("Converted '%s' into '%s' (%zu interned strings)", text_trace.c_str(), binary_trace.c_str(),
+           interned.size());
 }
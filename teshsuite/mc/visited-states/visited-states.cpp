@@ -0,0 +1,47 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* In this test, two players pass a token to each other forever. Each of them locks a mutex, gives the token to the
+ * other if it holds it, and unlocks the mutex. The program never ends, so a stateless exploration only terminates when
+ * reaching model-check/max-depth. The whole state of the application (the token) is declared to the model-checker, so
+ * that the exploration stops when all reachable states were visited, and checks that nobody ever sees the token
+ * vanish. */
+
+#include "simgrid/modelchecker.h"
+#include "simgrid/s4u/Engine.hpp"
+#include "simgrid/s4u/Host.hpp"
+#include "simgrid/s4u/Mutex.hpp"
+
+#include <mutex> // std::unique_lock
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(visited_states, "Messages specific for this test");
+
+static int token_owner = 0;
+
+static void player(int me, simgrid::s4u::MutexPtr mutex)
+{
+  while (true) {
+    std::unique_lock lock{*mutex};
+    MC_assert(token_owner == 0 || token_owner == 1);
+    if (token_owner == me)
+      token_owner = 1 - me;
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  simgrid::s4u::Engine e(&argc, argv);
+  xbt_assert(argc > 1, "Usage: %s platform_file\n", argv[0]);
+  e.load_platform(argv[1]);
+
+  MC_declare_state(&token_owner, sizeof token_owner);
+
+  auto mutex = simgrid::s4u::Mutex::create();
+  e.add_actor("player0", e.host_by_name("Tremblay"), player, 0, mutex);
+  e.add_actor("player1", e.host_by_name("Jupiter"), player, 1, mutex);
+
+  e.run();
+  return 0;
+}
@@ -0,0 +1,78 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/**
+ * Test the latency-only path of the CM02 model for small messages (network/latency-only-thresh)
+ *
+ * Platform: single link
+ *
+ *   S1 ___[ L1 ]___S2
+ *
+ * Link L1: 100MB/s, 1ms
+ */
+
+#include <simgrid/s4u.hpp>
+#include <xbt/config.hpp>
+
+namespace sg4 = simgrid::s4u;
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(cm02_latency_only, "Messages specific for this simulation");
+
+static void send(const std::string& name, double size, double delay)
+{
+  sg4::this_actor::sleep_for(delay);
+  double start_time = sg4::Engine::get_clock();
+  sg4::Mailbox::by_name(name)->put(new std::string(name), size);
+  XBT_INFO("  %s: %.0f bytes sent in %f seconds", name.c_str(), size, sg4::Engine::get_clock() - start_time);
+}
+
+static void receive(const std::string& name)
+{
+  delete sg4::Mailbox::by_name(name)->get<std::string>();
+}
+
+static void run_test(std::vector<std::pair<double, double>> const& messages)
+{
+  sg4::Engine& e = *sg4::this_actor::get_engine();
+  int i          = 0;
+  for (auto const& [size, delay] : messages) {
+    std::string name = "msg" + std::to_string(i++);
+    e.add_actor("sender", e.host_by_name("host1"), send, name, size, delay);
+    e.add_actor("receiver", e.host_by_name("host2"), receive, name);
+  }
+  sg4::this_actor::sleep_for(10);
+}
+
+/* We need a separate actor so that it can sleep after each test */
+static void main_dispatcher()
+{
+  XBT_INFO("Latency-only threshold: %.0f bytes",
+           simgrid::config::get_value<double>("network/latency-only-thresh"));
+  XBT_INFO("TEST a small message alone: it lasts 1ms + 10kB / 100MB/s = 0.0011 sec.");
+  run_test({{1e4, 0}});
+  XBT_INFO("TEST a small message sent during a large one: both get half of the bandwidth when the small one starts.");
+  XBT_INFO("  On the latency-only path, the small message does not slow the large one down.");
+  run_test({{1e8, 0}, {1e4, 0.5}});
+  XBT_INFO("TEST a large message sent during a small one: the small one keeps its initial share on the latency-only "
+           "path.");
+  run_test({{6e4, 0}, {1e8, 0.0003}});
+}
+
+int main(int argc, char** argv)
+{
+  sg4::Engine::set_config("network/crosstraffic:0");
+
+  sg4::Engine engine(&argc, argv);
+  auto* zone        = engine.get_netzone_root();
+  auto* host1       = zone->add_host("host1", 1e6)->seal();
+  auto const* host2 = zone->add_host("host2", 1e6)->seal();
+  auto* testlink    = zone->add_link("L1", 1e8)->set_latency(1e-3)->seal();
+  zone->add_route(host1, host2, {testlink});
+
+  engine.add_actor("dispatcher", host1, main_dispatcher);
+  engine.run();
+
+  return 0;
+}
@@ -0,0 +1,69 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Benchmark of the tracing system: pairs of actors exchange messages and compute, producing many trace events.
+ *
+ * Run it with and without tracing (or with --cfg=tracing/async-io:no, --cfg=tracing/format:Binary) to compare the
+ * wall-clock times, e.g.:
+ *   trace-bench cluster_backbone.xml 200 1000 --log=trace_bench.thres:verbose --cfg=tracing:yes --cfg=tracing/actor:yes
+ */
+
+#include "simgrid/instr.h"
+#include "simgrid/s4u.hpp"
+#include "xbt/xbt_os_time.h"
+
+XBT_LOG_NEW_DEFAULT_CATEGORY(trace_bench, "Benchmark of the tracing system");
+
+namespace sg4 = simgrid::s4u;
+
+static void pinger(sg4::Mailbox* in, sg4::Mailbox* out, int iterations)
+{
+  auto* host = sg4::this_actor::get_host();
+  for (int i = 0; i < iterations; i++) {
+    out->put(new int(i), 1000);
+    sg4::this_actor::exec_init(1e6)->set_tracing_category("compute")->wait();
+    simgrid::instr::add_host_variable(host->get_name(), "pings", 1);
+    delete in->get<int>();
+  }
+}
+
+static void ponger(sg4::Mailbox* in, sg4::Mailbox* out, int iterations)
+{
+  for (int i = 0; i < iterations; i++) {
+    auto* payload = in->get<int>();
+    sg4::this_actor::exec_init(1e6)->set_tracing_category("compute")->wait();
+    out->put(payload, 1000);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  sg4::Engine e(&argc, argv);
+  xbt_assert(argc == 4, "Usage: %s platform_file actor_pairs iterations", argv[0]);
+  e.load_platform(argv[1]);
+  int pairs      = std::stoi(argv[2]);
+  int iterations = std::stoi(argv[3]);
+
+  simgrid::instr::declare_tracing_category("compute");
+  simgrid::instr::declare_host_variable("pings");
+
+  auto hosts = e.get_all_hosts();
+  for (int i = 0; i < pairs; i++) {
+    auto* ping = sg4::Mailbox::by_name("ping-" + std::to_string(i));
+    auto* pong = sg4::Mailbox::by_name("pong-" + std::to_string(i));
+    e.add_actor("pinger", hosts[(2 * i) % hosts.size()], pinger, pong, ping, iterations);
+    e.add_actor("ponger", hosts[(2 * i + 1) % hosts.size()], ponger, ping, pong, iterations);
+  }
+
+  xbt_os_timer_t timer = xbt_os_timer_new();
+  xbt_os_walltimer_start(timer);
+  e.run();
+  xbt_os_walltimer_stop(timer);
+
+  XBT_VERB("Simulation ended at %f after %f s of wall-clock time", sg4::Engine::get_clock(),
+           xbt_os_timer_elapsed(timer));
+  xbt_os_timer_free(timer);
+  return 0;
+}
@@ -0,0 +1,145 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Checks the nonblocking collectives called in a loop (which reuse their requests), and the persistent collectives
+ * started several times on buffers that change between the starts. */
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define COUNT 8
+#define ITERATIONS 5
+
+static int check(const char* name, int iter, const int* buf, int count, int (*expected)(int, int, int), int arg)
+{
+  int errors = 0;
+  for (int i = 0; i < count; i++) {
+    if (buf[i] != expected(i, iter, arg)) {
+      if (errors == 0)
+        fprintf(stderr, "%s, iteration %d: got %d instead of %d at %d\n", name, iter, buf[i], expected(i, iter, arg), i);
+      errors++;
+    }
+  }
+  return errors;
+}
+
+static int size;
+
+/* Value contributed by a rank at a given iteration */
+static int value(int i, int iter, int rank)
+{
+  return 1000 * rank + 10 * i + iter;
+}
+
+static int sum(int i, int iter, int unused)
+{
+  (void)unused;
+  return 1000 * size * (size - 1) / 2 + size * (10 * i + iter);
+}
+
+/* Element i of a buffer gathered or exchanged from all ranks, COUNT ints per rank */
+static int gathered(int i, int iter, int offset)
+{
+  return value(i % COUNT + offset, iter, i / COUNT);
+}
+
+int main(int argc, char** argv)
+{
+  int rank;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  int* sendbuf = malloc(size * COUNT * sizeof(int));
+  int* recvbuf = malloc(size * COUNT * sizeof(int));
+  int* inplace = malloc(size * COUNT * sizeof(int));
+  int errors   = 0;
+  MPI_Request req;
+  MPI_Request reqs[8];
+
+  /* Nonblocking collectives with the same arguments */
+  for (int iter = 0; iter < ITERATIONS; iter++) {
+    for (int i = 0; i < COUNT; i++)
+      sendbuf[i] = value(i, iter, rank);
+    MPI_Iallreduce(sendbuf, recvbuf, COUNT, MPI_INT, MPI_SUM, MPI_COMM_WORLD, &req);
+    MPI_Wait(&req, MPI_STATUS_IGNORE);
+    errors += check("MPI_Iallreduce", iter, recvbuf, COUNT, sum, 0);
+
+    MPI_Iallgather(sendbuf, COUNT, MPI_INT, recvbuf, COUNT, MPI_INT, MPI_COMM_WORLD, &req);
+    MPI_Wait(&req, MPI_STATUS_IGNORE);
+    errors += check("MPI_Iallgather", iter, recvbuf, size * COUNT, gathered, 0);
+  }
+
+  /* Two nonblocking collectives with the same arguments at the same time */
+  MPI_Ibarrier(MPI_COMM_WORLD, &reqs[0]);
+  MPI_Ibarrier(MPI_COMM_WORLD, &reqs[1]);
+  MPI_Waitall(2, reqs, MPI_STATUSES_IGNORE);
+
+  /* Persistent collectives */
+  MPI_Barrier_init(MPI_COMM_WORLD, MPI_INFO_NULL, &reqs[0]);
+  MPI_Bcast_init(recvbuf, COUNT, MPI_INT, size - 1, MPI_COMM_WORLD, MPI_INFO_NULL, &reqs[1]);
+  MPI_Allreduce_init(sendbuf, recvbuf, COUNT, MPI_INT, MPI_SUM, MPI_COMM_WORLD, MPI_INFO_NULL, &reqs[2]);
+  MPI_Allreduce_init(MPI_IN_PLACE, inplace, COUNT, MPI_INT, MPI_SUM, MPI_COMM_WORLD, MPI_INFO_NULL, &reqs[3]);
+  MPI_Reduce_init(sendbuf, recvbuf, COUNT, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD, MPI_INFO_NULL, &reqs[4]);
+  MPI_Allgather_init(sendbuf, COUNT, MPI_INT, recvbuf, COUNT, MPI_INT, MPI_COMM_WORLD, MPI_INFO_NULL, &reqs[5]);
+  MPI_Alltoall_init(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, inplace, COUNT, MPI_INT, MPI_COMM_WORLD, MPI_INFO_NULL,
+                    &reqs[6]);
+  MPI_Gather_init(sendbuf, COUNT, MPI_INT, recvbuf, COUNT, MPI_INT, 0, MPI_COMM_WORLD, MPI_INFO_NULL, &reqs[7]);
+
+  for (int iter = 0; iter < ITERATIONS; iter++) {
+    MPI_Start(&reqs[0]);
+    MPI_Wait(&reqs[0], MPI_STATUS_IGNORE);
+
+    for (int i = 0; i < COUNT; i++)
+      recvbuf[i] = value(i, iter, rank);
+    MPI_Start(&reqs[1]);
+    MPI_Wait(&reqs[1], MPI_STATUS_IGNORE);
+    errors += check("MPI_Bcast_init", iter, recvbuf, COUNT, value, size - 1);
+
+    for (int i = 0; i < COUNT; i++) {
+      sendbuf[i] = value(i, iter, rank);
+      inplace[i] = value(i, iter, rank);
+    }
+    MPI_Startall(2, &reqs[2]);
+    MPI_Waitall(2, &reqs[2], MPI_STATUSES_IGNORE);
+    errors += check("MPI_Allreduce_init", iter, recvbuf, COUNT, sum, 0);
+    errors += check("MPI_Allreduce_init (in place)", iter, inplace, COUNT, sum, 0);
+
+    MPI_Start(&reqs[4]);
+    MPI_Wait(&reqs[4], MPI_STATUS_IGNORE);
+    if (rank == 0)
+      errors += check("MPI_Reduce_init", iter, recvbuf, COUNT, sum, 0);
+
+    MPI_Start(&reqs[5]);
+    MPI_Wait(&reqs[5], MPI_STATUS_IGNORE);
+    errors += check("MPI_Allgather_init", iter, recvbuf, size * COUNT, gathered, 0);
+
+    /* Each rank sends the block i of its buffer to rank i, and receives the block of rank i in the block i */
+    for (int i = 0; i < size * COUNT; i++)
+      inplace[i] = value(i, iter, rank);
+    MPI_Start(&reqs[6]);
+    MPI_Wait(&reqs[6], MPI_STATUS_IGNORE);
+    errors += check("MPI_Alltoall_init (in place)", iter, inplace, size * COUNT, gathered, COUNT * rank);
+
+    MPI_Start(&reqs[7]);
+    MPI_Wait(&reqs[7], MPI_STATUS_IGNORE);
+    if (rank == 0)
+      errors += check("MPI_Gather_init", iter, recvbuf, size * COUNT, gathered, 0);
+  }
+  for (int i = 0; i < 8; i++)
+    MPI_Request_free(&reqs[i]);
+
+  int total;
+  MPI_Reduce(&errors, &total, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  if (rank == 0)
+    printf("%d ranks: %d errors\n", size, total);
+
+  free(sendbuf);
+  free(recvbuf);
+  free(inplace);
+  MPI_Finalize();
+  return 0;
+}
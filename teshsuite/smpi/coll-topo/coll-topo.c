@@ -0,0 +1,82 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Checks and benchmarks the broadcasts and reductions on the hierarchical clusters.
+ *
+ * Every rank in turn broadcasts then reduces a buffer of the given amount of ints, and the simulated time of these
+ * collectives is reported with -report. Compare the algorithms on a platform, e.g.:
+ *   for algo in binomial_tree ompi topo; do
+ *     smpirun -np 240 -platform cluster_dragonfly.xml --cfg=smpi/bcast:$algo ./coll-topo 65536 -report
+ *   done
+ */
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+int main(int argc, char** argv)
+{
+  int rank;
+  int size;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  if (argc < 2) {
+    if (rank == 0)
+      fprintf(stderr, "Usage: %s <ints> [-report]\n", argv[0]);
+    MPI_Finalize();
+    return 1;
+  }
+  int count  = atoi(argv[1]);
+  int report = argc > 2 && strcmp(argv[2], "-report") == 0;
+  int* buf   = malloc(count * sizeof(int));
+  int* sum   = malloc(count * sizeof(int));
+  int errors = 0;
+
+  double bcast_time  = 0;
+  double reduce_time = 0;
+  for (int root = 0; root < size; root++) {
+    for (int i = 0; i < count; i++)
+      buf[i] = rank == root ? root + i : -1;
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = MPI_Wtime();
+    MPI_Bcast(buf, count, MPI_INT, root, MPI_COMM_WORLD);
+    bcast_time += MPI_Wtime() - start;
+    for (int i = 0; i < count; i++)
+      if (buf[i] != root + i)
+        errors++;
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    start = MPI_Wtime();
+    MPI_Reduce(buf, sum, count, MPI_INT, MPI_SUM, root, MPI_COMM_WORLD);
+    reduce_time += MPI_Wtime() - start;
+    if (rank == root)
+      for (int i = 0; i < count; i++)
+        if (sum[i] != size * (root + i))
+          errors++;
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start = MPI_Wtime();
+  MPI_Allreduce(MPI_IN_PLACE, buf, count, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  double allreduce_time = MPI_Wtime() - start;
+  for (int i = 0; i < count; i++)
+    if (buf[i] != size * (size - 1 + i))
+      errors++;
+
+  int total_errors;
+  MPI_Reduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  if (rank == 0) {
+    printf("%d ranks, %d ints: %d errors\n", size, count, total_errors);
+    if (report)
+      fprintf(stderr, "bcast: %g s, reduce: %g s, allreduce: %g s\n", bcast_time / size, reduce_time / size,
+              allreduce_time);
+  }
+  free(buf);
+  free(sum);
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,112 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Benchmark of the startup of many ranks: time to deploy and initialize them, and memory footprint of their state.
+ * The ranks also build a few communicators and check their rank translations, that rely on the same group structures.
+ *
+ * Compare the scaling on increasing numbers of ranks, e.g.:
+ *   for np in 1000 10000 100000; do
+ *     smpirun -no-privatize -np $np -platform cluster_backbone.xml --cfg=smpi/simulate-computation:no ./init-bench -report
+ *   done
+ */
+
+#include <mpi.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#define COLORS 64
+
+/* Checks that a few ranks of the given communicator are translated back to the expected ranks of MPI_COMM_WORLD.
+ * Checking all of them on each rank would cost O(P^2). */
+static int check_translation(MPI_Comm comm, int (*world_rank)(int, int, int), int arg)
+{
+  MPI_Group group;
+  MPI_Group world;
+  int size;
+  int rank;
+  int errors = 0;
+  MPI_Comm_group(comm, &group);
+  MPI_Comm_group(MPI_COMM_WORLD, &world);
+  MPI_Group_size(group, &size);
+  MPI_Group_rank(group, &rank);
+  int ranks[] = {0, rank, (rank + 1) % size, size - 1};
+  int translated[4];
+  MPI_Group_translate_ranks(group, 4, ranks, world, translated);
+  for (int i = 0; i < 4; i++)
+    if (translated[i] != world_rank(ranks[i], size, arg))
+      errors++;
+  MPI_Group_free(&group);
+  MPI_Group_free(&world);
+  return errors;
+}
+
+static int identity(int rank, int size, int arg)
+{
+  (void)size;
+  (void)arg;
+  return rank;
+}
+
+static int strided(int rank, int size, int color)
+{
+  (void)size;
+  return rank * COLORS + color;
+}
+
+static int reversed(int rank, int size, int arg)
+{
+  (void)arg;
+  return size - 1 - rank;
+}
+
+int main(int argc, char** argv)
+{
+  int rank;
+  int size;
+  int self_rank;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  MPI_Comm_rank(MPI_COMM_SELF, &self_rank);
+
+  if (rank == size - 1 && argc > 1 && strcmp(argv[1], "-report") == 0) {
+    /* The ranks are started in order and MPI_Init does not block, so all of them are initialized when the last one gets
+     * here: this is the cost of the startup, and the memory used by all the ranks before they communicate */
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    fprintf(stderr, "%d ranks: %.3f s of CPU, peak RSS of %ld MiB\n", size,
+            usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6,
+            usage.ru_maxrss / 1024);
+  }
+
+  int errors = (self_rank != 0);
+
+  MPI_Comm dup;
+  MPI_Comm_dup(MPI_COMM_WORLD, &dup);
+  errors += check_translation(dup, identity, 0);
+
+  /* Ranks that are far apart in MPI_COMM_WORLD */
+  MPI_Comm split;
+  MPI_Comm_split(MPI_COMM_WORLD, rank % COLORS, rank, &split);
+  errors += check_translation(split, strided, rank % COLORS);
+
+  /* Ranks in the reverse order of MPI_COMM_WORLD */
+  MPI_Comm reverse;
+  MPI_Comm_split(MPI_COMM_WORLD, 0, size - rank, &reverse);
+  errors += check_translation(reverse, reversed, 0);
+
+  MPI_Comm_free(&dup);
+  MPI_Comm_free(&split);
+  MPI_Comm_free(&reverse);
+
+  int total_errors;
+  MPI_Reduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  if (rank == 0)
+    printf("%d ranks: %d errors\n", size, total_errors);
+
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,81 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Interleaved collective accesses, as done when checkpointing a distributed array: each rank owns every size-th
+ * block of the file. The two-phase I/O turns them into a few large contiguous disk accesses done by the aggregators,
+ * at the price of shuffling the data over the network, while the independent accesses (romio_cb_write and
+ * romio_cb_read set to "disable") hit the disk for each rank. */
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define NBLOCKS 256
+#define BLOCK 4096
+
+static void run(const char* mode, const char* cb_nodes)
+{
+  int rank;
+  int size;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  MPI_Info info;
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "romio_cb_write", mode);
+  MPI_Info_set(info, "romio_cb_read", mode);
+  MPI_Info_set(info, "cb_buffer_size", "524288");
+  if (cb_nodes != NULL)
+    MPI_Info_set(info, "cb_nodes", cb_nodes);
+  MPI_File fh;
+  MPI_File_open(MPI_COMM_WORLD, "/scratch/checkpoint", MPI_MODE_RDWR | MPI_MODE_CREATE | MPI_MODE_DELETE_ON_CLOSE,
+                info, &fh);
+  MPI_Info_free(&info);
+
+  MPI_Datatype blocks;
+  MPI_Type_vector(NBLOCKS, BLOCK, BLOCK * size, MPI_BYTE, &blocks);
+  MPI_Type_commit(&blocks);
+  char* buf = malloc(NBLOCKS * BLOCK);
+  MPI_Status status;
+  int count;
+  int errors = 0;
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  double start = MPI_Wtime();
+  MPI_File_seek(fh, rank * BLOCK, MPI_SEEK_SET);
+  MPI_File_write_all(fh, buf, 1, blocks, &status);
+  MPI_Get_count(&status, MPI_BYTE, &count);
+  errors += count != NBLOCKS * BLOCK;
+  MPI_Barrier(MPI_COMM_WORLD);
+  double write_time = MPI_Wtime() - start;
+
+  start = MPI_Wtime();
+  MPI_File_seek(fh, rank * BLOCK, MPI_SEEK_SET);
+  MPI_File_read_all(fh, buf, 1, blocks, &status);
+  MPI_Get_count(&status, MPI_BYTE, &count);
+  errors += count != NBLOCKS * BLOCK;
+  MPI_Offset position;
+  MPI_File_get_position(fh, &position);
+  errors += position != rank * BLOCK + ((NBLOCKS - 1) * size + 1) * BLOCK;
+  MPI_Barrier(MPI_COMM_WORLD);
+  double read_time = MPI_Wtime() - start;
+
+  free(buf);
+  MPI_Type_free(&blocks);
+  MPI_File_close(&fh);
+  if (rank == 0)
+    printf("%s%s%s: write %f s, read %f s, %d errors\n", mode, cb_nodes ? ", cb_nodes " : "", cb_nodes ? cb_nodes : "",
+           write_time, read_time, errors);
+}
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+  run("disable", NULL);
+  run("automatic", "all"); /* Not a number: ignored */
+  run("enable", "1");
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,55 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Benchmark of the privatization strategies: cost of starting many ranks, and memory footprint of the simulation.
+ *
+ * Compare the strategies on the same number of ranks, e.g.:
+ *   for p in dlopen memfd mmap; do
+ *     smpirun -np 1000 -platform cluster_backbone.xml --cfg=smpi/privatization:$p ./privatization-bench -report
+ *   done
+ */
+
+#include <mpi.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+
+static int initialized_data[1 << 14] = {1}; // 64 KiB of data
+static char uninitialized_data[1 << 18];    // 256 KiB of bss
+
+int main(int argc, char** argv)
+{
+  int rank;
+  int size;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  /* Each rank writes a part of its globals, as real applications do. They all write the same variables, and let the
+   * other ranks run before reading them back: the privatization must keep their values apart. */
+  initialized_data[0] = rank;
+  memset(uninitialized_data, rank, sizeof(uninitialized_data) / 4);
+  MPI_Barrier(MPI_COMM_WORLD);
+
+  int errors = initialized_data[0] != rank || uninitialized_data[0] != (char)rank;
+  int total_errors;
+  MPI_Reduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+
+  if (rank == 0) {
+    if (total_errors != 0)
+      printf("%d ranks saw the globals of another rank\n", total_errors);
+    if (argc > 1 && strcmp(argv[1], "-report") == 0) {
+      /* All ranks are started, so this is the cost of the startup, and the memory used by all the ranks */
+      struct rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+      fprintf(stderr, "%d ranks: %.3f s of CPU, peak RSS of %ld MiB\n", size,
+              usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6,
+              usage.ru_maxrss / 1024);
+    }
+  }
+
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,82 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Microbenchmark of the cost of switching between ranks, depending on the amount of global memory that they use.
+ *
+ * Two ranks exchange messages from and to global buffers, and write a given amount of their global variables between
+ * two messages. Compare the privatization strategies and amounts of globals (in KiB), e.g.:
+ *   for kib in 4 64 1024 16384; do
+ *     smpirun -np 2 -platform small_platform.xml --cfg=smpi/privatization:mmap ./privatization-switch 10000 $kib -report
+ *   done
+ */
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+
+#define GLOBALS_SIZE (16 << 20)
+#define MESSAGE_SIZE 256
+
+static char globals[GLOBALS_SIZE];
+static int message[MESSAGE_SIZE];
+
+static double cpu_time(void)
+{
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+int main(int argc, char** argv)
+{
+  int rank;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  if (argc < 3) {
+    if (rank == 0)
+      printf("Usage: %s <iterations> <KiB of globals written per iteration> [-report]\n", argv[0]);
+    MPI_Finalize();
+    return 1;
+  }
+  int iterations = atoi(argv[1]);
+  size_t touched = (size_t)atoi(argv[2]) * 1024;
+  if (touched > GLOBALS_SIZE)
+    touched = GLOBALS_SIZE;
+
+  int errors   = 0;
+  double start = cpu_time();
+  for (int i = 0; i < iterations; i++) {
+    memset(globals, rank + i, touched);
+    if (rank == 0) {
+      for (int k = 0; k < MESSAGE_SIZE; k++)
+        message[k] = i + k;
+      MPI_Send(message, MESSAGE_SIZE, MPI_INT, 1, 0, MPI_COMM_WORLD);
+      MPI_Recv(message, MESSAGE_SIZE, MPI_INT, 1, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      errors += (message[MESSAGE_SIZE - 1] != i + MESSAGE_SIZE);
+    } else if (rank == 1) {
+      MPI_Recv(message, MESSAGE_SIZE, MPI_INT, 0, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      for (int k = 0; k < MESSAGE_SIZE; k++)
+        message[k]++;
+      MPI_Send(message, MESSAGE_SIZE, MPI_INT, 0, 0, MPI_COMM_WORLD);
+    }
+    /* The other rank ran in between: our globals must be unchanged */
+    errors += (touched > 0 && (globals[0] != (char)(rank + i) || globals[touched - 1] != (char)(rank + i)));
+  }
+  double elapsed = cpu_time() - start;
+
+  int total_errors;
+  MPI_Reduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  if (rank == 0) {
+    printf("%d iterations done, %d errors\n", iterations, total_errors);
+    if (argc > 3 && strcmp(argv[3], "-report") == 0)
+      fprintf(stderr, "%zu KiB of globals: %.2f us of CPU per iteration\n", touched / 1024,
+              elapsed * 1e6 / iterations);
+  }
+
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,81 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Small (detached) sends whose buffer is overwritten as soon as MPI_Send returns. The data is either copied straight
+ * into the receive buffer when the receive is already posted, or kept in a pooled buffer until the receiver comes. */
+
+#include <mpi.h>
+#include <stdio.h>
+#include <string.h>
+
+#define NSIZES 9
+#define INFLIGHT 64
+static const int sizes[NSIZES] = {1, 63, 64, 65, 1000, 4096, 4097, 60000, 65535};
+static char sendbuf[65536];
+static char recvbuf[INFLIGHT][65536];
+
+static void fill(char* buf, int size, int seed)
+{
+  for (int i = 0; i < size; i++)
+    buf[i] = (char)(seed + i * 7);
+}
+
+static int check(const char* buf, int size, int seed)
+{
+  for (int i = 0; i < size; i++)
+    if (buf[i] != (char)(seed + i * 7))
+      return 1;
+  return 0;
+}
+
+int main(int argc, char* argv[])
+{
+  int rank;
+  int errors = 0;
+  MPI_Init(&argc, &argv);
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  for (int s = 0; s < NSIZES; s++) {
+    int size = sizes[s];
+    /* The receive is posted first */
+    if (rank == 1) {
+      MPI_Request req;
+      MPI_Irecv(recvbuf[0], size, MPI_CHAR, 0, s, MPI_COMM_WORLD, &req);
+      MPI_Barrier(MPI_COMM_WORLD);
+      MPI_Wait(&req, MPI_STATUS_IGNORE);
+      errors += check(recvbuf[0], size, s);
+    } else if (rank == 0) {
+      MPI_Barrier(MPI_COMM_WORLD);
+      fill(sendbuf, size, s);
+      MPI_Send(sendbuf, size, MPI_CHAR, 1, s, MPI_COMM_WORLD);
+      memset(sendbuf, 'x', size);
+    } else {
+      MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    /* The sends come first, and many of them are in flight at once */
+    if (rank == 0) {
+      for (int i = 0; i < INFLIGHT; i++) {
+        fill(sendbuf, size, s + i);
+        MPI_Send(sendbuf, size, MPI_CHAR, 1, i, MPI_COMM_WORLD);
+        memset(sendbuf, 'x', size);
+      }
+      MPI_Barrier(MPI_COMM_WORLD);
+    } else if (rank == 1) {
+      MPI_Barrier(MPI_COMM_WORLD);
+      for (int i = INFLIGHT - 1; i >= 0; i--) {
+        MPI_Recv(recvbuf[i], size, MPI_CHAR, 0, i, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        errors += check(recvbuf[i], size, s + i);
+      }
+    } else {
+      MPI_Barrier(MPI_COMM_WORLD);
+    }
+  }
+
+  if (rank == 1)
+    printf("%d errors\n", errors);
+  MPI_Finalize();
+  return 0;
+}
@@ -0,0 +1,121 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Fine-grained RMA operations (many 8-byte puts, gets and accumulates) in all the synchronization modes, on a window
+ * created with or without the "smpi_batch_rma" info key. Both windows must give the same results, while the batched
+ * one sends one message per target and synchronization. */
+
+#include <mpi.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define COUNT 64
+
+static int run(int batched)
+{
+  int rank;
+  int size;
+  int errors = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+  int next = (rank + 1) % size;
+  int prev = (rank + size - 1) % size;
+
+  MPI_Info info;
+  MPI_Info_create(&info);
+  MPI_Info_set(info, "smpi_batch_rma", batched ? "true" : "false");
+  long* base;
+  MPI_Win win;
+  MPI_Win_allocate(2 * COUNT * sizeof(long), sizeof(long), info, MPI_COMM_WORLD, &base, &win);
+  MPI_Info_free(&info);
+  for (int i = 0; i < 2 * COUNT; i++)
+    base[i] = -1;
+
+  double start = MPI_Wtime();
+
+  /* Fence: puts element by element to the next rank, reusing the origin buffer right away */
+  MPI_Win_fence(0, win);
+  long value;
+  for (int i = 0; i < COUNT; i++) {
+    value = rank * 1000 + i;
+    MPI_Put(&value, 1, MPI_LONG, next, i, 1, MPI_LONG, win);
+  }
+  MPI_Win_fence(0, win);
+  for (int i = 0; i < COUNT; i++)
+    errors += base[i] != prev * 1000 + i;
+
+  /* Fence: gets from the previous rank, and ordered accumulates on rank 0 */
+  long got[COUNT];
+  for (int i = 0; i < COUNT; i++)
+    MPI_Get(&got[i], 1, MPI_LONG, prev, i, 1, MPI_LONG, win);
+  MPI_Win_fence(0, win);
+  for (int i = 0; i < COUNT; i++)
+    errors += got[i] != ((prev + size - 1) % size) * 1000 + i;
+  if (rank == 0)
+    base[COUNT] = 0;
+  MPI_Win_fence(0, win);
+  for (int i = 0; i < COUNT; i++) {
+    value = rank + 1;
+    MPI_Accumulate(&value, 1, MPI_LONG, 0, COUNT, 1, MPI_LONG, MPI_SUM, win);
+  }
+  MPI_Win_fence(0, win);
+  if (rank == 0)
+    errors += base[COUNT] != (long)COUNT * size * (size + 1) / 2;
+
+  /* Passive target: exclusive lock on rank 0, and a fetch-and-add through a compare-and-swap loop */
+  long old;
+  long result;
+  MPI_Win_lock(MPI_LOCK_EXCLUSIVE, 0, 0, win);
+  do {
+    MPI_Get(&old, 1, MPI_LONG, 0, COUNT, 1, MPI_LONG, win);
+    MPI_Win_flush(0, win);
+    value = old + 1;
+    MPI_Compare_and_swap(&value, &old, &result, MPI_LONG, 0, COUNT, win);
+    MPI_Win_flush(0, win);
+  } while (result != old);
+  MPI_Win_unlock(0, win);
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (rank == 0)
+    errors += base[COUNT] != (long)COUNT * size * (size + 1) / 2 + size;
+
+  /* PSCW: each rank puts to the next one */
+  MPI_Group world;
+  MPI_Group group_next;
+  MPI_Group group_prev;
+  MPI_Comm_group(MPI_COMM_WORLD, &world);
+  MPI_Group_incl(world, 1, &next, &group_next);
+  MPI_Group_incl(world, 1, &prev, &group_prev);
+  MPI_Win_post(group_prev, 0, win);
+  MPI_Win_start(group_next, 0, win);
+  for (int i = COUNT + 1; i < 2 * COUNT; i++) {
+    value = -rank * 1000 - i;
+    MPI_Put(&value, 1, MPI_LONG, next, i, 1, MPI_LONG, win);
+  }
+  MPI_Win_complete(win);
+  MPI_Win_wait(win);
+  for (int i = COUNT + 1; i < 2 * COUNT; i++)
+    errors += base[i] != -prev * 1000 - i;
+  MPI_Group_free(&group_next);
+  MPI_Group_free(&group_prev);
+  MPI_Group_free(&world);
+
+  double duration = MPI_Wtime() - start;
+  MPI_Win_free(&win);
+
+  int total_errors;
+  MPI_Reduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, 0, MPI_COMM_WORLD);
+  if (rank == 0)
+    printf("%s: %d errors, %f seconds\n", batched ? "Batched" : "Not batched", total_errors, duration);
+  return total_errors;
+}
+
+int main(int argc, char** argv)
+{
+  MPI_Init(&argc, &argv);
+  run(0);
+  run(1);
+  MPI_Finalize();
+  return 0;
+}
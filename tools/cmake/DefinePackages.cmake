@@ -34,6 +34,7 @@ set(EXTRA_DIST
   src/simgrid/sg_config.hpp
   src/simgrid/math_utils.h
 
+  src/smpi/colls/coll_netzone_topo.hpp
   src/smpi/colls/coll_tuned_topo.hpp
   src/smpi/colls/colls_private.hpp
   src/smpi/colls/smpi_mvapich2_selector_stampede.hpp
@@ -101,6 +102,7 @@ set(SMPI_SRC
   src/smpi/colls/allreduce/allreduce-ompi-ring-segmented.cpp
   src/smpi/colls/allreduce/allreduce-rab-rdb.cpp
   src/smpi/colls/allreduce/allreduce-rab1.cpp
+  src/smpi/colls/allreduce/allreduce-topo.cpp
   src/smpi/colls/allreduce/allreduce-rab2.cpp
   src/smpi/colls/allreduce/allreduce-rdb.cpp
   src/smpi/colls/allreduce/allreduce-redbcast.cpp
@@ -142,6 +144,7 @@ set(SMPI_SRC
   src/smpi/colls/bcast/bcast-NTSL.cpp
   src/smpi/colls/bcast/bcast-SMP-binary.cpp
   src/smpi/colls/bcast/bcast-SMP-binomial.cpp
+  src/smpi/colls/bcast/bcast-topo.cpp
   src/smpi/colls/bcast/bcast-SMP-linear.cpp
   src/smpi/colls/bcast/bcast-arrival-pattern-aware-wait.cpp
   src/smpi/colls/bcast/bcast-arrival-pattern-aware.cpp
@@ -154,6 +157,7 @@ set(SMPI_SRC
   src/smpi/colls/bcast/bcast-ompi-split-bintree.cpp
   src/smpi/colls/bcast/bcast-scatter-LR-allgather.cpp
   src/smpi/colls/bcast/bcast-scatter-rdb-allgather.cpp
+  src/smpi/colls/coll_netzone_topo.cpp
   src/smpi/colls/coll_tuned_topo.cpp
   src/smpi/colls/colls_global.cpp
   src/smpi/colls/gather/gather-mvapich.cpp
@@ -161,6 +165,7 @@ set(SMPI_SRC
   src/smpi/colls/reduce/reduce-NTSL.cpp
   src/smpi/colls/reduce/reduce-arrival-pattern-aware.cpp
   src/smpi/colls/reduce/reduce-binomial.cpp
+  src/smpi/colls/reduce/reduce-topo.cpp
   src/smpi/colls/reduce/reduce-flat-tree.cpp
   src/smpi/colls/reduce/reduce-mvapich-knomial.cpp
   src/smpi/colls/reduce/reduce-mvapich-two-level.cpp
@@ -178,6 +183,7 @@ set(SMPI_SRC
   src/smpi/colls/smpi_mpich_selector.cpp
   src/smpi/colls/smpi_mvapich2_selector.cpp
   src/smpi/colls/smpi_nbc_impl.cpp
+  src/smpi/colls/smpi_nbc_schedule.cpp
   src/smpi/colls/smpi_openmpi_selector.cpp
   src/smpi/include/smpi_actor.hpp
   src/smpi/include/smpi_coll.hpp
@@ -192,6 +198,7 @@ set(SMPI_SRC
   src/smpi/include/smpi_host.hpp
   src/smpi/include/smpi_info.hpp
   src/smpi/include/smpi_keyvals.hpp
+  src/smpi/include/smpi_nbc_schedule.hpp
   src/smpi/include/smpi_op.hpp
   src/smpi/include/smpi_replay.hpp
   src/smpi/include/smpi_request.hpp
@@ -487,6 +494,10 @@ set(TRACING_SRC
   src/instr/instr_private.hpp
   src/instr/instr_resource_utilization.cpp
   src/instr/instr_smpi.hpp
+  src/instr/instr_binary_trace.cpp
+  src/instr/instr_binary_trace.hpp
+  src/instr/instr_trace_writer.cpp
+  src/instr/instr_trace_writer.hpp
   )
 
 set(MC_SRC_BASE
@@ -525,8 +536,14 @@ set(MC_SRC_STATELESS
   src/mc/explo/CommunicationDeterminismChecker.cpp
   src/mc/explo/ParallelizedExplorer.cpp
   src/mc/explo/ParallelizedExplorer.hpp
+  src/mc/explo/SwarmExplorer.cpp
+  src/mc/explo/SwarmExplorer.hpp
   src/mc/explo/BeFSExplorer.cpp
   src/mc/explo/BeFSExplorer.hpp
+  src/mc/explo/CheckpointPolicy.cpp
+  src/mc/explo/CheckpointPolicy.hpp
+  src/mc/explo/VisitedStates.cpp
+  src/mc/explo/VisitedStates.hpp
 
   src/mc/explo/UdporChecker.cpp
   src/mc/explo/UdporChecker.hpp
@@ -572,6 +589,8 @@ set(MC_SRC_STATELESS
   src/mc/api/states/WutState.cpp
   src/mc/api/states/WutState.hpp
   
+  src/mc/transition/DependencyOracle.cpp
+  src/mc/transition/DependencyOracle.hpp
   src/mc/transition/Transition.hpp
   src/mc/transition/TransitionActor.cpp
   src/mc/transition/TransitionActor.hpp
@@ -1067,6 +1086,8 @@ set(CMAKEFILES_TXT
   teshsuite/xbt/CMakeLists.txt
   tools/CMakeLists.txt
   tools/graphicator/CMakeLists.txt
+  tools/ti_to_binary/CMakeLists.txt
+  tools/trace_to_paje/CMakeLists.txt
   tools/tesh/CMakeLists.txt
   )
 
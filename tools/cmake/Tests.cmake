@@ -139,7 +139,9 @@ set(MC_UNIT_TESTS src/mc/explo/odpor/ClockVector_test.cpp
                   src/mc/explo/udpor/EventSet_test.cpp
                   src/mc/explo/udpor/ExtensionSet_test.cpp
                   src/mc/explo/udpor/History_test.cpp
-                  src/mc/explo/udpor/Configuration_test.cpp)
+                  src/mc/explo/udpor/Configuration_test.cpp
+
+                  src/mc/transition/DependencyOracle_test.cpp)
 if (SIMGRID_HAVE_MC)
   set(UNIT_TESTS ${UNIT_TESTS} ${MC_UNIT_TESTS})
 else()
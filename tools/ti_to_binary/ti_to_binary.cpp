@@ -0,0 +1,23 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Converts time-independent traces into their binary counterpart, which the replay engine loads much faster. */
+
+#include "xbt/asserts.h"
+#include "xbt/replay.hpp"
+
+#include <cstdio>
+
+int main(int argc, char** argv)
+{
+  xbt_assert(argc >= 3 && argc % 2 == 1, "Usage: %s <text_trace> <binary_trace> [<text_trace> <binary_trace>...]",
+             argv[0]);
+
+  for (int i = 1; i < argc; i += 2) {
+    xbt_replay_convert_to_binary(argv[i], argv[i + 1]);
+    printf("Converted %s into %s\n", argv[i], argv[i + 1]);
+  }
+  return 0;
+}
@@ -0,0 +1,20 @@
+/* Copyright (c) 2025. The SimGrid Team. All rights reserved.               */
+
+/* This program is free software; you can redistribute it and/or modify it
+ * under the terms of the license (GNU LGPL) which comes with this package. */
+
+/* Converts the traces written with --cfg=tracing/format:Binary into the Paje format, for the usual visualization tools */
+
+#include "simgrid/instr.h"
+#include "xbt/asserts.h"
+
+#include <cstdio>
+
+int main(int argc, char** argv)
+{
+  xbt_assert(argc == 3, "Usage: %s <binary_trace> <paje_trace>", argv[0]);
+
+  simgrid::instr::convert_binary_trace(argv[1], argv[2]);
+  printf("Converted %s into %s\n", argv[1], argv[2]);
+  return 0;
+}